@@ -9,6 +9,7 @@
 #include "plugin_harness.h"
 #include "wav_writer.h"
 #include "sha256.h"
+#include "perf_registry.h"
 
 #include <cmath>
 #include <cstring>
@@ -611,6 +612,29 @@ TestResult test_golden_wav_hashes() {
     TEST_PASS();
 }
 
+// =========================================================================
+// Performance baseline: the golden renders re-run and timed per WAV scenario
+// =========================================================================
+TestResult test_perf_baseline() {
+    TEST_BEGIN("Performance baseline (cycles/frame vs tests/perf_baseline.txt)");
+    const bool withinBudget = PerfRegistry::check("tests/perf_baseline.txt", {
+        test_wav_capture,
+        test_golden_default,
+        test_golden_waveforms,
+        test_golden_detune_models,
+        test_golden_morph_sweep,
+        test_golden_harmonics,
+        test_golden_pitch_range,
+        test_golden_cv_fm,
+        test_golden_cv_voct,
+        test_golden_cv_morph,
+        test_golden_cv_harmonics,
+        test_golden_cv_all_inputs,
+    });
+    ASSERT_TRUE(withinBudget, "no render scenario slower than baseline tolerance");
+    TEST_PASS();
+}
+
 // -------------------------------------------------------------------------
 // Main
 // -------------------------------------------------------------------------
@@ -641,5 +665,6 @@ int main() {
         test_golden_cv_all_inputs,
         // Golden hash verification (must run after generators)
         test_golden_wav_hashes,
+        test_perf_baseline,
     });
 }
@@ -0,0 +1,149 @@
+#pragma once
+#include <cstdint>
+
+// Block bit-crush + sample-rate decimation for one stereo band.
+//
+// Decimation is a strided hold fill: only the samples that start a new hold
+// run are quantised, the rest of each run is a plain store.  Heavier
+// decimation therefore does less work per block, not more.
+//
+// Quantisation converts to Q16 and rounds with an integer shift (a single
+// VCVT with fraction bits on Cortex-M7), so there is no float round() call.
+// Dither comes from a block of noise generated up front by the crusher's own
+// xorshift32 — one value per capture — so instances never disturb each other
+// or the shared CheapMaths PRNG.
+//
+// Dither modes:
+//   Off    — plain rounding (cheapest, correlated distortion at low bits)
+//   Rect   — rectangular ±0.5 LSB (the original Nerberus behaviour)
+//   TPDF   — triangular ±1 LSB, noise floor independent of the signal
+//   Shaped — TPDF plus first-order error feedback; pushes the requantisation
+//            noise towards the top of the band
+//
+// Typical usage:
+//   BandCrusher<64> crush;
+//   crush.reset(0x1234u);
+//   crush.setBits(8);
+//   crush.setDecimation(4);
+//   crush.setDither(BandCrusher<64>::kDitherTPDF);
+//   crush.processBlock(left, right, numFrames);   // numFrames <= 64
+
+template <int kMaxBlock>
+class BandCrusher {
+public:
+    enum { kDitherOff = 0, kDitherRect, kDitherTPDF, kDitherShaped, kNumDitherModes };
+
+    void reset(uint32_t seed) {
+        rng       = seed ? seed : 0x9E3779B9u;
+        countdown = decim;
+        holdL = holdR = 0.0f;
+        errL  = errR  = 0;
+    }
+
+    // 1..16 bits; 16 leaves the sample values untouched.
+    void setBits(int b) {
+        if (b < 1)  b = 1;
+        if (b > 16) b = 16;
+        bits  = b;
+        shift = 16 - b;
+        errL  = errR = 0;
+    }
+
+    // Hold each captured sample for `factor` samples (1 = off).
+    void setDecimation(int factor) {
+        decim = (factor < 1) ? 1 : factor;
+        if (countdown > decim) countdown = decim;
+    }
+
+    void setDither(int mode) {
+        dither = (mode < 0 || mode >= kNumDitherModes) ? kDitherRect : mode;
+        errL = errR = 0;
+    }
+
+    bool isBypassed() const { return bits >= 16 && decim <= 1; }
+
+    // In-place processing; numFrames must not exceed kMaxBlock.
+    void processBlock(float* l, float* r, int numFrames) {
+        if (isBypassed() || numFrames <= 0) return;
+
+        // Capture positions in this block: first, first + decim, ...
+        const int first    = countdown - 1;
+        const int captures = (first < numFrames) ? 1 + (numFrames - 1 - first) / decim : 0;
+
+        if (shift == 0)                  run<kPass>(l, r, numFrames, first, captures);
+        else if (dither == kDitherOff)   run<kDitherOff>(l, r, numFrames, first, captures);
+        else if (dither == kDitherRect)  run<kDitherRect>(l, r, numFrames, first, captures);
+        else if (dither == kDitherTPDF)  run<kDitherTPDF>(l, r, numFrames, first, captures);
+        else                             run<kDitherShaped>(l, r, numFrames, first, captures);
+
+        if (captures > 0) countdown = decim - (numFrames - 1 - (first + (captures - 1) * decim));
+        else              countdown -= numFrames;
+    }
+
+private:
+    enum { kPass = -1 };
+    static constexpr float kToQ16   = 65536.0f;
+    static constexpr float kFromQ16 = 1.0f / 65536.0f;
+
+    template <int kMode>
+    void run(float* l, float* r, int n, int first, int captures) {
+        // One noise word per channel per capture; the upper and lower halves
+        // give the two uniforms TPDF needs.
+        if (kMode > kDitherOff) {
+            for (int c = 0; c < 2 * captures; ++c) {
+                rng ^= rng << 13;
+                rng ^= rng >> 17;
+                rng ^= rng << 5;
+                noise[c] = rng;
+            }
+        }
+
+        int i = 0;
+        const float hL = holdL, hR = holdR;
+        for (; i < first && i < n; ++i) { l[i] = hL; r[i] = hR; }
+
+        for (int c = 0; c < captures; ++c) {
+            const uint32_t nL = (kMode > kDitherOff) ? noise[2 * c]     : 0u;
+            const uint32_t nR = (kMode > kDitherOff) ? noise[2 * c + 1] : 0u;
+            const float qL = quantise<kMode>(l[i], nL, errL);
+            const float qR = quantise<kMode>(r[i], nR, errR);
+            const int end = (i + decim < n) ? i + decim : n;
+            for (; i < end; ++i) { l[i] = qL; r[i] = qR; }
+            holdL = qL;
+            holdR = qR;
+        }
+    }
+
+    template <int kMode>
+    inline float quantise(float x, uint32_t rnd, int32_t& err) const {
+        if (kMode == kPass) return x;
+
+        const int32_t lsb  = 1 << shift;
+        const int32_t mask = lsb - 1;
+        const int32_t half = lsb >> 1;
+        int32_t v = (int32_t)(x * kToQ16);
+
+        int32_t d = 0;
+        if (kMode == kDitherRect) d = (int32_t)(rnd & (uint32_t)mask) - half;
+        if (kMode >= kDitherTPDF) d = (int32_t)(rnd & (uint32_t)mask)
+                                    + (int32_t)((rnd >> 16) & (uint32_t)mask) - mask;
+        if (kMode == kDitherShaped) v -= err;
+
+        const int32_t y = (v + d + half) & ~mask;   // floor to the LSB grid
+        if (kMode == kDitherShaped) err = y - v;
+        return (float)y * kFromQ16;
+    }
+
+    uint32_t rng       = 0x9E3779B9u;
+    int      bits      = 16;
+    int      shift     = 0;
+    int      decim     = 1;
+    int      countdown = 1;   // samples until the next capture (1 = next sample)
+    int      dither    = kDitherRect;
+    float    holdL     = 0.0f, holdR = 0.0f;
+    int32_t  errL      = 0,    errR  = 0;
+
+    // Dither words for one block.  A member rather than a local so it stays
+    // off the audio thread's limited stack.
+    uint32_t noise[2 * kMaxBlock];
+};
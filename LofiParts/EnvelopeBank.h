@@ -0,0 +1,65 @@
+#pragma once
+#include <cmath>
+
+// Bank of one-pole peak followers updated together, one sample at a time.
+//
+// Each lane is the same filter as PeakFollower:
+//   level = alpha * level + (1 - alpha) * mag,  alpha = attack or release
+// but levels and coefficients are stored as lane arrays, so process() is a
+// single branch-free loop over kLanes that the compiler unrolls (and
+// vectorises where the target has float SIMD).  Use it when several
+// envelopes must be tracked at sample rate — e.g. fast and slow followers
+// for every band of a multiband processor — instead of running separate
+// objects or stepping envelopes once per block.
+//
+// Typical usage:
+//   EnvelopeBank<4> bank;
+//   bank.init(48000.f);
+//   bank.setTimes(0, 0.0001f, 0.005f);   // lane 0: fast
+//   bank.setTimes(1, 0.005f,  0.080f);   // lane 1: slow
+//   for each sample:
+//     const float mags[4] = { m, m, 0.f, 0.f };
+//     bank.process(mags);
+//   float fast = bank.getLevel(0);
+
+template <int kLanes>
+class EnvelopeBank {
+public:
+    void init(float sampleRate) {
+        fs = sampleRate;
+        for (int k = 0; k < kLanes; ++k) {
+            level[k] = 0.0f;
+            att[k]   = 0.0f;
+            rel[k]   = 0.0f;
+        }
+    }
+
+    // attackSecs / releaseSecs: time to reach 63% of a step change (tau).
+    // Pass 0 for instant.
+    void setTimes(int lane, float attackSecs, float releaseSecs) {
+        att[lane] = (attackSecs  < 2e-5f) ? 0.0f : expf(-1.0f / (attackSecs  * fs));
+        rel[lane] = (releaseSecs < 2e-5f) ? 0.0f : expf(-1.0f / (releaseSecs * fs));
+    }
+
+    // Advance every lane by one sample.  mags[k] >= 0 is lane k's input.
+    inline void process(const float* mags) {
+        for (int k = 0; k < kLanes; ++k) {
+            const float alpha = (mags[k] > level[k]) ? att[k] : rel[k];
+            float l = alpha * level[k] + (1.0f - alpha) * mags[k];
+            // Flush subnormals: prevents ARM Cortex-M7 FPU performance stalls
+            level[k] = (l < 1e-25f) ? 0.0f : l;
+        }
+    }
+
+    float getLevel(int lane) const { return level[lane]; }
+
+    void reset() {
+        for (int k = 0; k < kLanes; ++k) level[k] = 0.0f;
+    }
+
+private:
+    float fs = 48000.0f;
+    float level[kLanes];
+    float att[kLanes];
+    float rel[kLanes];
+};
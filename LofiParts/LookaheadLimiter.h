@@ -0,0 +1,153 @@
+#pragma once
+#include <cmath>
+#include <cstdint>
+
+// Stereo-linked lookahead brickwall limiter.
+//
+// The audio is delayed by `lookahead` samples while the gain computer sees the
+// undelayed signal.  Per sample:
+//   1. A monotonic-deque sliding maximum tracks the peak over the last
+//      lookahead+1 samples — amortised O(1) regardless of the window length.
+//   2. The required gain (ceiling / windowPeak) releases upward through a
+//      one-pole, but always drops instantly.
+//   3. A box filter of the same length smooths the attack, so the gain ramps
+//      down across the lookahead instead of stepping when a peak arrives.
+// Every value in the box window already covers the sample leaving the delay
+// line, so the smoothed gain never exceeds what that sample needs: the output
+// never exceeds the ceiling.
+//
+// The box filter runs on a Q16 integer running sum, so it cannot drift.
+// All state lives inside the object (kSize must be a power of two; the maximum
+// lookahead is kSize - 1).  Place the object in DTC so the whole window stays
+// in tightly coupled memory.
+//
+// Typical usage:
+//   LookaheadLimiter<256> lim;
+//   lim.init(48000.f);
+//   lim.setCeiling(0.966f);        // -0.3 dBFS
+//   lim.setLookahead(72);          // samples — also the latency
+//   lim.setRelease(0.050f);
+//   lim.processBlock(left, right, numFrames);
+
+template <int kSize>
+class LookaheadLimiter {
+    static_assert(kSize >= 2 && (kSize & (kSize - 1)) == 0, "kSize must be a power of two");
+    static constexpr uint32_t kMask = (uint32_t)kSize - 1u;
+    static constexpr float kGainOne = 65536.0f;   // Q16 unity
+
+public:
+    static constexpr int kMaxLookahead = kSize - 1;
+
+    void init(float sampleRate) {
+        fs = sampleRate;
+        setRelease(releaseSecs);
+        reset();
+    }
+
+    // Clear the delay line and gain history.  Called on init and whenever the
+    // lookahead changes, since the window contents no longer line up.
+    void reset() {
+        for (int i = 0; i < kSize; ++i) {
+            delayL[i] = 0.0f;
+            delayR[i] = 0.0f;
+            boxBuf[i] = (uint32_t)kGainOne;
+        }
+        dqHead  = 0;
+        dqTail  = 0;
+        pos     = 0;
+        relGain = 1.0f;
+        boxSum  = (uint32_t)kGainOne * (uint32_t)(lookahead + 1);
+    }
+
+    // Lookahead in samples, clamped to 0..kMaxLookahead.  Equals the latency.
+    void setLookahead(int samples) {
+        if (samples < 0) samples = 0;
+        if (samples > kMaxLookahead) samples = kMaxLookahead;
+        if (samples == lookahead) return;
+        lookahead = samples;
+        boxScale  = 1.0f / (kGainOne * (float)(lookahead + 1));
+        reset();
+    }
+
+    // Linear peak ceiling (> 0).
+    void setCeiling(float linear) {
+        ceiling = (linear > 1e-6f) ? linear : 1e-6f;
+    }
+
+    // Time constant for the gain to recover after a peak.
+    void setRelease(float secs) {
+        releaseSecs  = secs;
+        releaseCoeff = (secs < 2e-5f) ? 0.0f : expf(-1.0f / (secs * fs));
+    }
+
+    int   getLatency() const { return lookahead; }
+    float getGain()    const { return lastGain; }
+
+    // In-place processing of one stereo block.
+    void processBlock(float* l, float* r, int numFrames) {
+        for (int i = 0; i < numFrames; ++i) {
+            const float inL = l[i];
+            const float inR = r[i];
+            const float peak = std::fmax(std::fabs(inL), std::fabs(inR));
+
+            // Sliding window maximum: expire the front once it falls out of the
+            // window, then drop queued peaks the new one dominates.  Expiring
+            // first keeps at most lookahead+1 <= kSize entries live, so the
+            // push never lands on the front's slot.
+            while (dqTail != dqHead && pos - dqPos[dqHead & kMask] > (uint32_t)lookahead) ++dqHead;
+            while (dqTail != dqHead && dqVal[(dqTail - 1u) & kMask] <= peak) --dqTail;
+            dqVal[dqTail & kMask] = peak;
+            dqPos[dqTail & kMask] = pos;
+            ++dqTail;
+            const float windowPeak = dqVal[dqHead & kMask];
+
+            // Required gain: instant attack, one-pole release (stays <= target).
+            const float target = (windowPeak > ceiling) ? ceiling / windowPeak : 1.0f;
+            relGain = (target < relGain) ? target : target + releaseCoeff * (relGain - target);
+
+            // Box smoothing over lookahead+1 samples.  Truncating to Q16 rounds
+            // the gain down, which keeps the ceiling guarantee.
+            const uint32_t q = (uint32_t)(relGain * kGainOne);
+            boxSum += q - boxBuf[(pos - (uint32_t)lookahead - 1u) & kMask];
+            boxBuf[pos & kMask] = q;
+            const float gain = (float)boxSum * boxScale;
+
+            // Delay line: write the new sample, read the one lookahead behind.
+            delayL[pos & kMask] = inL;
+            delayR[pos & kMask] = inR;
+            const uint32_t rd = (pos - (uint32_t)lookahead) & kMask;
+            float outL = delayL[rd] * gain;
+            float outR = delayR[rd] * gain;
+
+            // Guard against float rounding in the gain product.
+            if (outL >  ceiling) outL =  ceiling;
+            if (outL < -ceiling) outL = -ceiling;
+            if (outR >  ceiling) outR =  ceiling;
+            if (outR < -ceiling) outR = -ceiling;
+            l[i] = outL;
+            r[i] = outR;
+            lastGain = gain;
+            ++pos;
+        }
+    }
+
+private:
+    float    delayL[kSize];
+    float    delayR[kSize];
+    float    dqVal[kSize];
+    uint32_t dqPos[kSize];
+    uint32_t boxBuf[kSize];
+
+    uint32_t dqHead = 0, dqTail = 0;
+    uint32_t pos    = 0;
+    uint32_t boxSum = (uint32_t)kGainOne;
+
+    float fs           = 48000.0f;
+    float ceiling      = 1.0f;
+    float releaseSecs  = 0.050f;
+    float releaseCoeff = 0.0f;
+    float relGain      = 1.0f;
+    float lastGain     = 1.0f;
+    float boxScale     = 1.0f / kGainOne;
+    int   lookahead    = 0;
+};
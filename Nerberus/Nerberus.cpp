@@ -2,12 +2,13 @@
 #include <new>
 #include <distingnt/api.h>
 
+#include "BandCrusher.h"
 #include "CheapMaths.h"
 #include "CompressedGritEngine.h"
+#include "EnvelopeBank.h"
 #include "LFO.h"
-#include "PeakFollower.h"
+#include "LookaheadLimiter.h"
 #include "Polyphase.h"
-#include "ShapedADSR.h"
 #include "ZDFFilter.h"
 
 #ifndef ARRAY_SIZE
@@ -15,7 +16,29 @@
 #endif
 
 static constexpr int kNumBuses = 28;
-static constexpr int kBlockChunk = 64;
+
+// Frames per analysis chunk.  Envelope, CV and transient analysis run once per
+// chunk, and the six per-chunk band buffers live on the audio thread's stack,
+// so this trades control granularity against stack and cache/TCM footprint.
+// Override at build time, e.g. `make NERBERUS_BLOCK_CHUNK=32`.
+#ifndef NERBERUS_BLOCK_CHUNK
+#define NERBERUS_BLOCK_CHUNK 64
+#endif
+static constexpr int kBlockChunk = NERBERUS_BLOCK_CHUNK;
+static_assert(kBlockChunk >= 4 && (kBlockChunk % 4) == 0,
+              "NERBERUS_BLOCK_CHUNK must be a positive multiple of 4");
+
+// Lookahead limiter window (power of two).  255 samples max lookahead covers
+// the 2.5 ms parameter range up to 96 kHz.
+static constexpr int kLimiterSize = 256;
+
+// Envelope bank lanes: global level, fast and slow per band (lane 7 is padding).
+enum {
+    kEnvGlobal = 0,
+    kEnvFastLo, kEnvFastMid, kEnvFastHi,
+    kEnvSlowLo, kEnvSlowMid, kEnvSlowHi,
+    kEnvLanes = 8
+};
 
 // --- LR4 3-band crossover ---
 struct BiquadCoeffs {
@@ -107,13 +130,10 @@ struct _NerberusAlgorithm_DTC {
     LFO ringCarrier;
     BandSplitter splitter;
 
-    // Envelope follower for overall drive / filter / bias modulation
-    PeakFollower envFollower;    // per-sample one-pole peak tracker
-
-    // Per-band transient envelope followers (ShapedADSR — gate-driven, kept for transient shaper)
-    ShapedADSR envFastLo,  envSlowLo;
-    ShapedADSR envFastMid, envSlowMid;
-    ShapedADSR envFastHi,  envSlowHi;
+    // Envelope followers, all updated per sample in one pass:
+    //   lane 0 — overall drive / filter / bias modulation (Env Flwr page)
+    //   lanes 1..3 — fast Lo/Mid/Hi, lanes 4..6 — slow Lo/Mid/Hi (transient shaper)
+    EnvelopeBank<kEnvLanes> envBank;
 
     float sampleRate = 48000.f;
 
@@ -144,13 +164,8 @@ struct _NerberusAlgorithm_DTC {
     float cvFilterFreqDepth = 1.0f;      // oct/V for filter freq CV
     float cvRingFreqDepth   = 1.0f;      // oct/V for ring freq CV
 
-    // Per-band crush + decimation state
-    int bitDepthLo = 16,   bitDepthMid = 16,   bitDepthHi = 16;
-    int decimLo = 1,       decimMid = 1,        decimHi = 1;
-    int decimPhaseLo = 0,  decimPhaseMid = 0,   decimPhaseHi = 0;
-    float decimHoldLoL = 0.f,  decimHoldLoR = 0.f;
-    float decimHoldMidL = 0.f, decimHoldMidR = 0.f;
-    float decimHoldHiL = 0.f,  decimHoldHiR = 0.f;
+    // Per-band crush + decimation (block kernels, private dither PRNG each)
+    BandCrusher<kBlockChunk> crushLo, crushMid, crushHi;
 
     // Per-band noise
     float noiseLevelLo = 0.f, noiseLevelMid = 0.f, noiseLevelHi = 0.f;
@@ -195,15 +210,26 @@ struct _NerberusAlgorithm_DTC {
     // Lo-band saturation mode: 0=symmetric (default), 1=asymmetric (even-order)
     int   loSatMode     = 0;
 
+    // Lookahead brickwall limiter: optional final stage after the mix.
+    // Delays the whole output by its lookahead; the window stays in DTC.
+    LookaheadLimiter<kLimiterSize> limiter;
+    bool  limiterOn       = false;
+    int   limiterLookTenthsMs = 15;  // 0.1 ms units
+
     // Temp buffers for block-level filter oversampling.
     // Kept in DTC rather than on the stack to avoid overflowing the audio thread's
-    // limited stack budget (step() already uses ~2.5 KB of stack buffers).
+    // limited stack budget (step() already uses 6 * kBlockChunk floats of stack).
     // Sized for 4x OS at max block size; 2x uses only the first n*2 elements.
     float filterOsBufL[kBlockChunk * 4];
     float filterOsBufR[kBlockChunk * 4];
 
     // Pre-computed ring carrier buffer — one LFO call per block instead of per-sample.
     float ringCarrierBuf[kBlockChunk];
+
+    // Per-sample transient amount per band (-1..+1), filled by the envelope pass.
+    float transientLo[kBlockChunk];
+    float transientMid[kBlockChunk];
+    float transientHi[kBlockChunk];
 };
 
 struct _NerberusAlgorithm : public _NT_algorithm {
@@ -263,6 +289,15 @@ enum {
     kParamOutLimiter,
     kParamLoSatMode,
 
+    // Lookahead brickwall limiter
+    kParamLimiter,
+    kParamLimCeiling,
+    kParamLimLookahead,
+    kParamLimRelease,
+
+    // Crush dither modes
+    kParamDitherLo, kParamDitherMid, kParamDitherHi,
+
     kNumParams
 };
 
@@ -282,6 +317,14 @@ static char const * const enumStringsNoiseColor[] = {
     "White", "Pink", "Lo-Fi"
 };
 
+static char const * const enumStringsDither[] = {
+    "Off", "Rect", "TPDF", "Shaped"
+};
+
+static char const * const enumStringsOffOn[] = {
+    "Off", "On"
+};
+
 static const _NT_parameter parameters[] = {
     NT_PARAMETER_AUDIO_INPUT("In L", 1, 1)
     NT_PARAMETER_AUDIO_INPUT("In R", 1, 2)
@@ -362,6 +405,17 @@ static const _NT_parameter parameters[] = {
     { "Out LP",    2000, 20000, 20000, kNT_unitHz,      0,               nullptr },
     { "Out Limit",    0,  1000,     0, kNT_unitPercent, kNT_scaling1000, nullptr },
     { "Lo Asym",      0,     1,     0, kNT_unitNone,    0,               nullptr },
+
+    // Lookahead limiter
+    { "Limiter",      0,     1,     0, kNT_unitEnum,       0,             enumStringsOffOn },
+    { "Lim Ceiling", -240,   0,    -3, kNT_unitDb,         kNT_scaling10, nullptr },
+    { "Lim Look",     0,    25,    15, kNT_unitHasStrings, 0,             nullptr },
+    { "Lim Release",  1,  1000,    50, kNT_unitMs,         0,             nullptr },
+
+    // Crush dither modes
+    { "Dither Lo",  0, 3, 1, kNT_unitEnum, 0, enumStringsDither },
+    { "Dither Mid", 0, 3, 1, kNT_unitEnum, 0, enumStringsDither },
+    { "Dither Hi",  0, 3, 1, kNT_unitEnum, 0, enumStringsDither },
 };
 
 static const uint8_t pageRouting[] = {
@@ -396,6 +450,7 @@ static const uint8_t pageEnvFollower[] = {
 static const uint8_t pageCrush[] = {
     kParamBitDepthLo, kParamBitDepthMid, kParamBitDepthHi,
     kParamDecimationLo, kParamDecimationMid, kParamDecimationHi,
+    kParamDitherLo, kParamDitherMid, kParamDitherHi,
     kParamNoiseLevelLo, kParamNoiseLevelMid, kParamNoiseLevelHi,
     kParamNoiseColor
 };
@@ -411,6 +466,10 @@ static const uint8_t pageTransient[] = {
     kParamTransientSustainLo, kParamTransientSustainMid, kParamTransientSustainHi
 };
 
+static const uint8_t pageLimiter[] = {
+    kParamLimiter, kParamLimCeiling, kParamLimLookahead, kParamLimRelease
+};
+
 static const _NT_parameterPage pages[] = {
     { "Drive",      ARRAY_SIZE(pageEngine),      0, {0, 0}, pageEngine      },
     { "Filter",     ARRAY_SIZE(pageFilter),      0, {0, 0}, pageFilter      },
@@ -418,6 +477,7 @@ static const _NT_parameterPage pages[] = {
     { "Crush",      ARRAY_SIZE(pageCrush),       0, {0, 0}, pageCrush       },
     { "Ring/Width", ARRAY_SIZE(pageRingWidth),   0, {0, 0}, pageRingWidth   },
     { "Transient",  ARRAY_SIZE(pageTransient),   0, {0, 0}, pageTransient   },
+    { "Limiter",    ARRAY_SIZE(pageLimiter),     0, {0, 0}, pageLimiter     },
     { "Routing",    ARRAY_SIZE(pageRouting),     0, {0, 0}, pageRouting     },
 };
 
@@ -436,6 +496,14 @@ static inline const float* busPtr(const float* busFrames, int numFrames, int16_t
     return busFrames + ((route1Based - 1) * numFrames);
 }
 
+// Lookahead parameter (0.1 ms units) to samples; this is also the latency the
+// limiter adds to the output.
+static inline int limiterLookaheadSamples(int tenthsMs, float sampleRate) {
+    const int samples = (int)(tenthsMs * 0.0001f * sampleRate + 0.5f);
+    return (samples > LookaheadLimiter<kLimiterSize>::kMaxLookahead)
+        ? LookaheadLimiter<kLimiterSize>::kMaxLookahead : samples;
+}
+
 static void calculateRequirements(_NT_algorithmRequirements& req, const int32_t*) {
     req.numParameters = kNumParams;
     req.sram = sizeof(_NerberusAlgorithm);
@@ -466,51 +534,43 @@ static _NT_algorithm* construct(const _NT_algorithmMemoryPtrs& ptrs, const _NT_a
 
     dtc->splitter.updateCoeffs(dtc->crossFreqLo, dtc->crossFreqHi, fs);
 
-    dtc->envFollower.init(fs);
-    dtc->envFollower.setTimes(dtc->envAttackMs * 0.001f, dtc->envReleaseMs * 0.001f);
-
-    // Per-band transient followers – Lo
-    dtc->envFastLo.setSampleRate(fs);
-    dtc->envFastLo.setParameters(0.0001f, 0.005f, 1.0f, 0.005f);
-    dtc->envFastLo.setShape(-0.4f);
-    dtc->envSlowLo.setSampleRate(fs);
-    dtc->envSlowLo.setParameters(0.005f, 0.08f, 1.0f, 0.08f);
-    dtc->envSlowLo.setShape(0.2f);
-
-    // Per-band transient followers – Mid
-    dtc->envFastMid.setSampleRate(fs);
-    dtc->envFastMid.setParameters(0.0001f, 0.005f, 1.0f, 0.005f);
-    dtc->envFastMid.setShape(-0.4f);
-    dtc->envSlowMid.setSampleRate(fs);
-    dtc->envSlowMid.setParameters(0.005f, 0.08f, 1.0f, 0.08f);
-    dtc->envSlowMid.setShape(0.2f);
-
-    // Per-band transient followers – Hi (faster ballistics)
-    dtc->envFastHi.setSampleRate(fs);
-    dtc->envFastHi.setParameters(0.00005f, 0.003f, 1.0f, 0.003f);
-    dtc->envFastHi.setShape(-0.4f);
-    dtc->envSlowHi.setSampleRate(fs);
-    dtc->envSlowHi.setParameters(0.003f, 0.05f, 1.0f, 0.05f);
-    dtc->envSlowHi.setShape(0.2f);
+    dtc->envBank.init(fs);
+    dtc->envBank.setTimes(kEnvGlobal, dtc->envAttackMs * 0.001f, dtc->envReleaseMs * 0.001f);
+
+    // Per-band transient followers: fast tracks the attack front, slow the body
+    dtc->envBank.setTimes(kEnvFastLo,  0.0001f,  0.005f);
+    dtc->envBank.setTimes(kEnvSlowLo,  0.005f,   0.08f);
+    dtc->envBank.setTimes(kEnvFastMid, 0.0001f,  0.005f);
+    dtc->envBank.setTimes(kEnvSlowMid, 0.005f,   0.08f);
+    dtc->envBank.setTimes(kEnvFastHi,  0.00005f, 0.003f);   // faster ballistics for highs
+    dtc->envBank.setTimes(kEnvSlowHi,  0.003f,   0.05f);
 
     seed_xorshift(1337);
+    dtc->crushLo.reset(0x6C6F0001u);
+    dtc->crushMid.reset(0x6D690002u);
+    dtc->crushHi.reset(0x68690003u);
 
     // Input HP: coefficient for one-pole LP used to derive high-pass
     dtc->inputHPCoeff = expf(-2.0f * 3.14159265f * dtc->inputHPFreq / fs);
     // Output LP: coefficient pre-computed; step() skips when freq == 20000 Hz
     dtc->outputLPCoeff = expf(-2.0f * 3.14159265f * dtc->outputLPFreq / fs);
 
+    dtc->limiter.init(fs);
+    dtc->limiter.setLookahead(limiterLookaheadSamples(dtc->limiterLookTenthsMs, fs));
+
     alg->parameters = parameters;
     alg->parameterPages = &parameterPages;
     return alg;
 }
 
-static inline float bitCrushWithDither(float x, int bits) {
-    if (bits >= 16) return x;
-    if (bits < 1) bits = 1;
-    const float levels = (float)(1 << bits);
-    const float dither = (((float)xorshift16() / 65535.0f) - 0.5f) / levels;
-    return std::round((x + dither) * levels) / levels;
+// Normalised transient from a fast/slow follower pair: positive on the attack
+// front, negative in the decaying body, independent of signal level.  Levels
+// below the floor fade the result to zero instead of amplifying noise.
+static inline float transientAmount(const EnvelopeBank<kEnvLanes>& bank, int fastLane, int slowLane) {
+    const float fast = bank.getLevel(fastLane);
+    const float slow = bank.getLevel(slowLane);
+    const float norm = std::fmax(std::fmax(fast, slow), 0.01f);
+    return (fast - slow) / norm;
 }
 
 static inline float shapedTransientGain(float transient, float attack, float sustain) {
@@ -561,12 +621,15 @@ static void parameterChanged(_NT_algorithm* self, int p) {
         case kParamFilterDriveEnv:  dtc->filterDriveEnv  = a->v[p] * 0.001f; break;
         case kParamFilterResEnv:    dtc->filterResEnv    = a->v[p] * 0.001f; break;
         case kParamFilterOversample: dtc->filterOversample = a->v[p]; break;
-        case kParamBitDepthLo:    dtc->bitDepthLo  = a->v[p]; break;
-        case kParamBitDepthMid:   dtc->bitDepthMid = a->v[p]; break;
-        case kParamBitDepthHi:    dtc->bitDepthHi  = a->v[p]; break;
-        case kParamDecimationLo:  dtc->decimLo  = (a->v[p] < 1) ? 1 : a->v[p]; break;
-        case kParamDecimationMid: dtc->decimMid = (a->v[p] < 1) ? 1 : a->v[p]; break;
-        case kParamDecimationHi:  dtc->decimHi  = (a->v[p] < 1) ? 1 : a->v[p]; break;
+        case kParamBitDepthLo:    dtc->crushLo.setBits(a->v[p]);  break;
+        case kParamBitDepthMid:   dtc->crushMid.setBits(a->v[p]); break;
+        case kParamBitDepthHi:    dtc->crushHi.setBits(a->v[p]);  break;
+        case kParamDecimationLo:  dtc->crushLo.setDecimation(a->v[p]);  break;
+        case kParamDecimationMid: dtc->crushMid.setDecimation(a->v[p]); break;
+        case kParamDecimationHi:  dtc->crushHi.setDecimation(a->v[p]);  break;
+        case kParamDitherLo:      dtc->crushLo.setDither(a->v[p]);  break;
+        case kParamDitherMid:     dtc->crushMid.setDither(a->v[p]); break;
+        case kParamDitherHi:      dtc->crushHi.setDither(a->v[p]);  break;
         case kParamNoiseLevelLo:  dtc->noiseLevelLo  = a->v[p] * 0.001f; break;
         case kParamNoiseLevelMid: dtc->noiseLevelMid = a->v[p] * 0.001f; break;
         case kParamNoiseLevelHi:  dtc->noiseLevelHi  = a->v[p] * 0.001f; break;
@@ -592,12 +655,12 @@ static void parameterChanged(_NT_algorithm* self, int p) {
         case kParamEnvSensitivity: dtc->envSensitivity = a->v[p] * 0.001f; break;
         case kParamEnvAttack: {
             dtc->envAttackMs = (float)a->v[p];
-            dtc->envFollower.setTimes(dtc->envAttackMs * 0.001f, dtc->envReleaseMs * 0.001f);
+            dtc->envBank.setTimes(kEnvGlobal, dtc->envAttackMs * 0.001f, dtc->envReleaseMs * 0.001f);
             break;
         }
         case kParamEnvRelease: {
             dtc->envReleaseMs = (float)a->v[p];
-            dtc->envFollower.setTimes(dtc->envAttackMs * 0.001f, dtc->envReleaseMs * 0.001f);
+            dtc->envBank.setTimes(kEnvGlobal, dtc->envAttackMs * 0.001f, dtc->envReleaseMs * 0.001f);
             break;
         }
         case kParamEnvShape: {
@@ -617,15 +680,40 @@ static void parameterChanged(_NT_algorithm* self, int p) {
         }
         case kParamOutLimiter: dtc->outLimiter = a->v[p] * 0.001f; break;
         case kParamLoSatMode:  dtc->loSatMode  = a->v[p]; break;
+        case kParamLimiter: {
+            const bool on = a->v[p] != 0;
+            if (on && !dtc->limiterOn) dtc->limiter.reset();  // start from a clean window
+            dtc->limiterOn = on;
+            break;
+        }
+        case kParamLimCeiling:
+            dtc->limiter.setCeiling(powf(10.0f, a->v[p] * 0.005f));  // 0.1 dB units
+            break;
+        case kParamLimLookahead:
+            dtc->limiterLookTenthsMs = a->v[p];
+            dtc->limiter.setLookahead(limiterLookaheadSamples(a->v[p], dtc->sampleRate));
+            break;
+        case kParamLimRelease: dtc->limiter.setRelease(a->v[p] * 0.001f); break;
         default: break;
     }
 }
 
-static void step(_NT_algorithm* self, float* busFrames, int numFramesBy4) {
-    auto* a = static_cast<_NerberusAlgorithm*>(self);
-    auto* dtc = a->dtc;
+// Write one processed chunk to an output bus.  The Add/Replace decision is
+// taken once per chunk so the copy loops stay branch-free.
+static inline void writeOutputChunk(float* dst, const float* src, int n, bool add) {
+    if (add) {
+        for (int i = 0; i < n; ++i) dst[i] += src[i];
+    } else {
+        for (int i = 0; i < n; ++i) dst[i] = src[i];
+    }
+}
 
-    const int numFrames = numFramesBy4 * 4;
+// Chunked processing body.  kChunk is the analysis chunk size; it must not
+// exceed kBlockChunk, which sizes the DTC scratch buffers.
+template <int kChunk>
+static void processChunks(_NerberusAlgorithm* a, float* busFrames, int numFrames) {
+    static_assert(kChunk >= 4 && kChunk <= kBlockChunk, "chunk exceeds DTC scratch buffers");
+    auto* dtc = a->dtc;
 
     const float* inL = busPtr(busFrames, numFrames, a->v[kParamInL]);
     const float* inR = busPtr(busFrames, numFrames, a->v[kParamInR]);
@@ -637,17 +725,17 @@ static void step(_NT_algorithm* self, float* busFrames, int numFramesBy4) {
     const float* cvFiltBus = busPtr(busFrames, numFrames, a->v[kParamCVFilterFreqIn]);
     const float* cvRingBus = busPtr(busFrames, numFrames, a->v[kParamCVRingFreqIn]);
 
-    float dryBufL[kBlockChunk], dryBufR[kBlockChunk];
-    float loL[kBlockChunk],     loR[kBlockChunk];
-    float midL[kBlockChunk],    midR[kBlockChunk];
-    float hiL[kBlockChunk],     hiR[kBlockChunk];
-    float wetBufL[kBlockChunk], wetBufR[kBlockChunk];
+    // No dry copy: the dry path is read back from the input buses at the mix
+    // stage, and the recombined wet signal is summed into the low-band buffers.
+    float loL[kChunk],  loR[kChunk];
+    float midL[kChunk], midR[kChunk];
+    float hiL[kChunk],  hiR[kChunk];
+    float* const wetBufL = loL;
+    float* const wetBufR = loR;
 
     int offset = 0;
     while (offset < numFrames) {
-        const int n = (numFrames - offset > kBlockChunk) ? kBlockChunk : (numFrames - offset);
-
-        float blockPeakLo  = 0.f, blockPeakMid = 0.f, blockPeakHi = 0.f;
+        const int n = (numFrames - offset > kChunk) ? kChunk : (numFrames - offset);
 
         // Block-average CV inputs
         float cvFilt = 0.f;
@@ -666,12 +754,6 @@ static void step(_NT_algorithm* self, float* busFrames, int numFramesBy4) {
             const float sL = inL ? inL[offset + i] : 0.f;
             const float sR = inR ? inR[offset + i] : 0.f;
 
-            dryBufL[i] = sL;  // dry path always uses raw input
-            dryBufR[i] = sR;
-
-            const float mag = std::fmax(std::fabs(sL), std::fabs(sR));
-            dtc->envFollower.process(mag);  // per-sample: exact timing regardless of block size
-
             // Input high-pass conditioning: one-pole LP used to derive HP
             // inputHPCoeff ≈ 0.9974 at default 20 Hz → transparent
             // inputHPCoeff ≈ 0.9741 at 200 Hz → removes guitar low-end mud before saturation
@@ -683,45 +765,40 @@ static void step(_NT_algorithm* self, float* busFrames, int numFramesBy4) {
             dtc->splitter.split(hpL, hpR,
                                 loL[i], midL[i], hiL[i],
                                 loR[i], midR[i], hiR[i]);
+        }
 
-            // Low band crush
-            if (++dtc->decimPhaseLo >= dtc->decimLo) {
-                dtc->decimPhaseLo  = 0;
-                dtc->decimHoldLoL  = bitCrushWithDither(loL[i],  dtc->bitDepthLo);
-                dtc->decimHoldLoR  = bitCrushWithDither(loR[i],  dtc->bitDepthLo);
-            }
-            loL[i] = dtc->decimHoldLoL;
-            loR[i] = dtc->decimHoldLoR;
-
-            // Mid band crush
-            if (++dtc->decimPhaseMid >= dtc->decimMid) {
-                dtc->decimPhaseMid = 0;
-                dtc->decimHoldMidL = bitCrushWithDither(midL[i], dtc->bitDepthMid);
-                dtc->decimHoldMidR = bitCrushWithDither(midR[i], dtc->bitDepthMid);
-            }
-            midL[i] = dtc->decimHoldMidL;
-            midR[i] = dtc->decimHoldMidR;
-
-            // Hi band crush
-            if (++dtc->decimPhaseHi >= dtc->decimHi) {
-                dtc->decimPhaseHi  = 0;
-                dtc->decimHoldHiL  = bitCrushWithDither(hiL[i],  dtc->bitDepthHi);
-                dtc->decimHoldHiR  = bitCrushWithDither(hiR[i],  dtc->bitDepthHi);
-            }
-            hiL[i] = dtc->decimHoldHiL;
-            hiR[i] = dtc->decimHoldHiR;
-
+        // Per-band crush: block kernels, bypassed bands cost nothing
+        dtc->crushLo.processBlock(loL, loR, n);
+        dtc->crushMid.processBlock(midL, midR, n);
+        dtc->crushHi.processBlock(hiL, hiR, n);
+
+        // All envelope followers in one per-sample pass: input level for the
+        // drive/filter envelope, crushed band levels for the transient shaper.
+        // Transient = (fast - slow) / max(fast, slow), so -1..+1 at any level.
+        const bool hasTrsLo  = dtc->transientAttackLo  != 0.f || dtc->transientSustainLo  != 0.f;
+        const bool hasTrsMid = dtc->transientAttackMid != 0.f || dtc->transientSustainMid != 0.f;
+        const bool hasTrsHi  = dtc->transientAttackHi  != 0.f || dtc->transientSustainHi  != 0.f;
+        for (int i = 0; i < n; ++i) {
+            const float sL = inL ? inL[offset + i] : 0.f;
+            const float sR = inR ? inR[offset + i] : 0.f;
             const float mLo  = std::fmax(std::fabs(loL[i]),  std::fabs(loR[i]));
             const float mMid = std::fmax(std::fabs(midL[i]), std::fabs(midR[i]));
             const float mHi  = std::fmax(std::fabs(hiL[i]),  std::fabs(hiR[i]));
-            if (mLo  > blockPeakLo)  blockPeakLo  = mLo;
-            if (mMid > blockPeakMid) blockPeakMid = mMid;
-            if (mHi  > blockPeakHi)  blockPeakHi  = mHi;
+            const float mags[kEnvLanes] = {
+                std::fmax(std::fabs(sL), std::fabs(sR)),
+                mLo, mMid, mHi,
+                mLo, mMid, mHi,
+                0.f
+            };
+            dtc->envBank.process(mags);
+            dtc->transientLo[i]  = hasTrsLo  ? transientAmount(dtc->envBank, kEnvFastLo,  kEnvSlowLo)  : 0.f;
+            dtc->transientMid[i] = hasTrsMid ? transientAmount(dtc->envBank, kEnvFastMid, kEnvSlowMid) : 0.f;
+            dtc->transientHi[i]  = hasTrsHi  ? transientAmount(dtc->envBank, kEnvFastHi,  kEnvSlowHi)  : 0.f;
         }
 
         // ---- 2. Envelope-driven overall drive ----
-        // PeakFollower updated per-sample above; read the end-of-block level here.
-        const float envDriveRaw = dtc->envFollower.getLevel();
+        // Envelope bank updated per-sample above; read the end-of-block level here.
+        const float envDriveRaw = dtc->envBank.getLevel(kEnvGlobal);
         // Apply shape curve: f(x) = x*(1+s)/(1+s*x)
         const float envDrive = (std::fabs(dtc->envShape) < 0.001f) ? envDriveRaw
             : envDriveRaw * (1.0f + dtc->envShape) / (1.0f + dtc->envShape * envDriveRaw);
@@ -756,35 +833,6 @@ static void step(_NT_algorithm* self, float* busFrames, int numFramesBy4) {
             }
         }
 
-        // ---- 4. Per-band envelope followers for transient detection ----
-        const bool gateLo  = blockPeakLo  > 0.01f;
-        const bool gateMid = blockPeakMid > 0.01f;
-        const bool gateHi  = blockPeakHi  > 0.01f;
-
-        dtc->envFastLo.gate(gateLo);  dtc->envSlowLo.gate(gateLo);
-        dtc->envFastLo.advanceBlock(n); dtc->envSlowLo.advanceBlock(n);
-        const float fLoS = dtc->envFastLo.getCurrentLevelShaped();
-        const float fLoE = dtc->envFastLo.getTargetLevelShaped();
-        const float sLoS = dtc->envSlowLo.getCurrentLevelShaped();
-        const float sLoE = dtc->envSlowLo.getTargetLevelShaped();
-        dtc->envFastLo.finalizeBlock(); dtc->envSlowLo.finalizeBlock();
-
-        dtc->envFastMid.gate(gateMid); dtc->envSlowMid.gate(gateMid);
-        dtc->envFastMid.advanceBlock(n); dtc->envSlowMid.advanceBlock(n);
-        const float fMidS = dtc->envFastMid.getCurrentLevelShaped();
-        const float fMidE = dtc->envFastMid.getTargetLevelShaped();
-        const float sMidS = dtc->envSlowMid.getCurrentLevelShaped();
-        const float sMidE = dtc->envSlowMid.getTargetLevelShaped();
-        dtc->envFastMid.finalizeBlock(); dtc->envSlowMid.finalizeBlock();
-
-        dtc->envFastHi.gate(gateHi);  dtc->envSlowHi.gate(gateHi);
-        dtc->envFastHi.advanceBlock(n); dtc->envSlowHi.advanceBlock(n);
-        const float fHiS = dtc->envFastHi.getCurrentLevelShaped();
-        const float fHiE = dtc->envFastHi.getTargetLevelShaped();
-        const float sHiS = dtc->envSlowHi.getCurrentLevelShaped();
-        const float sHiE = dtc->envSlowHi.getTargetLevelShaped();
-        dtc->envFastHi.finalizeBlock(); dtc->envSlowHi.finalizeBlock();
-
         const bool anyNoise = (dtc->noiseLevelLo + dtc->noiseLevelMid + dtc->noiseLevelHi) > 0.0001f;
 
         // Apply CV to ring carrier frequency for this block
@@ -798,7 +846,6 @@ static void step(_NT_algorithm* self, float* busFrames, int numFramesBy4) {
         // loop-invariant conditions out of the hot loop.
         // Carrier: avoids per-sample sine LFO overhead inside the critical path.
         // Booleans: prevents repeated comparisons and allows the compiler to eliminate dead branches.
-        // tStep:    replaces per-sample float division with a cheap accumulation.
         float* carrierBuf = dtc->ringCarrierBuf;
         for (int i = 0; i < n; ++i) carrierBuf[i] = dtc->ringCarrier.getNextValue();
         const bool hasRingLo   = dtc->ringDepthLo  > 0.0001f;
@@ -807,11 +854,9 @@ static void step(_NT_algorithm* self, float* busFrames, int numFramesBy4) {
         const bool hasWidthLo  = dtc->widthLo  != 1.f;
         const bool hasWidthMid = dtc->widthMid != 1.f;
         const bool hasWidthHi  = dtc->widthHi  != 1.f;
-        const float tStep = (n > 1) ? (1.0f / (float)(n - 1)) : 0.f;
 
         // ---- 5. Per-sample: ring mod, transient, noise, width, recombine ----
         for (int i = 0; i < n; ++i) {
-            const float t       = tStep * (float)i;
             const float carrier = carrierBuf[i];
 
             // Generate noise once per sample; scale per-band by noiseLevel
@@ -837,10 +882,8 @@ static void step(_NT_algorithm* self, float* busFrames, int numFramesBy4) {
                 loL[i] = loL[i] * (1.f - dtc->ringDepthLo) + loL[i] * carrier * dtc->ringDepthLo;
                 loR[i] = loR[i] * (1.f - dtc->ringDepthLo) + loR[i] * carrier * dtc->ringDepthLo;
             }
-            {
-                const float fast = fLoS + (fLoE - fLoS) * t;
-                const float slow = sLoS + (sLoE - sLoS) * t;
-                const float g = shapedTransientGain(fast - slow,
+            if (hasTrsLo) {
+                const float g = shapedTransientGain(dtc->transientLo[i],
                                                     dtc->transientAttackLo, dtc->transientSustainLo);
                 loL[i] *= g; loR[i] *= g;
             }
@@ -857,10 +900,8 @@ static void step(_NT_algorithm* self, float* busFrames, int numFramesBy4) {
                 midL[i] = midL[i] * (1.f - dtc->ringDepthMid) + midL[i] * carrier * dtc->ringDepthMid;
                 midR[i] = midR[i] * (1.f - dtc->ringDepthMid) + midR[i] * carrier * dtc->ringDepthMid;
             }
-            {
-                const float fast = fMidS + (fMidE - fMidS) * t;
-                const float slow = sMidS + (sMidE - sMidS) * t;
-                const float g = shapedTransientGain(fast - slow,
+            if (hasTrsMid) {
+                const float g = shapedTransientGain(dtc->transientMid[i],
                                                     dtc->transientAttackMid, dtc->transientSustainMid);
                 midL[i] *= g; midR[i] *= g;
             }
@@ -877,10 +918,8 @@ static void step(_NT_algorithm* self, float* busFrames, int numFramesBy4) {
                 hiL[i] = hiL[i] * (1.f - dtc->ringDepthHi) + hiL[i] * carrier * dtc->ringDepthHi;
                 hiR[i] = hiR[i] * (1.f - dtc->ringDepthHi) + hiR[i] * carrier * dtc->ringDepthHi;
             }
-            {
-                const float fast = fHiS + (fHiE - fHiS) * t;
-                const float slow = sHiS + (sHiE - sHiS) * t;
-                const float g = shapedTransientGain(fast - slow,
+            if (hasTrsHi) {
+                const float g = shapedTransientGain(dtc->transientHi[i],
                                                     dtc->transientAttackHi, dtc->transientSustainHi);
                 hiL[i] *= g; hiR[i] *= g;
             }
@@ -892,7 +931,7 @@ static void step(_NT_algorithm* self, float* busFrames, int numFramesBy4) {
                 hiL[i] = m + s; hiR[i] = m - s;
             }
 
-            // Recombine wet bands
+            // Recombine wet bands (in place over the low band)
             wetBufL[i] = loL[i] + midL[i] + hiL[i];
             wetBufR[i] = loR[i] + midR[i] + hiR[i];
         }
@@ -973,34 +1012,62 @@ static void step(_NT_algorithm* self, float* busFrames, int numFramesBy4) {
         }
 
         // ---- 7. Mix dry/wet and write output ----
-        // Precompute combined gains and hoist all loop-invariant conditions to eliminate
-        // per-sample branches and redundant multiplies.
+        // The dry path is read straight from the input buses.  All of this chunk's
+        // input is consumed by the mix loop before the first output sample is
+        // written, so an output routed onto its own input (in-place Replace) is
+        // safe without a separate dry copy.  Loop-invariant conditions are hoisted
+        // so every loop below is branch-free.
         {
             const float dryGain    = (1.0f - dtc->mix) * dtc->outputGain;
             const float wetGain    = dtc->mix * dtc->outputGain;
-            const bool  hasLimiter = dtc->outLimiter > 0.001f;
-            const bool  outLMix    = outL && (a->v[kParamOutLMode] == 0);
-            const bool  outRMix    = outR && (a->v[kParamOutRMode] == 0);
-            for (int i = 0; i < n; ++i) {
-                float outSigL = dryBufL[i] * dryGain + wetBufL[i] * wetGain;
-                float outSigR = dryBufR[i] * dryGain + wetBufR[i] * wetGain;
-
-                // Soft output limiter: blends linear output with cheap_saturate-clipped version.
-                // At outLimiter=0: bypass. At outLimiter=1: peaks above ~±1 are soft-clipped.
-                if (hasLimiter) {
-                    outSigL += (cheap_saturate(outSigL) - outSigL) * dtc->outLimiter;
-                    outSigR += (cheap_saturate(outSigR) - outSigR) * dtc->outLimiter;
+            const bool  hasDry     = dryGain != 0.0f;
+            const float* dryL      = (inL && hasDry) ? inL + offset : nullptr;
+            const float* dryR      = (inR && hasDry) ? inR + offset : nullptr;
+
+            if (dryL) { for (int i = 0; i < n; ++i) wetBufL[i] = dryL[i] * dryGain + wetBufL[i] * wetGain; }
+            else      { for (int i = 0; i < n; ++i) wetBufL[i] *= wetGain; }
+            if (dryR) { for (int i = 0; i < n; ++i) wetBufR[i] = dryR[i] * dryGain + wetBufR[i] * wetGain; }
+            else      { for (int i = 0; i < n; ++i) wetBufR[i] *= wetGain; }
+
+            // Soft output limiter: blends linear output with cheap_saturate-clipped version.
+            // At outLimiter=0: bypass. At outLimiter=1: peaks above ~±1 are soft-clipped.
+            if (dtc->outLimiter > 0.001f) {
+                for (int i = 0; i < n; ++i) {
+                    wetBufL[i] += (cheap_saturate(wetBufL[i]) - wetBufL[i]) * dtc->outLimiter;
+                    wetBufR[i] += (cheap_saturate(wetBufR[i]) - wetBufR[i]) * dtc->outLimiter;
                 }
-
-                if (outL) { if (outLMix) outL[offset + i] += outSigL; else outL[offset + i] = outSigL; }
-                if (outR) { if (outRMix) outR[offset + i] += outSigR; else outR[offset + i] = outSigR; }
             }
+
+            // Lookahead brickwall limiter: final stage, hard ceiling on the output.
+            if (dtc->limiterOn) dtc->limiter.processBlock(wetBufL, wetBufR, n);
+
+            if (outL) writeOutputChunk(outL + offset, wetBufL, n, a->v[kParamOutLMode] == 0);
+            if (outR) writeOutputChunk(outR + offset, wetBufR, n, a->v[kParamOutRMode] == 0);
         }
 
         offset += n;
     }
 }
 
+static void step(_NT_algorithm* self, float* busFrames, int numFramesBy4) {
+    processChunks<kBlockChunk>(static_cast<_NerberusAlgorithm*>(self), busFrames, numFramesBy4 * 4);
+}
+
+
+// Lim Look shows the lookahead together with the latency it adds, so the
+// delay can be compensated on parallel paths.
+static int parameterString(_NT_algorithm* self, int p, int v, char* buff) {
+    if (p != kParamLimLookahead) return 0;
+    auto* a = static_cast<_NerberusAlgorithm*>(self);
+    int len = NT_intToString(buff, v / 10);
+    buff[len++] = '.';
+    len += NT_intToString(buff + len, v % 10);
+    buff[len++] = 'm'; buff[len++] = 's'; buff[len++] = ' ';
+    len += NT_intToString(buff + len, limiterLookaheadSamples(v, a->dtc->sampleRate));
+    buff[len++] = 's'; buff[len++] = 'm'; buff[len++] = 'p';
+    buff[len] = '\0';
+    return len;
+}
 
 static const _NT_factory kFactory = {
     .guid = NT_MULTICHAR('C', 'R', 'B', 'R'),
@@ -1025,7 +1092,7 @@ static const _NT_factory kFactory = {
     .deserialise = nullptr,
     .midiSysEx = nullptr,
     .parameterUiPrefix = nullptr,
-    .parameterString = nullptr,
+    .parameterString = parameterString,
 };
 
 extern "C" uintptr_t pluginEntry(_NT_selector selector, uint32_t data) {
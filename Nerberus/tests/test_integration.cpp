@@ -2,6 +2,9 @@
 #include "plugin_harness.h"
 #include "wav_writer.h"
 #include "sha256.h"
+#include "perf_registry.h"
+#include "BandCrusher.h"
+#include "LookaheadLimiter.h"
 
 #include <vector>
 #include <cmath>
@@ -60,6 +63,13 @@ enum {
     kParamOutputLP,
     kParamOutLimiter,
     kParamLoSatMode,
+
+    kParamLimiter,
+    kParamLimCeiling,
+    kParamLimLookahead,
+    kParamLimRelease,
+
+    kParamDitherLo, kParamDitherMid, kParamDitherHi,
 };
 
 struct LoadedWav {
@@ -943,6 +953,318 @@ TestResult test_lo_asym_saturation_wav() {
     TEST_PASS();
 }
 
+// -------------------------------------------------------------------------
+// Lookahead brickwall limiter
+// -------------------------------------------------------------------------
+
+TestResult test_lookahead_limiter_ceiling_and_latency() {
+    TEST_BEGIN("LookaheadLimiter: hard ceiling and latency equal to lookahead");
+    static LookaheadLimiter<256> lim;
+    lim.init(48000.0f);
+    lim.setCeiling(0.5f);
+    lim.setLookahead(64);
+    lim.setRelease(0.02f);
+    ASSERT_EQ(lim.getLatency(), 64, "latency equals lookahead");
+
+    // Below the ceiling the limiter is a pure delay.
+    float l[256] = {}, r[256] = {};
+    l[10] = 0.25f;
+    r[10] = -0.25f;
+    lim.processBlock(l, r, 256);
+    ASSERT_NEAR(l[74], 0.25f, 1e-5f, "impulse left emerges after lookahead");
+    ASSERT_NEAR(r[74], -0.25f, 1e-5f, "impulse right emerges after lookahead");
+    ASSERT_NEAR(l[10], 0.0f, 1e-9f, "nothing at the input position");
+
+    // Hot noise bursts: output must never exceed the ceiling.
+    uint32_t seed = 1;
+    float peakOut = 0.0f;
+    for (int blk = 0; blk < 200; ++blk) {
+        for (int i = 0; i < 256; ++i) {
+            seed = seed * 1664525u + 1013904223u;
+            const float noise = ((float)(seed >> 8) / 8388608.0f) - 1.0f;
+            const float amp = ((blk / 10) & 1) ? 4.0f : 0.3f;
+            l[i] = noise * amp;
+            r[i] = -noise * amp * 0.7f;
+        }
+        lim.processBlock(l, r, 256);
+        peakOut = std::max(peakOut, PluginInstance::peak(l, 256));
+        peakOut = std::max(peakOut, PluginInstance::peak(r, 256));
+    }
+    ASSERT_LT(peakOut, 0.5f + 1e-6f, "peak never exceeds ceiling");
+    ASSERT_GT(peakOut, 0.45f, "limiter drives peaks up to the ceiling");
+    TEST_PASS();
+}
+
+// A strictly decreasing signal keeps every sample of the window queued in the
+// sliding maximum.  At the longest lookahead that is the whole ring, and the
+// gain applied to each delayed sample must still bring it down to the ceiling.
+TestResult test_lookahead_limiter_decay_at_max_lookahead() {
+    TEST_BEGIN("LookaheadLimiter: decreasing ramp at maximum lookahead");
+    static LookaheadLimiter<256> lim;
+    const int look = LookaheadLimiter<256>::kMaxLookahead;
+    lim.init(96000.0f);
+    lim.setCeiling(0.5f);
+    lim.setLookahead(look);
+    lim.setRelease(0.0f);   // gain follows the window peak directly
+
+    const int n = 2048;
+    static float in[n];
+    for (int i = 0; i < n; ++i) in[i] = 4.0f - 3.0f * (float)i / n;
+
+    float worst = 0.0f;
+    for (int i = 0; i < n; ++i) {
+        float l = in[i], r = -in[i];
+        lim.processBlock(&l, &r, 1);
+        if (i >= look) worst = std::max(worst, in[i - look] * lim.getGain());
+    }
+    ASSERT_LT(worst, 0.5f + 1e-5f, "gain covers the delayed sample");
+    TEST_PASS();
+}
+
+TestResult test_lookahead_limiter_wav() {
+    TEST_BEGIN("Lookahead limiter: brickwall ceiling on hot signal (writes bin/Nerberus_lookahead_limiter.wav)");
+    LoadedWav wav;
+    ASSERT_TRUE(loadWav("testWav/loop1.wav", wav), "loaded loop1.wav");
+
+    PluginInstance plugin;
+    ASSERT_TRUE(createPlugin(plugin, wav.sampleRate), "plugin constructed");
+    setBaseRouting(plugin);
+
+    // Same hot chain as the soft-limiter showcase, pushed further with output gain.
+    plugin.setParameter(kParamDrive, 1000);
+    plugin.setParameter(kParamGritLo,  800);
+    plugin.setParameter(kParamGritMid, 800);
+    plugin.setParameter(kParamGritHi,  800);
+    plugin.setParameter(kParamFilterMode, 6);  // Bypass
+    plugin.setParameter(kParamOutput, 2000);
+
+    plugin.setParameter(kParamLimiter, 1);
+    plugin.setParameter(kParamLimCeiling, -10);   // -1.0 dBFS
+    plugin.setParameter(kParamLimLookahead, 20);  // 2.0 ms
+    plugin.setParameter(kParamLimRelease, 80);
+
+    char buf[kNT_parameterStringSize];
+    plugin.factory()->parameterString(plugin.algorithm(), kParamLimLookahead, 20, buf);
+    const std::string expected = "2.0ms " + std::to_string((int)(0.002f * wav.sampleRate + 0.5f)) + "smp";
+    ASSERT_TRUE(expected == buf, "Lim Look reports lookahead and latency");
+
+    RenderStats stats = processLoopToWav(plugin, wav, "bin/Nerberus_lookahead_limiter.wav", 2);
+    const float ceiling = powf(10.0f, -1.0f / 20.0f);
+    ASSERT_GT(stats.peakL, 0.5f, "limited left has signal");
+    ASSERT_GT(stats.peakR, 0.5f, "limited right has signal");
+    ASSERT_LT(stats.peakL, ceiling + 1e-5f, "left peak held at ceiling");
+    ASSERT_LT(stats.peakR, ceiling + 1e-5f, "right peak held at ceiling");
+    TEST_PASS();
+}
+
+// -------------------------------------------------------------------------
+// Block crush kernel
+// -------------------------------------------------------------------------
+
+TestResult test_band_crusher_kernels() {
+    TEST_BEGIN("BandCrusher: strided hold, integer quantise, dither modes");
+    typedef BandCrusher<64> Crusher;
+    float l[64], r[64];
+
+    // Decimation only: hold runs continue across block boundaries.
+    Crusher dec;
+    dec.reset(1);
+    dec.setDecimation(5);
+    int sample = 0;
+    bool holdOk = true;
+    for (int blk = 0; blk < 4; ++blk) {
+        const int n = (blk & 1) ? 64 : 23;
+        for (int i = 0; i < n; ++i) { l[i] = (float)(sample + i); r[i] = -(float)(sample + i); }
+        dec.processBlock(l, r, n);
+        for (int i = 0; i < n; ++i) {
+            const int k = sample + i;
+            const float expected = (float)((k / 5) * 5);  // captures at 0, 5, 10, ...
+            if ((l[i] != expected || r[i] != -expected)) holdOk = false;
+        }
+        sample += n;
+    }
+    ASSERT_TRUE(holdOk, "strided hold matches per-sample reference");
+
+    // Dither off: values land on the 4-bit grid, error at most half an LSB.
+    Crusher off;
+    off.reset(2);
+    off.setBits(4);
+    off.setDither(Crusher::kDitherOff);
+    float maxErr = 0.0f;
+    bool onGrid = true;
+    for (int i = 0; i < 64; ++i) { l[i] = r[i] = -0.9f + i * 0.0283f; }
+    float src[64];
+    for (int i = 0; i < 64; ++i) src[i] = l[i];
+    off.processBlock(l, r, 64);
+    for (int i = 0; i < 64; ++i) {
+        const float steps = l[i] * 16.0f;
+        if (steps != std::floor(steps)) onGrid = false;
+        maxErr = std::max(maxErr, std::fabs(l[i] - src[i]));
+    }
+    ASSERT_TRUE(onGrid, "4-bit output on the 1/16 grid");
+    ASSERT_LT(maxErr, 0.5f / 16.0f + 1e-4f, "rounding error <= half LSB");
+
+    // TPDF and Shaped: error within bounds; shaping moves error energy up.
+    Crusher tpdf, shaped;
+    tpdf.reset(3);
+    shaped.reset(3);
+    tpdf.setBits(6);
+    shaped.setBits(6);
+    tpdf.setDither(Crusher::kDitherTPDF);
+    shaped.setDither(Crusher::kDitherShaped);
+    double lfTpdf = 0.0, lfShaped = 0.0;
+    float maxTpdfErr = 0.0f;
+    float tl[64], tr[64], sl[64], sr[64];
+    for (int blk = 0; blk < 64; ++blk) {
+        for (int i = 0; i < 64; ++i) {
+            const float x = 0.4f * sinf((float)(blk * 64 + i) * 0.013f);
+            tl[i] = tr[i] = sl[i] = sr[i] = src[i] = x;
+        }
+        tpdf.processBlock(tl, tr, 64);
+        shaped.processBlock(sl, sr, 64);
+        // Error summed over 16-sample windows ~ low-pass: compares energy near DC.
+        for (int w = 0; w < 64; w += 16) {
+            double sumT = 0.0, sumS = 0.0;
+            for (int i = w; i < w + 16; ++i) {
+                sumT += tl[i] - src[i];
+                sumS += sl[i] - src[i];
+                maxTpdfErr = std::max(maxTpdfErr, std::fabs(tl[i] - src[i]));
+            }
+            lfTpdf   += sumT * sumT;
+            lfShaped += sumS * sumS;
+        }
+    }
+    ASSERT_LT(maxTpdfErr, 1.5f / 64.0f + 1e-4f, "TPDF error within 1.5 LSB");
+    ASSERT_LT(lfShaped, lfTpdf * 0.5, "noise shaping lowers low-frequency error");
+    TEST_PASS();
+}
+
+// -------------------------------------------------------------------------
+// Sample-accurate transient shaping
+// -------------------------------------------------------------------------
+
+TestResult test_transient_independent_of_host_block() {
+    TEST_BEGIN("Transient shaper: output independent of host block size");
+    LoadedWav wav;
+    ASSERT_TRUE(loadWav("testWav/loop1.wav", wav), "loaded loop1.wav");
+
+    PluginInstance ref, split;
+    ASSERT_TRUE(createPlugin(ref, wav.sampleRate), "reference constructed");
+    ASSERT_TRUE(createPlugin(split, wav.sampleRate), "split constructed");
+    PluginInstance* both[2] = { &ref, &split };
+    for (PluginInstance* p : both) {
+        setBaseRouting(*p);
+        p->setParameter(kParamTransientAttackLo,   600);
+        p->setParameter(kParamTransientAttackMid,  700);
+        p->setParameter(kParamTransientSustainMid, -500);
+        p->setParameter(kParamTransientSustainHi,  -400);
+    }
+
+    // Reference runs whole 64-frame blocks; the other sees the same audio as
+    // 16-frame host blocks, so every envelope chunk boundary moves.
+    const int kSplit = 16;
+    std::vector<float> blkL(BLOCK), blkR(BLOCK);
+    float maxDiff = 0.0f;
+    float refPeak = 0.0f;
+    const int numBlocks = (int)(wav.left.size() / BLOCK);
+    for (int b = 0; b < numBlocks; ++b) {
+        for (int i = 0; i < BLOCK; ++i) {
+            blkL[i] = wav.left[(size_t)b * BLOCK + i];
+            blkR[i] = wav.right[(size_t)b * BLOCK + i];
+        }
+        ref.prepareStep(BLOCK);
+        ref.fillBus(IN_L_BUS, blkL.data(), BLOCK);
+        ref.fillBus(IN_R_BUS, blkR.data(), BLOCK);
+        ref.executeStep(BLOCK);
+        const float* refL = ref.getBus(OUT_L_BUS, BLOCK);
+        refPeak = std::max(refPeak, PluginInstance::peak(refL, BLOCK));
+
+        for (int s = 0; s < BLOCK; s += kSplit) {
+            split.prepareStep(kSplit);
+            split.fillBus(IN_L_BUS, blkL.data() + s, kSplit);
+            split.fillBus(IN_R_BUS, blkR.data() + s, kSplit);
+            split.executeStep(kSplit);
+            const float* outL = split.getBus(OUT_L_BUS, kSplit);
+            for (int i = 0; i < kSplit; ++i)
+                maxDiff = std::max(maxDiff, std::fabs(refL[s + i] - outL[i]));
+        }
+    }
+    ASSERT_GT(refPeak, 0.01f, "reference output has signal");
+    ASSERT_LT(maxDiff, 1e-4f, "16-frame host blocks match 64-frame blocks");
+    TEST_PASS();
+}
+
+// -------------------------------------------------------------------------
+// In-place bus processing
+// -------------------------------------------------------------------------
+
+// Noise is left off: it draws from the shared xorshift PRNG, so two
+// interleaved instances would not see the same sequence.  Crush dither uses a
+// per-instance PRNG and is safe to include.
+static void setInPlaceTestParams(PluginInstance& plugin) {
+    plugin.setParameter(kParamDrive, 650);
+    plugin.setParameter(kParamGritMid, 300);
+    plugin.setParameter(kParamBitDepthMid, 7);
+    plugin.setParameter(kParamDecimationHi, 3);
+    plugin.setParameter(kParamDitherMid, 2);    // TPDF
+    plugin.setParameter(kParamWidthHi, 1500);
+    plugin.setParameter(kParamFilterMode, 1);   // LP4
+    plugin.setParameter(kParamFilterCutoff, 8000);
+    plugin.setParameter(kParamOutLimiter, 500);
+    plugin.setParameter(kParamMix, 600);      // keep a dry component in the output
+    plugin.setParameter(kParamOutput, 900);
+}
+
+TestResult test_in_place_replace_matches_separate_bus() {
+    TEST_BEGIN("In-place Replace routing (Out = In) matches separate output buses");
+    LoadedWav wav;
+    ASSERT_TRUE(loadWav("testWav/loop1.wav", wav), "loaded loop1.wav");
+
+    PluginInstance ref, inPlace;
+    ASSERT_TRUE(createPlugin(ref, wav.sampleRate), "reference constructed");
+    ASSERT_TRUE(createPlugin(inPlace, wav.sampleRate), "in-place constructed");
+    setBaseRouting(ref);
+    setBaseRouting(inPlace);
+    setInPlaceTestParams(ref);
+    setInPlaceTestParams(inPlace);
+    inPlace.setParameter(kParamOutL, IN_L_BUS + 1);
+    inPlace.setParameter(kParamOutR, IN_R_BUS + 1);
+
+    std::vector<float> inBlkL(BLOCK), inBlkR(BLOCK);
+    float maxDiff = 0.0f;
+    float peakOut = 0.0f;
+    const int numBlocks = (int)(wav.left.size() / BLOCK);
+    for (int b = 0; b < numBlocks; ++b) {
+        for (int i = 0; i < BLOCK; ++i) {
+            inBlkL[i] = wav.left[(size_t)b * BLOCK + i];
+            inBlkR[i] = wav.right[(size_t)b * BLOCK + i];
+        }
+        ref.prepareStep(BLOCK);
+        ref.fillBus(IN_L_BUS, inBlkL.data(), BLOCK);
+        ref.fillBus(IN_R_BUS, inBlkR.data(), BLOCK);
+        ref.executeStep(BLOCK);
+
+        inPlace.prepareStep(BLOCK);
+        inPlace.fillBus(IN_L_BUS, inBlkL.data(), BLOCK);
+        inPlace.fillBus(IN_R_BUS, inBlkR.data(), BLOCK);
+        inPlace.executeStep(BLOCK);
+
+        const float* refL = ref.getBus(OUT_L_BUS, BLOCK);
+        const float* refR = ref.getBus(OUT_R_BUS, BLOCK);
+        const float* ipL  = inPlace.getBus(IN_L_BUS, BLOCK);
+        const float* ipR  = inPlace.getBus(IN_R_BUS, BLOCK);
+        for (int i = 0; i < BLOCK; ++i) {
+            maxDiff = std::max(maxDiff, std::fabs(refL[i] - ipL[i]));
+            maxDiff = std::max(maxDiff, std::fabs(refR[i] - ipR[i]));
+        }
+        peakOut = std::max(peakOut, PluginInstance::peak(refL, BLOCK));
+    }
+
+    ASSERT_GT(peakOut, 0.01f, "reference output has signal");
+    ASSERT_EQ(maxDiff, 0.0f, "in-place output is bit-identical to separate-bus output");
+    TEST_PASS();
+}
+
 // -------------------------------------------------------------------------
 // Input HP conditioning
 // -------------------------------------------------------------------------
@@ -1159,6 +1481,37 @@ TestResult test_golden_wav_hashes() {
     TEST_PASS();
 }
 
+// -------------------------------------------------------------------------
+// Performance baseline: the golden renders, timed per WAV scenario
+// -------------------------------------------------------------------------
+
+TestResult test_perf_baseline() {
+    TEST_BEGIN("Performance baseline (cycles/frame vs tests/perf_baseline.txt)");
+    const bool withinBudget = PerfRegistry::check("tests/perf_baseline.txt", {
+        test_showcase_dry_passthrough_wav,
+        test_showcase_full_stack_wav,
+        test_transient_shaper_wav,
+        test_ring_modulator_wav,
+        test_showcase_filter_sweep_wav,
+        test_showcase_spunk_hihat_wav,
+        test_classic_multiband_wav,
+        test_cv_filter_freq_modulation,
+        test_cv_ring_freq_modulation,
+        test_env_dest_drive_sensitivity_wav,
+        test_env_dest_filter_cutoff_wav,
+        test_env_dest_filter_drive_wav,
+        test_env_dest_filter_res_wav,
+        test_input_hp_conditioning_wav,
+        test_dynamic_bias_wav,
+        test_output_lp_cab_rolloff_wav,
+        test_output_soft_limiter_wav,
+        test_lo_asym_saturation_wav,
+        test_lookahead_limiter_wav,
+    });
+    ASSERT_TRUE(withinBudget, "no render scenario slower than baseline tolerance");
+    TEST_PASS();
+}
+
 int main() {
     return TestRunner::run({
         test_plugin_loads,
@@ -1181,6 +1534,13 @@ int main() {
         test_output_lp_cab_rolloff_wav,
         test_output_soft_limiter_wav,
         test_lo_asym_saturation_wav,
+        test_lookahead_limiter_ceiling_and_latency,
+        test_lookahead_limiter_decay_at_max_lookahead,
+        test_band_crusher_kernels,
+        test_lookahead_limiter_wav,
+        test_transient_independent_of_host_block,
+        test_in_place_replace_matches_separate_bus,
         test_golden_wav_hashes,
+        test_perf_baseline,
     });
 }
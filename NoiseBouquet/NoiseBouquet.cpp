@@ -3,12 +3,14 @@
 // =============================================================================
 // Multi-algorithm via Bank + Program selectors:
 //   - 4 banks × up to 10 programs.
-//   - One placement-new arena (sized at compile time to fit the largest
-//     algorithm in PluginRegistry) hosts the active algo.
-//   - On Bank/Program change: in-place destruct, placement-new, init() —
-//     all synchronous; a short fade-in/-out in step() suppresses the
-//     inevitable click.
+//   - Placement-new arenas (each sized at compile time to fit the largest
+//     algorithm in PluginRegistry) host the playing algos, plus one spare.
+//   - On Bank/Program change: the new program is built in the spare arena a
+//     stage per block while the old one plays, then the two crossfade.
 //   - X/Y controls glide over a short one-pole ramp to suppress zippering.
+//   - The "Engines" specification adds a second engine: another program with
+//     its own Bank/Program/X/Y/Gain and output, sharing the spare arena, the
+//     resampler kernels and the per-block control work with the first.
 // =============================================================================
 
 #include <math.h>
@@ -18,6 +20,7 @@
 
 #include "include/nt_rack_shim.hpp"
 #include "include/PluginRegistry.hpp"
+#include "include/PolyphaseResampler.hpp"
 
 #ifndef ARRAY_SIZE
 #define ARRAY_SIZE(a) (sizeof(a) / sizeof((a)[0]))
@@ -58,13 +61,34 @@ enum {
     kParamX,
     kParamY,
     kParamGain,
+    kParamQuality,
+    kParamRenderRate,
     kNumParams,
 };
 
+// With two engines the second one's parameters follow, in the same order as
+// the first one's kParamOut..kParamGain.
+enum {
+    kParamOut2 = kNumParams,
+    kParamOutMode2,
+    kParamBank2,
+    kParamProgram2,
+    kParamX2,
+    kParamY2,
+    kParamGain2,
+    kNumParamsDual,
+};
+
+static constexpr int kMaxEngines = 2;
+static constexpr int kEngineBase[kMaxEngines] = { kParamOut, kParamOut2 };
+
 // Defaults: Bank 4, Program 2 = WhiteNoise (the M1-equivalent default sound).
 static constexpr int kDefaultBank    = 4;
 static constexpr int kDefaultProgram = 2;
 
+static const char* const qualityStrings[] = { "Linear", "8-tap", "16-tap", nullptr };
+static const char* const renderRateStrings[] = { "44.1 kHz", "Host", nullptr };
+
 static const _NT_parameter parameters[] = {
     NT_PARAMETER_AUDIO_OUTPUT_WITH_MODE("Out", 1, 13)
     { .name = "Bank",    .min = 1, .max = 4,    .def = kDefaultBank,
@@ -77,15 +101,33 @@ static const _NT_parameter parameters[] = {
       .unit = kNT_unitPercent,    .scaling = kNT_scaling100,   .enumStrings = nullptr },
     { .name = "Gain",    .min = 0, .max = 2000, .def = 1000,
       .unit = kNT_unitPercent,    .scaling = kNT_scaling1000,  .enumStrings = nullptr },
+    { .name = "Resampler", .min = 0, .max = PolyphaseResampler::kNumQualities - 1,
+      .def = PolyphaseResampler::kSinc8,
+      .unit = kNT_unitEnum,       .scaling = 0,                .enumStrings = qualityStrings },
+    { .name = "Render rate", .min = 0, .max = 1, .def = 0,
+      .unit = kNT_unitEnum,       .scaling = 0,                .enumStrings = renderRateStrings },
+    NT_PARAMETER_AUDIO_OUTPUT_WITH_MODE("B Out", 1, 14)
+    { .name = "B Bank",    .min = 1, .max = 4,    .def = kDefaultBank,
+      .unit = kNT_unitHasStrings, .scaling = 0,                .enumStrings = nullptr },
+    { .name = "B Program", .min = 1, .max = 10,   .def = kDefaultProgram,
+      .unit = kNT_unitHasStrings, .scaling = 0,                .enumStrings = nullptr },
+    { .name = "B X",       .min = 0, .max = 10000, .def = 5000,
+      .unit = kNT_unitPercent,    .scaling = kNT_scaling100,   .enumStrings = nullptr },
+    { .name = "B Y",       .min = 0, .max = 10000, .def = 5000,
+      .unit = kNT_unitPercent,    .scaling = kNT_scaling100,   .enumStrings = nullptr },
+    { .name = "B Gain",    .min = 0, .max = 2000, .def = 1000,
+      .unit = kNT_unitPercent,    .scaling = kNT_scaling1000,  .enumStrings = nullptr },
 };
-static_assert(ARRAY_SIZE(parameters) == kNumParams, "parameter count mismatch");
+static_assert(ARRAY_SIZE(parameters) == kNumParamsDual, "parameter count mismatch");
 
 static const uint8_t pagePatch[]   = { kParamBank, kParamProgram, kParamX, kParamY, kParamGain };
 static const uint8_t pageRouting[] = { kParamOut, kParamOutMode };
+static const uint8_t pageEngine[]  = { kParamQuality, kParamRenderRate };
 
 static const _NT_parameterPage pages[] = {
     { .name = "Patch",   .numParams = ARRAY_SIZE(pagePatch),   .params = pagePatch   },
     { .name = "Routing", .numParams = ARRAY_SIZE(pageRouting), .params = pageRouting },
+    { .name = "Engine",  .numParams = ARRAY_SIZE(pageEngine),  .params = pageEngine  },
 };
 
 static const _NT_parameterPages parameterPages = {
@@ -93,27 +135,61 @@ static const _NT_parameterPages parameterPages = {
     .pages    = pages,
 };
 
+static const uint8_t pagePatch2[]      = { kParamBank2, kParamProgram2, kParamX2, kParamY2, kParamGain2 };
+static const uint8_t pageRoutingDual[] = { kParamOut, kParamOutMode, kParamOut2, kParamOutMode2 };
+
+static const _NT_parameterPage pagesDual[] = {
+    { .name = "Patch",   .numParams = ARRAY_SIZE(pagePatch),       .params = pagePatch       },
+    { .name = "Patch B", .numParams = ARRAY_SIZE(pagePatch2),      .params = pagePatch2      },
+    { .name = "Routing", .numParams = ARRAY_SIZE(pageRoutingDual), .params = pageRoutingDual },
+    { .name = "Engine",  .numParams = ARRAY_SIZE(pageEngine),      .params = pageEngine      },
+};
+
+static const _NT_parameterPages parameterPagesDual = {
+    .numPages = ARRAY_SIZE(pagesDual),
+    .pages    = pagesDual,
+};
+
+static const _NT_specification specs[] = {
+    { .name = "Engines", .min = 1, .max = kMaxEngines, .def = 1, .type = kNT_typeGeneric },
+};
+
 // =============================================================================
 // Algorithm instance
 // =============================================================================
 
-// A short program-change crossfade (ms) suppresses the click from
-// re-initialising the algo arena. Synchronous construction stays well within
-// audio block timing for the small Bank-4 algos.
+// Program changes build the incoming program in the spare arena while the
+// current one keeps playing, one stage per audio block, then equal-power
+// crossfade the two over kFadeMs.
 static constexpr float kFadeMs = 30.0f;
+// Arena bytes zeroed per block while building a program.
+static constexpr uint32_t kClearSlice = 8192;
 // X/Y smoothing (ms) trims audible zippering when the user moves controls.
 static constexpr float kControlSmoothMs = 10.0f;
 
-struct _NPAlgorithm_DTC {
-    // Pointer to the live algorithm arena (lives in DRAM, see construct()).
-    // The arena is sized at compile time to fit the largest entry in the
-    // registry; alignment is the strictest required by any algo.
-    // We keep the arena in DRAM (not DTC) because DTC is a small scarce
-    // resource shared across loaded algorithms — putting the ~30 kB arena
-    // there has been observed to hang the host on plugin load.
-    uint8_t* algoArena = nullptr;
+// One program: its arena, the algorithm built in it and the resampler state
+// of its stream. The arena is sized at compile time to fit the largest entry
+// in the registry; alignment is the strictest required by any algo.
+// Arenas and resamplers live in DRAM (not DTC) because DTC is a small scarce
+// resource shared across loaded algorithms — putting a ~30 kB arena there
+// has been observed to hang the host on plugin load.
+struct AlgoSlot {
+    uint8_t* arena = nullptr;
+    PolyphaseResampler* resampler = nullptr;
     NoisePlethoraPlugin* algo = nullptr;
-    const np_registry::Entry* entry = nullptr; // current registry row (or nullptr)
+    const np_registry::Entry* entry = nullptr; // registry row (or nullptr)
+    float entryGain = 1.0f;  // per-program trim from registry
+    uint8_t bank = 0;
+    uint8_t slot = 0;
+    // Native-rate mode: whether this algorithm was built against the host
+    // rate, and the rate it was built against.
+    bool  native     = false;
+    float renderRate = 44100.0f;
+};
+
+// One program voice of the instance, with its own controls and output.
+struct Engine {
+    uint8_t live = 0;  // slot of the program on its bus
 
     // Target control values come from parameterChanged(); kx/ky glide toward
     // them in step() to suppress zippering without changing steady-state.
@@ -122,30 +198,47 @@ struct _NPAlgorithm_DTC {
     float kx       = 0.5f;
     float ky       = 0.5f;
     float gain = 1.0f;
-    float entryGain = 1.0f;  // per-program trim from registry
 
-    // Tracks the (bank, slot) currently constructed in algoArena so we only
-    // reconstruct when the user actually moves the encoder.
-    uint8_t curBank = 0;
-    uint8_t curSlot = 0;
-
-    // Crossfade state machine.
-    enum FadeState : uint8_t { kRunning, kFadingOut, kFadingIn };
-    FadeState fadeState   = kRunning;
-    int       fadeSamples = 0;   // total samples in a fade segment
-    int       fadePos     = 0;   // sample index within current segment
-    uint8_t   targetBank  = 0;   // pending switch target
-    uint8_t   targetSlot  = 0;
-    bool      switchPending = false;
-
-    // Linear-interpolation resampler state. The vendored algos run at a
-    // fixed internal rate of 44.1 kHz (AUDIO_SAMPLE_RATE_EXACT); when the
-    // NT host runs at any other rate we resample on the fly so pitches and
-    // times match the original Befaco hardware. Bypassed when rates match.
-    float resamplePhase = 0.0f;  // 0..1, fractional position into [prev,curr]
-    float resamplePrev  = 0.0f;
-    float resampleCurr  = 0.0f;
-    bool  resampleInited = false;
+    uint8_t targetBank    = 0;   // pending switch target
+    uint8_t targetSlot    = 0;
+    bool    switchPending = false;
+};
+
+struct _NPAlgorithm_DTC {
+    // Each engine plays the program in its live slot. The spare slot is
+    // empty, or holds the program one engine is switching to: switches are
+    // served one engine at a time, so one spare covers both.
+    AlgoSlot slots[kMaxEngines + 1];
+    Engine   engines[kMaxEngines];
+    uint8_t  numEngines = 1;
+    uint8_t  spare      = 1;
+    uint8_t  switching  = 0;  // engine the switch below belongs to
+
+    int       numSlots() const          { return numEngines + 1; }
+    AlgoSlot& liveSlot(int e)           { return slots[engines[e].live]; }
+    AlgoSlot& spareSlot()               { return slots[spare]; }
+    bool      isSwitching(int e) const  { return switchState != kRunning && switching == e; }
+
+    // Program-change state machine: kLoading builds the spare slot one
+    // LoadStage per block, kCrossfading plays it against the engine's live one.
+    enum SwitchState : uint8_t { kRunning, kLoading, kCrossfading };
+    enum LoadStage : uint8_t { kLoadClear, kLoadConstruct, kLoadInit, kLoadPrime, kLoadDone };
+    SwitchState switchState = kRunning;
+    LoadStage   loadStage   = kLoadDone;
+    uint32_t    cleared     = 0;  // arena bytes zeroed so far
+    int       fadeSamples = 0;   // total samples in the crossfade
+    int       fadePos     = 0;   // sample index within it
+
+    // Native-rate mode ("Render rate" = Host): algorithms flagged nativeRate
+    // in the registry are built against the host rate and skip the resampler.
+    bool nativeRequested = false;
+
+    // The vendored algos run at a fixed internal rate of 44.1 kHz
+    // (AUDIO_SAMPLE_RATE_EXACT); when the NT host runs at any other rate we
+    // resample on the fly so pitches and times match the original Befaco
+    // hardware. Bypassed when rates match. The kernel tables are shared by
+    // every slot's resampler and live in DRAM: far too large for the DTC.
+    PolyphaseKernels* kernels = nullptr;
 };
 
 struct _NPAlgorithm : public _NT_algorithm {
@@ -158,36 +251,85 @@ struct _NPAlgorithm : public _NT_algorithm {
 // Helpers
 // -----------------------------------------------------------------------------
 
-static void destructAlgo(_NPAlgorithm_DTC* dtc) {
-    if (dtc->algo && dtc->entry) {
-        dtc->entry->destroy(dtc->algo);
+static void destructAlgo(AlgoSlot& s) {
+    if (s.algo && s.entry) {
+        s.entry->destroy(s.algo);
     }
-    dtc->algo  = nullptr;
-    dtc->entry = nullptr;
+    s.algo  = nullptr;
+    s.entry = nullptr;
 }
 
-// Build the algorithm at (bank, slot), or leave the arena empty if no entry.
-static void constructAlgo(_NPAlgorithm_DTC* dtc, uint8_t bank, uint8_t slot) {
-    destructAlgo(dtc);
+// Starts building the algorithm at (bank, slot) into `s`, or leaving the
+// arena empty if no entry: the previous occupant is destroyed and the slot
+// takes on the new program's registry row and render rate.
+static void beginLoad(_NPAlgorithm_DTC* dtc, AlgoSlot& s, uint8_t bank, uint8_t slot) {
+    destructAlgo(s);
     const auto* e = np_registry::find(bank, slot);
-    dtc->curBank = bank;
-    dtc->curSlot = slot;
-    dtc->entry   = e;
+    s.bank      = bank;
+    s.slot      = slot;
+    s.entry     = e;
+    s.entryGain = e ? e->gain : 1.0f;
     // Reset resampler so the new algo starts from a clean state.
-    dtc->resamplePhase  = 0.0f;
-    dtc->resamplePrev   = 0.0f;
-    dtc->resampleCurr   = 0.0f;
-    dtc->resampleInited = false;
-    if (!e) {
-        dtc->entryGain = 1.0f;
-        return;          // leave arena dormant; step() will emit silence
-    }
-    dtc->algo = e->factory(dtc->algoArena);
-    if (dtc->algo) {
-        dtc->algo->init();
-        dtc->algo->process(dtc->kx, dtc->ky);
+    s.resampler->reset();
+    const float hostSR = (float)NT_globals.sampleRate;
+    s.native     = dtc->nativeRequested && e && e->nativeRate && hostSR != 44100.0f;
+    s.renderRate = s.native ? hostSR : 44100.0f;
+    // No entry: leave arena dormant; the slot renders silence.
+    dtc->loadStage = e ? _NPAlgorithm_DTC::kLoadClear : _NPAlgorithm_DTC::kLoadDone;
+    dtc->cleared   = 0;
+}
+
+// Runs the next stage of the build of engine g's program; returns true once
+// it is ready to play.
+static bool loadStep(_NPAlgorithm_DTC* dtc, AlgoSlot& s, const Engine& g) {
+    nt_shim::setSampleRate(s.renderRate);
+    switch (dtc->loadStage) {
+        case _NPAlgorithm_DTC::kLoadClear: {
+            // Some vendored algorithms leave members uninitialised; a zeroed
+            // arena makes every build start from the state of a fresh load,
+            // whatever ran in it before.
+            const uint32_t size = s.entry->sizeOf;
+            uint32_t n = size - dtc->cleared;
+            if (n > kClearSlice) n = kClearSlice;
+            std::memset(s.arena + dtc->cleared, 0, n);
+            dtc->cleared += n;
+            if (dtc->cleared >= size) dtc->loadStage = _NPAlgorithm_DTC::kLoadConstruct;
+            break;
+        }
+        case _NPAlgorithm_DTC::kLoadConstruct:
+            s.algo = s.entry->factory(s.arena);
+            dtc->loadStage = s.algo ? _NPAlgorithm_DTC::kLoadInit
+                                    : _NPAlgorithm_DTC::kLoadDone;
+            break;
+        case _NPAlgorithm_DTC::kLoadInit:
+            s.algo->init();
+            s.algo->process(g.kx, g.ky);
+            dtc->loadStage = _NPAlgorithm_DTC::kLoadPrime;
+            break;
+        case _NPAlgorithm_DTC::kLoadPrime:
+            s.algo->prime();
+            dtc->loadStage = _NPAlgorithm_DTC::kLoadDone;
+            break;
+        case _NPAlgorithm_DTC::kLoadDone:
+            break;
     }
-    dtc->entryGain = e->gain;
+    return dtc->loadStage == _NPAlgorithm_DTC::kLoadDone;
+}
+
+// Whether `s` runs at a different rate than the mode asks for.
+static bool renderRateStale(const _NPAlgorithm_DTC* dtc, const AlgoSlot& s) {
+    if (!s.entry || !s.entry->nativeRate) return false;
+    const float hostSR = (float)NT_globals.sampleRate;
+    const bool  native = dtc->nativeRequested && hostSR != 44100.0f;
+    return native != s.native || (native && s.renderRate != hostSR);
+}
+
+// Carves `size` bytes aligned to `align` off the front of a DRAM block.
+static inline uint8_t* carve(uintptr_t& p, size_t size, size_t align) {
+    p = (p + align - 1) & ~(uintptr_t)(align - 1);
+    uint8_t* block = reinterpret_cast<uint8_t*>(p);
+    p += size;
+    return block;
 }
 
 // =============================================================================
@@ -195,105 +337,276 @@ static void constructAlgo(_NPAlgorithm_DTC* dtc, uint8_t bank, uint8_t slot) {
 // =============================================================================
 
 static void calculateRequirements(_NT_algorithmRequirements& req,
-                                  const int32_t* /*specifications*/) {
-    req.numParameters = kNumParams;
+                                  const int32_t* specifications) {
+    const int slots = specifications[0] + 1;
+    req.numParameters = specifications[0] > 1 ? (int)kNumParamsDual : (int)kNumParams;
     req.sram          = sizeof(_NPAlgorithm);
-    // Algo arena lives in DRAM. Reserve enough headroom to align the base
-    // pointer up to the strictest algorithm alignment.
-    req.dram          = np_registry::kMaxAlgoSize + np_registry::kMaxAlgoAlign;
+    // An algo arena per engine plus the spare, the shared resampler kernels
+    // and one resampler per slot, each with headroom to align it (see
+    // construct()). Either engine may play the largest program, so every
+    // arena is full size; a second engine adds one arena, not two.
+    req.dram          = slots * (np_registry::kMaxAlgoSize + np_registry::kMaxAlgoAlign)
+                      + sizeof(PolyphaseKernels) + alignof(PolyphaseKernels)
+                      + slots * (sizeof(PolyphaseResampler) + alignof(PolyphaseResampler));
     req.dtc           = sizeof(_NPAlgorithm_DTC);
     req.itc           = 0;
 }
 
 static _NT_algorithm* construct(const _NT_algorithmMemoryPtrs& ptrs,
                                 const _NT_algorithmRequirements& /*req*/,
-                                const int32_t* /*specifications*/) {
-    nt_shim::setSampleRate((float)NT_globals.sampleRate);
-
+                                const int32_t* specifications) {
     auto* dtc = new (ptrs.dtc) _NPAlgorithm_DTC();
     auto* alg = new (ptrs.sram) _NPAlgorithm(dtc);
+    dtc->numEngines = (uint8_t)specifications[0];
+    dtc->spare      = dtc->numEngines;
 
-    // Carve the algo arena out of the DRAM block, aligned up to the strictest
-    // algorithm alignment. calculateRequirements() reserved kMaxAlgoSize +
-    // kMaxAlgoAlign bytes specifically so this round-up always fits.
-    {
-        uintptr_t raw   = reinterpret_cast<uintptr_t>(ptrs.dram);
-        uintptr_t align = (uintptr_t)np_registry::kMaxAlgoAlign;
-        uintptr_t aligned = (raw + align - 1) & ~(align - 1);
-        dtc->algoArena = reinterpret_cast<uint8_t*>(aligned);
+    // Carve the DRAM block in the order calculateRequirements() sized it.
+    uintptr_t p = reinterpret_cast<uintptr_t>(ptrs.dram);
+    for (int i = 0; i < dtc->numSlots(); ++i) {
+        dtc->slots[i].arena = carve(p, np_registry::kMaxAlgoSize, np_registry::kMaxAlgoAlign);
+    }
+    dtc->kernels = new (carve(p, sizeof(PolyphaseKernels), alignof(PolyphaseKernels)))
+        PolyphaseKernels();
+    dtc->kernels->init(44100.0f / (float)NT_globals.sampleRate);
+    for (int i = 0; i < dtc->numSlots(); ++i) {
+        AlgoSlot& s = dtc->slots[i];
+        s.resampler = new (carve(p, sizeof(PolyphaseResampler), alignof(PolyphaseResampler)))
+            PolyphaseResampler();
+        s.resampler->init(dtc->kernels);
     }
 
-    constructAlgo(dtc, kDefaultBank, kDefaultProgram);
+    // The default programs are built in one go; nothing is playing yet, and
+    // their first block renders in the first step().
+    for (int e = 0; e < dtc->numEngines; ++e) {
+        Engine& g = dtc->engines[e];
+        g.live = (uint8_t)e;
+        AlgoSlot& s = dtc->liveSlot(e);
+        beginLoad(dtc, s, kDefaultBank, kDefaultProgram);
+        while (dtc->loadStage < _NPAlgorithm_DTC::kLoadPrime) loadStep(dtc, s, g);
+        dtc->loadStage = _NPAlgorithm_DTC::kLoadDone;
+    }
 
     alg->parameters     = parameters;
-    alg->parameterPages = &parameterPages;
+    alg->parameterPages = dtc->numEngines > 1 ? &parameterPagesDual : &parameterPages;
     return alg;
 }
 
+// Queue a switch of engine g to (bank, slot); step() starts building it once
+// no other switch is running.
+static void requestSwitch(Engine& g, uint8_t bank, uint8_t slot) {
+    g.targetBank    = bank;
+    g.targetSlot    = slot;
+    g.switchPending = true;
+}
+
 static void parameterChanged(_NT_algorithm* self, int p) {
     auto* a   = static_cast<_NPAlgorithm*>(self);
     auto* dtc = a->dtc;
-    switch (p) {
-        case kParamX:    dtc->targetKx = a->v[p] * 0.0001f; break;
-        case kParamY:    dtc->targetKy = a->v[p] * 0.0001f; break;
-        case kParamGain: dtc->gain = a->v[p] * 0.001f; break;
+    // The second engine's parameters map onto the first one's indices, which
+    // leaves the shared ones where they are.
+    const int e    = (p >= kParamOut2) ? 1 : 0;
+    const int base = kEngineBase[e];
+    Engine& g = dtc->engines[e];
+    switch (p - base) {
+        case kParamX:    g.targetKx = a->v[p] * 0.0001f; break;
+        case kParamY:    g.targetKy = a->v[p] * 0.0001f; break;
+        case kParamGain: g.gain = a->v[p] * 0.001f; break;
+        case kParamQuality:
+            for (int i = 0; i < dtc->numSlots(); ++i) {
+                dtc->slots[i].resampler->setQuality((PolyphaseResampler::Quality)a->v[p]);
+            }
+            break;
         case kParamBank:
         case kParamProgram: {
-            uint8_t b = (uint8_t)a->v[kParamBank];
-            uint8_t s = (uint8_t)a->v[kParamProgram];
-            // Only react if it's actually a change vs what's currently
-            // constructed — avoids destruct/construct churn while the host
+            uint8_t b = (uint8_t)a->v[base + kParamBank];
+            uint8_t s = (uint8_t)a->v[base + kParamProgram];
+            // Only react if it's actually a change vs the program playing or
+            // on its way in — avoids destruct/construct churn while the host
             // initialises every parameter on load.
-            if (b != dtc->curBank || s != dtc->curSlot) {
-                dtc->targetBank    = b;
-                dtc->targetSlot    = s;
-                dtc->switchPending = true;
-                if (dtc->fadeState == _NPAlgorithm_DTC::kRunning) {
-                    dtc->fadeState   = _NPAlgorithm_DTC::kFadingOut;
-                    // Fade duration is in NT output frames, so use the host
-                    // sample rate (not the algo's fixed 44.1 kHz).
-                    dtc->fadeSamples = (int)(kFadeMs * 0.001f
-                                             * (float)NT_globals.sampleRate);
-                    if (dtc->fadeSamples < 4) dtc->fadeSamples = 4;
-                    dtc->fadePos     = 0;
-                }
+            const AlgoSlot& heading = dtc->isSwitching(e) ? dtc->spareSlot()
+                                                          : dtc->liveSlot(e);
+            if (g.switchPending || b != heading.bank || s != heading.slot) {
+                requestSwitch(g, b, s);
             }
             break;
         }
+        case kParamRenderRate:
+            dtc->nativeRequested = a->v[p] != 0;
+            // Coefficients are computed against the rate at init(), so a
+            // mode change rebuilds the programs (through the crossfade). A
+            // pending switch picks the mode up by itself; step() catches a
+            // change that lands during one.
+            for (int k = 0; k < dtc->numEngines; ++k) {
+                Engine& h = dtc->engines[k];
+                AlgoSlot& live = dtc->liveSlot(k);
+                if (!h.switchPending && !dtc->isSwitching(k) && renderRateStale(dtc, live)) {
+                    requestSwitch(h, live.bank, live.slot);
+                }
+            }
+            break;
         default: break;
     }
 }
 
-// One-sample render from the active algorithm; returns 0 when no algo is
-// constructed (empty bank/slot).
-static inline float pullSample(_NPAlgorithm_DTC* dtc) {
-    if (!dtc->algo) return 0.0f;
-    return dtc->algo->processGraph();
+static inline float sampleOf(int16_t s) { return int16_to_float_1v(s); }
+static inline float sampleOf(float s)   { return s; }
+
+// Converts and gains n samples (the algorithm's int16 block, or the
+// resampler's output) onto the bus, shaped by a per-frame envelope when kEnv.
+template <bool kReplace, bool kEnv, typename T>
+static inline void writeSpan(float* out, const T* src, int n,
+                             float gain, const float* env) {
+    for (int k = 0; k < n; ++k) {
+        float s = sampleOf(src[k]) * gain;
+        if (kEnv) s *= env[k];
+        if (kReplace) out[k] = s;
+        else          out[k] += s;
+    }
 }
 
-// Resampling pull: advances the 44.1 kHz source by `ratio` per output frame
-// and returns a linearly-interpolated sample. Used when the NT host runs at
-// a sample rate other than 44.1 kHz. `ratio = 44100 / hostRate`.
-static inline float pullSampleResampled(_NPAlgorithm_DTC* dtc, float ratio) {
-    if (!dtc->algo) {
+template <bool kReplace, bool kEnv>
+static void renderSlot(AlgoSlot& s, float* out, int n, float gain,
+                       const float* env, bool resample) {
+    if (!s.algo) {
         // Keep state consistent so a re-enabled algo doesn't pop.
-        dtc->resampleInited = false;
-        return 0.0f;
+        s.resampler->reset();
+        if (kReplace) std::memset(out, 0, sizeof(float) * n);
+        return;
+    }
+    if (resample) {
+        float buf[PolyphaseResampler::kMaxSpan];
+        for (int k = 0; k < n; k += PolyphaseResampler::kMaxSpan) {
+            const int m = (n - k < PolyphaseResampler::kMaxSpan)
+                        ? n - k : PolyphaseResampler::kMaxSpan;
+            s.resampler->render(s.algo, buf, m);
+            writeSpan<kReplace, kEnv>(out + k, buf, m, gain, kEnv ? env + k : env);
+        }
+        return;
     }
-    if (!dtc->resampleInited) {
-        dtc->resamplePrev   = dtc->algo->processGraph();
-        dtc->resampleCurr   = dtc->algo->processGraph();
-        dtc->resamplePhase  = 0.0f;
-        dtc->resampleInited = true;
+    // Native rate: take the algorithm's int16 block a span at a time.
+    int k = 0;
+    while (k < n) {
+        const int16_t* src;
+        const int m = s.algo->pullSpan(&src, n - k);
+        writeSpan<kReplace, kEnv>(out + k, src, m, gain, kEnv ? env + k : env);
+        k += m;
     }
-    dtc->resamplePhase += ratio;
-    while (dtc->resamplePhase >= 1.0f) {
-        dtc->resamplePhase -= 1.0f;
-        dtc->resamplePrev = dtc->resampleCurr;
-        dtc->resampleCurr = dtc->algo->processGraph();
+}
+
+// Renders n frames of `s` onto the bus, with its per-program trim. `env` is
+// null outside a crossfade.
+static inline void renderSlot(AlgoSlot& s, float* out, int n, float gain,
+                              bool replace, const float* env, bool rateDiffers) {
+    const bool resample = rateDiffers && !s.native;
+    gain *= s.entryGain;
+    if (env) {
+        if (replace) renderSlot<true, true>(s, out, n, gain, env, resample);
+        else         renderSlot<false, true>(s, out, n, gain, env, resample);
+    } else {
+        if (replace) renderSlot<true, false>(s, out, n, gain, env, resample);
+        else         renderSlot<false, false>(s, out, n, gain, env, resample);
+    }
+}
+
+// Equal-power crossfade gains for frames pos..pos+n-1 of a len-frame fade:
+// cos/sin of a quarter turn, stepped by rotation from one sincosf per chunk.
+static void crossfadeGains(float* out, float* in, int pos, int len, int n) {
+    const float step = 1.5707963f / (float)len;
+    const float dc = std::cos(step);
+    const float ds = std::sin(step);
+    float c = std::cos(step * (float)pos);
+    float s = std::sin(step * (float)pos);
+    for (int k = 0; k < n; ++k) {
+        out[k] = c;
+        in[k]  = s;
+        const float c1 = c * dc - s * ds;
+        s = s * dc + c * ds;
+        c = c1;
+    }
+}
+
+// Advances the program-change state machine by one block: starts building a
+// pending program, runs one build stage, or starts the crossfade. Between
+// switches the first engine with one pending is served; the other waits.
+static void advanceSwitch(_NPAlgorithm_DTC* dtc) {
+    if (dtc->switchState == _NPAlgorithm_DTC::kCrossfading) return;
+    if (dtc->switchState == _NPAlgorithm_DTC::kRunning) {
+        int e = 0;
+        while (e < dtc->numEngines && !dtc->engines[e].switchPending) ++e;
+        if (e == dtc->numEngines) return;
+        dtc->switching = (uint8_t)e;
+    }
+    Engine& g = dtc->engines[dtc->switching];
+    if (g.switchPending) {
+        g.switchPending = false;
+        AlgoSlot& live = dtc->slots[g.live];
+        if (dtc->switchState == _NPAlgorithm_DTC::kLoading) {
+            // Retargeted mid-build: drop the half-built program.
+            destructAlgo(dtc->spareSlot());
+            dtc->switchState = _NPAlgorithm_DTC::kRunning;
+        }
+        if (g.targetBank == live.bank && g.targetSlot == live.slot
+            && !renderRateStale(dtc, live)) {
+            return;          // back to what is already playing
+        }
+        beginLoad(dtc, dtc->spareSlot(), g.targetBank, g.targetSlot);
+        dtc->switchState = _NPAlgorithm_DTC::kLoading;
+    }
+    if (dtc->switchState != _NPAlgorithm_DTC::kLoading) return;
+    if (!loadStep(dtc, dtc->spareSlot(), g)) return;
+
+    dtc->switchState = _NPAlgorithm_DTC::kCrossfading;
+    // Fade duration is in NT output frames, so use the host sample rate
+    // (not the algo's fixed 44.1 kHz).
+    dtc->fadeSamples = (int)(kFadeMs * 0.001f * (float)NT_globals.sampleRate);
+    if (dtc->fadeSamples < 4) dtc->fadeSamples = 4;
+    dtc->fadePos     = 0;
+}
+
+// The incoming program has faded in: it becomes live and the outgoing one
+// is destroyed, its slot becoming the spare.
+static void finishSwitch(_NPAlgorithm_DTC* dtc) {
+    Engine& g = dtc->engines[dtc->switching];
+    destructAlgo(dtc->slots[g.live]);
+    const uint8_t outgoing = g.live;
+    g.live     = dtc->spare;
+    dtc->spare = outgoing;
+    dtc->switchState = _NPAlgorithm_DTC::kRunning;
+}
+
+// Renders engine e onto its output bus. During its crossfade both programs
+// render a chunk at a time under their gain envelopes; the incoming one
+// takes over when it completes, which may be mid-block.
+static void renderEngine(_NPAlgorithm* a, int e, float* busFrames, int numFrames,
+                         bool rateDiffers) {
+    auto* dtc = a->dtc;
+    const int   base    = kEngineBase[e];
+    const int   outBus  = a->v[base + kParamOut];
+    const bool  replace = a->v[base + kParamOutMode] != 0;
+
+    if (outBus < 1) return;
+    float* out = busFrames + (outBus - 1) * numFrames;
+    const float gain = dtc->engines[e].gain;
+
+    int i = 0;
+    while (i < numFrames && dtc->isSwitching(e)
+           && dtc->switchState == _NPAlgorithm_DTC::kCrossfading) {
+        float gOut[PolyphaseResampler::kMaxSpan];
+        float gIn[PolyphaseResampler::kMaxSpan];
+        int n = numFrames - i;
+        if (n > PolyphaseResampler::kMaxSpan) n = PolyphaseResampler::kMaxSpan;
+        if (n > dtc->fadeSamples - dtc->fadePos) n = dtc->fadeSamples - dtc->fadePos;
+        crossfadeGains(gOut, gIn, dtc->fadePos, dtc->fadeSamples, n);
+        renderSlot(dtc->liveSlot(e), out + i, n, gain, replace, gOut, rateDiffers);
+        renderSlot(dtc->spareSlot(), out + i, n, gain, false, gIn, rateDiffers);
+        dtc->fadePos += n;
+        i += n;
+        if (dtc->fadePos >= dtc->fadeSamples) finishSwitch(dtc);
+    }
+    if (i < numFrames) {
+        renderSlot(dtc->liveSlot(e), out + i, numFrames - i, gain, replace,
+                   nullptr, rateDiffers);
     }
-    return dtc->resamplePrev
-         + (dtc->resampleCurr - dtc->resamplePrev) * dtc->resamplePhase;
 }
 
 static void step(_NT_algorithm* self, float* busFrames, int numFramesBy4) {
@@ -312,67 +625,57 @@ static void step(_NT_algorithm* self, float* busFrames, int numFramesBy4) {
     const float alpha = (smoothSamples > 1.0f)
                       ? (float)numFrames / ((float)numFrames + smoothSamples)
                       : 1.0f;
-    dtc->kx += (dtc->targetKx - dtc->kx) * alpha;
-    dtc->ky += (dtc->targetKy - dtc->ky) * alpha;
-
-    // Push current X/Y to the algo (cheap; algos cache derived values).
-    if (dtc->algo) dtc->algo->process(dtc->kx, dtc->ky);
-    const int   outBus    = a->v[kParamOut];
-    const bool  replace   = a->v[kParamOutMode] != 0;
-    const float baseGain  = dtc->gain * dtc->entryGain;
-
-    if (outBus < 1) return;
-    float* out = busFrames + (outBus - 1) * numFrames;
+    for (int e = 0; e < dtc->numEngines; ++e) {
+        Engine& g = dtc->engines[e];
+        g.kx += (g.targetKx - g.kx) * alpha;
+        g.ky += (g.targetKy - g.ky) * alpha;
+
+        // A host rate change rebuilds a native program.
+        AlgoSlot& live = dtc->liveSlot(e);
+        if (!g.switchPending && !dtc->isSwitching(e) && renderRateStale(dtc, live)) {
+            requestSwitch(g, live.bank, live.slot);
+        }
+    }
+    advanceSwitch(dtc);
+
+    // Push current X/Y to the algos (cheap; algos cache derived values). The
+    // shim's rate is shared by every slot and instance: claim it for each
+    // algorithm before calling into it.
+    const bool fading = dtc->switchState == _NPAlgorithm_DTC::kCrossfading;
+    for (int e = 0; e < dtc->numEngines; ++e) {
+        const Engine& g = dtc->engines[e];
+        const bool both = fading && dtc->switching == e;
+        for (int k = 0; k < (both ? 2 : 1); ++k) {
+            AlgoSlot& s = k ? dtc->spareSlot() : dtc->liveSlot(e);
+            nt_shim::setSampleRate(s.renderRate);
+            if (s.algo) s.algo->process(g.kx, g.ky);
+        }
+    }
 
     // Resampling ratio: how many 44.1 kHz source samples advance per host
-    // output frame. When the host already runs at 44.1 kHz we bypass the
-    // resampler entirely (hot path is one pullSample per output frame).
+    // output frame. When the host already runs at 44.1 kHz, or the algo
+    // renders at the host rate, we bypass the resampler entirely (hot path is
+    // pullSpan() over whole int16 runs).
     const float ratio = 44100.0f / hostSR;
-    const bool  resample = (ratio < 0.9999f) || (ratio > 1.0001f);
-
-    for (int i = 0; i < numFrames; ++i) {
-        // Crossfade envelope: 1.0 in kRunning, ramp 1->0 in kFadingOut,
-        // ramp 0->1 in kFadingIn, then back to kRunning.
-        float fade = 1.0f;
-        switch (dtc->fadeState) {
-            case _NPAlgorithm_DTC::kRunning:
-                break;
-            case _NPAlgorithm_DTC::kFadingOut: {
-                fade = 1.0f - (float)dtc->fadePos / (float)dtc->fadeSamples;
-                if (++dtc->fadePos >= dtc->fadeSamples) {
-                    // Switch happens here: synchronous destruct + construct
-                    // + init() of the new algo.
-                    if (dtc->switchPending) {
-                        constructAlgo(dtc, dtc->targetBank, dtc->targetSlot);
-                        dtc->switchPending = false;
-                    }
-                    dtc->fadeState = _NPAlgorithm_DTC::kFadingIn;
-                    dtc->fadePos   = 0;
-                }
-                break;
-            }
-            case _NPAlgorithm_DTC::kFadingIn: {
-                fade = (float)dtc->fadePos / (float)dtc->fadeSamples;
-                if (++dtc->fadePos >= dtc->fadeSamples) {
-                    dtc->fadeState = _NPAlgorithm_DTC::kRunning;
-                }
-                break;
-            }
-        }
+    const bool  rateDiffers = (ratio < 0.9999f) || (ratio > 1.0001f);
+    if (ratio != dtc->kernels->ratio()) {
+        // The tables were built in construct(); a host below 44.1 kHz keeps
+        // their cutoff until the algorithm is rebuilt.
+        dtc->kernels->retune(ratio);
+        for (int i = 0; i < dtc->numSlots(); ++i) dtc->slots[i].resampler->reset();
+    }
 
-        const float raw = resample ? pullSampleResampled(dtc, ratio)
-                                   : pullSample(dtc);
-        const float s = raw * baseGain * fade;
-        if (replace) out[i] = s;
-        else         out[i] += s;
+    for (int e = 0; e < dtc->numEngines; ++e) {
+        renderEngine(a, e, busFrames, numFrames, rateDiffers);
     }
 }
 
 // Bank/Program parameter strings: shows the algorithm name (or "--" for
 // empty slots) so the user sees what's loaded without having to memorise
-// the layout.
+// the layout, followed by its CPU mark: nothing for a low-cost program, "+"
+// for mid and "++" for high (np_registry::Cost).
 static int parameterString(_NT_algorithm* self, int p, int v, char* buff) {
-    if (p == kParamBank) {
+    if (p == kParamBank || p == kParamBank2) {
         static const char* const names[] = { "Bank 1", "Bank 2", "Bank 3", "Bank 4" };
         if (v < 1 || v > 4) return 0;
         const char* s = names[v - 1];
@@ -380,16 +683,19 @@ static int parameterString(_NT_algorithm* self, int p, int v, char* buff) {
         std::memcpy(buff, s, n + 1);
         return (int)n;
     }
-    if (p == kParamProgram) {
+    if (p == kParamProgram || p == kParamProgram2) {
         auto* a = static_cast<_NPAlgorithm*>(self);
-        uint8_t b = (uint8_t)a->v[kParamBank];
+        uint8_t b = (uint8_t)a->v[p - kParamProgram + kParamBank];
         const auto* e = np_registry::find(b, (uint8_t)v);
+        static const char* const marks[] = { "", " +", " ++" };
         const char* s = e ? e->name : "--";
+        const char* m = e ? marks[e->cost] : "";
         size_t n = std::strlen(s);
-        if (n >= kNT_parameterStringSize) n = kNT_parameterStringSize - 1;
+        size_t k = std::strlen(m);
+        if (n + k >= kNT_parameterStringSize) n = kNT_parameterStringSize - 1 - k;
         std::memcpy(buff, s, n);
-        buff[n] = '\0';
-        return (int)n;
+        std::memcpy(buff + n, m, k + 1);
+        return (int)(n + k);
     }
     return 0;
 }
@@ -402,8 +708,8 @@ static const _NT_factory factory = {
     .guid                        = NT_MULTICHAR('N','B','q','t'),
     .name                        = "Noise Bouquet",
     .description                 = "Disting NT port of Befaco's Noise Plethora (VCV Rack edition)",
-    .numSpecifications           = 0,
-    .specifications              = nullptr,
+    .numSpecifications           = ARRAY_SIZE(specs),
+    .specifications              = specs,
     .calculateStaticRequirements = nullptr,
     .initialise                  = nullptr,
     .calculateRequirements       = calculateRequirements,
@@ -11,6 +11,8 @@
 //     in PluginRegistry.hpp via a constexpr table.
 //   - Same sample-pull processGraph() pattern: each call returns one float in
 //     [-1, +1], refilling the 128-sample int16 ring buffer on demand.
+//   - pullSpan() hands out the same int16 stream a span at a time, so step()
+//     can convert whole runs straight onto the bus.
 //
 // Vendored P_*.hpp files compile against this header unchanged.
 // =============================================================================
@@ -41,6 +43,31 @@ public:
         return int16_to_float_1v(blockBuffer.shift());
     }
 
+    // Block pull: points *span at the next samples of the int16 block,
+    // refilling it from processGraphAsBlock() once it is used up, and returns
+    // how many there are (1..maxFrames, fewer at the end of the block).
+    // Shares its read position with processGraph(); convert the samples with
+    // int16_to_float_1v().
+    int pullSpan(const int16_t** span, int maxFrames) {
+        if (blockBuffer.empty()) {
+            processGraphAsBlock(blockBuffer);
+        }
+        int n = (int)blockBuffer.contiguous();
+        if (n > maxFrames) n = maxFrames;
+        *span = blockBuffer.front();
+        blockBuffer.consume(n);
+        return n;
+    }
+
+    // Renders the first block ahead of the first pull, so a program built in
+    // stages over several audio blocks (see NoiseBouquet.cpp) does not pay
+    // for it in the block that starts playing it.
+    void prime() {
+        if (blockBuffer.empty()) {
+            processGraphAsBlock(blockBuffer);
+        }
+    }
+
     // Optional: VCV used these to wire stream graphs. The NT port doesn't
     // call them, but we keep them pure-virtual so vendored P_*.hpp algorithms
     // (which all `override` both) compile without edits.
@@ -29,28 +29,16 @@ public:
 	TriFMcluster& operator=(const TriFMcluster&) = delete;
 
 	void init() override {
-		mixer1.gain(0, 1);
-		mixer1.gain(1, 1);
-		mixer1.gain(2, 1);
-		mixer1.gain(3, 1);
-		mixer2.gain(0, 1);
-		mixer2.gain(1, 1);
-		mixer2.gain(2, 1);
-		mixer2.gain(3, 1);
-		mixer5.gain(0, 1);
-		mixer5.gain(1, 1);
-		mixer5.gain(2, 1);
-		mixer5.gain(3, 1);
-
 		int masterWaveform = WAVEFORM_TRIANGLE;
 		float masterVolume = 0.25;
 
-		waveform1.begin(masterVolume, 794, masterWaveform);
-		waveform2.begin(masterVolume, 647, masterWaveform);
-		waveform3.begin(masterVolume, 524, masterWaveform);
-		waveform4.begin(masterVolume, 444, masterWaveform);
-		waveform5.begin(masterVolume, 368, masterWaveform);
-		waveform6.begin(masterVolume, 283, masterWaveform);
+		waveforms.begin(masterVolume, masterWaveform);
+		waveforms.frequency(0, 794);
+		waveforms.frequency(1, 647);
+		waveforms.frequency(2, 524);
+		waveforms.frequency(3, 444);
+		waveforms.frequency(4, 368);
+		waveforms.frequency(5, 283);
 
 		modulator1.begin(1, 1000, WAVEFORM_SINE);
 		modulator2.begin(1, 1000, WAVEFORM_SINE);
@@ -91,12 +79,12 @@ public:
 		modulator6.frequency(f6 * indexFreq);
 
 
-		waveform1.frequency(f1);
-		waveform2.frequency(f2);
-		waveform3.frequency(f3);
-		waveform4.frequency(f4);
-		waveform5.frequency(f5);
-		waveform6.frequency(f6);
+		waveforms.frequency(0, f1);
+		waveforms.frequency(1, f2);
+		waveforms.frequency(2, f3);
+		waveforms.frequency(3, f4);
+		waveforms.frequency(4, f5);
+		waveforms.frequency(5, f6);
 	}
 
 	void processGraphAsBlock(TeensyBuffer& blockBuffer) override {
@@ -109,29 +97,22 @@ public:
 		modulator6.update(&waveformOut[5]);
 
 		// FM for the 6 oscillators from modulators
-		waveform1.update(&waveformOut[0], nullptr, &waveformModOut[0]);
-		waveform2.update(&waveformOut[1], nullptr, &waveformModOut[1]);
-		waveform3.update(&waveformOut[2], nullptr, &waveformModOut[2]);
-		waveform4.update(&waveformOut[3], nullptr, &waveformModOut[3]);
-		waveform5.update(&waveformOut[4], nullptr, &waveformModOut[4]);
-		waveform6.update(&waveformOut[5], nullptr, &waveformModOut[5]);
-
-		mixer1.update(&waveformModOut[0], &waveformModOut[1], &waveformModOut[2], &waveformModOut[3], &mixerOut[0]);
-		mixer2.update(&waveformModOut[4], &waveformModOut[5], nullptr, nullptr, &mixerOut[1]);
-		mixer5.update(&mixerOut[0], &mixerOut[1], nullptr, nullptr, &mixerOut[2]);
-
-		blockBuffer.pushBuffer(mixerOut[2].data, AUDIO_BLOCK_SAMPLES);
+		waveforms.updateEach(waveformOut, nullptr, &mixerOut);
+
+		blockBuffer.pushBuffer(mixerOut.data, AUDIO_BLOCK_SAMPLES);
 	}
 
 	AudioStream& getStream() override {
-		return mixer5;
+		return waveforms;
 	}
 	unsigned char getPort() override {
 		return 0;
 	}
 
 private:
-	audio_block_t waveformOut[6] = {}, waveformModOut[6] = {}, mixerOut[3] = {};
+	audio_block_t waveformOut[6] = {}, mixerOut = {};
+
+	AudioSynthWaveformBank<6> waveforms;
 
 	AudioSynthWaveform       modulator1;      //xy=236.88888549804688,262.55556869506836
 	AudioSynthWaveform       modulator3; //xy=238.88890075683594,366.555606842041
@@ -139,15 +120,6 @@ private:
 	AudioSynthWaveform       modulator5; //xy=239.88890075683594,485.5555810928345
 	AudioSynthWaveform       modulator4; //xy=240.88890075683594,428.55560970306396
 	AudioSynthWaveform       modulator6; //xy=242.8888931274414,541.5555143356323
-	AudioSynthWaveformModulated waveform1;      //xy=459.88890075683594,268.6667013168335
-	AudioSynthWaveformModulated waveform4;      //xy=459.8888854980469,433.6666889190674
-	AudioSynthWaveformModulated waveform2;      //xy=461.88890838623047,322.66671657562256
-	AudioSynthWaveformModulated waveform3;      //xy=461.8888854980469,373.6666889190674
-	AudioSynthWaveformModulated waveform6;      //xy=461.88890838623047,546.6666688919067
-	AudioSynthWaveformModulated waveform5;      //xy=462.88888931274414,492.66670417785645
-	AudioMixer4              mixer2;         //xy=663.8888053894043,520.6666412353516
-	AudioMixer4              mixer1;         //xy=667.888916015625,349.6667251586914
-	AudioMixer4              mixer5;         //xy=853.8889122009277,448.6667900085449
 	// AudioConnection          patchCord1;
 	// AudioConnection          patchCord2;
 	// AudioConnection          patchCord3;
@@ -10,13 +10,16 @@
 //   - factory(arena)   (placement-new the algorithm into an externally
 //                       supplied arena; returns the base pointer)
 //   - destroy(p)       (in-place ~T())
-//   - sizeOf           (sizeof(T) — used to size the shared algo arena)
+//   - sizeOf           (sizeof(T) — every algo arena fits the largest)
 //   - alignOf          (alignof(T))
 //   - gain             (per-program output trim from Banks_Def.hpp)
+//   - nativeRate       (renders correctly at the host rate; see below)
+//   - cost             (CPU class from tools/ProgramProfile.cpp)
 //
-// All algorithms live in a single arena sized to the largest entry; the host
-// destructs the previous algo and placement-news the new one when Bank or
-// Program changes.
+// Every arena is sized to the largest entry: one per engine plus a spare.
+// On a Bank or Program change the host destructs the spare's previous algo,
+// placement-news the new one into it and crossfades to it; the engine's old
+// arena becomes the spare.
 // =============================================================================
 #pragma once
 
@@ -78,6 +81,11 @@ void unmake(NoisePlethoraPlugin* p) {
     (void)p;
 }
 
+// Rough CPU cost of a program per block, for planning and for the CPU mark
+// next to the program name. Measured on the host by tools/ProgramProfile.cpp
+// relative to WhiteNoise: low under 6x, mid under 10x, high above.
+enum Cost : uint8_t { kCostLow, kCostMid, kCostHigh };
+
 struct Entry {
     uint8_t        bank;     // 1..4
     uint8_t        slot;     // 1..10 (Bank 4 has only 1..3 valid)
@@ -87,6 +95,14 @@ struct Entry {
     uint16_t       sizeOf;
     uint16_t       alignOf;
     float          gain;     // per-program output trim
+    // True when every rate-dependent setting of the algorithm goes through
+    // APP->engine->getSampleRate() (phase increments, filter coefficients,
+    // times in ms), so it can render at the host rate with no resampler.
+    // False when it depends on lengths in samples tuned for 44.1 kHz:
+    // freeverb's comb and allpass lines, the flange delay line, and the
+    // granular buffer (a 150 ms freeze no longer fits at 96 kHz).
+    bool           nativeRate;
+    Cost           cost;
 };
 
 // One entry per implemented algorithm. Banks/slots not present here are
@@ -94,77 +110,77 @@ struct Entry {
 inline constexpr Entry kEntries[] = {
         // -- Bank 1: heavy effects and ring-mod --
         { 1, 1, "radioOhNo", &make<radioOhNo>, &unmake<radioOhNo>,
-            (uint16_t)sizeof(radioOhNo), (uint16_t)alignof(radioOhNo), 1.0f },
+            (uint16_t)sizeof(radioOhNo), (uint16_t)alignof(radioOhNo), 1.0f, true, kCostLow },
         { 1, 2, "Rwalk_SineFMFlange", &make<Rwalk_SineFMFlange>, &unmake<Rwalk_SineFMFlange>,
-            (uint16_t)sizeof(Rwalk_SineFMFlange), (uint16_t)alignof(Rwalk_SineFMFlange), 1.0f },
+            (uint16_t)sizeof(Rwalk_SineFMFlange), (uint16_t)alignof(Rwalk_SineFMFlange), 1.0f, false, kCostMid },
         { 1, 3, "xModRingSqr", &make<xModRingSqr>, &unmake<xModRingSqr>,
-            (uint16_t)sizeof(xModRingSqr), (uint16_t)alignof(xModRingSqr), 1.0f },
+            (uint16_t)sizeof(xModRingSqr), (uint16_t)alignof(xModRingSqr), 1.0f, true, kCostLow },
         { 1, 4, "XModRingSine", &make<XModRingSine>, &unmake<XModRingSine>,
-            (uint16_t)sizeof(XModRingSine), (uint16_t)alignof(XModRingSine), 1.0f },
+            (uint16_t)sizeof(XModRingSine), (uint16_t)alignof(XModRingSine), 1.0f, true, kCostLow },
         { 1, 5, "CrossModRing", &make<CrossModRing>, &unmake<CrossModRing>,
-            (uint16_t)sizeof(CrossModRing), (uint16_t)alignof(CrossModRing), 1.0f },
+            (uint16_t)sizeof(CrossModRing), (uint16_t)alignof(CrossModRing), 1.0f, true, kCostLow },
         { 1, 6, "resonoise", &make<resonoise>, &unmake<resonoise>,
-            (uint16_t)sizeof(resonoise), (uint16_t)alignof(resonoise), 1.0f },
+            (uint16_t)sizeof(resonoise), (uint16_t)alignof(resonoise), 1.0f, true, kCostMid },
         { 1, 7, "grainGlitch", &make<grainGlitch>, &unmake<grainGlitch>,
-            (uint16_t)sizeof(grainGlitch), (uint16_t)alignof(grainGlitch), 1.0f },
+            (uint16_t)sizeof(grainGlitch), (uint16_t)alignof(grainGlitch), 1.0f, false, kCostLow },
         { 1, 8, "grainGlitchII", &make<grainGlitchII>, &unmake<grainGlitchII>,
-            (uint16_t)sizeof(grainGlitchII), (uint16_t)alignof(grainGlitchII), 1.0f },
+            (uint16_t)sizeof(grainGlitchII), (uint16_t)alignof(grainGlitchII), 1.0f, false, kCostLow },
         { 1, 9, "grainGlitchIII", &make<grainGlitchIII>, &unmake<grainGlitchIII>,
-            (uint16_t)sizeof(grainGlitchIII), (uint16_t)alignof(grainGlitchIII), 1.0f },
+            (uint16_t)sizeof(grainGlitchIII), (uint16_t)alignof(grainGlitchIII), 1.0f, false, kCostLow },
         { 1, 10, "basurilla", &make<basurilla>, &unmake<basurilla>,
-            (uint16_t)sizeof(basurilla), (uint16_t)alignof(basurilla), 1.0f },
+            (uint16_t)sizeof(basurilla), (uint16_t)alignof(basurilla), 1.0f, true, kCostLow },
 
         // -- Bank 2: cluster synthesis --
         { 2, 1, "clusterSaw", &make<clusterSaw>, &unmake<clusterSaw>,
-            (uint16_t)sizeof(clusterSaw), (uint16_t)alignof(clusterSaw), 1.0f },
+            (uint16_t)sizeof(clusterSaw), (uint16_t)alignof(clusterSaw), 1.0f, true, kCostMid },
         { 2, 2, "pwCluster", &make<pwCluster>, &unmake<pwCluster>,
-            (uint16_t)sizeof(pwCluster), (uint16_t)alignof(pwCluster), 1.0f },
+            (uint16_t)sizeof(pwCluster), (uint16_t)alignof(pwCluster), 1.0f, true, kCostLow },
         { 2, 3, "crCluster2", &make<crCluster2>, &unmake<crCluster2>,
-            (uint16_t)sizeof(crCluster2), (uint16_t)alignof(crCluster2), 1.0f },
+            (uint16_t)sizeof(crCluster2), (uint16_t)alignof(crCluster2), 1.0f, true, kCostHigh },
         { 2, 4, "sineFMcluster", &make<sineFMcluster>, &unmake<sineFMcluster>,
-            (uint16_t)sizeof(sineFMcluster), (uint16_t)alignof(sineFMcluster), 1.0f },
+            (uint16_t)sizeof(sineFMcluster), (uint16_t)alignof(sineFMcluster), 1.0f, true, kCostHigh },
         { 2, 5, "TriFMcluster", &make<TriFMcluster>, &unmake<TriFMcluster>,
-            (uint16_t)sizeof(TriFMcluster), (uint16_t)alignof(TriFMcluster), 1.0f },
+            (uint16_t)sizeof(TriFMcluster), (uint16_t)alignof(TriFMcluster), 1.0f, true, kCostHigh },
         { 2, 6, "PrimeCluster", &make<PrimeCluster>, &unmake<PrimeCluster>,
-            (uint16_t)sizeof(PrimeCluster), (uint16_t)alignof(PrimeCluster), 0.8f },
+            (uint16_t)sizeof(PrimeCluster), (uint16_t)alignof(PrimeCluster), 0.8f, true, kCostHigh },
         { 2, 7, "PrimeCnoise", &make<PrimeCnoise>, &unmake<PrimeCnoise>,
-            (uint16_t)sizeof(PrimeCnoise), (uint16_t)alignof(PrimeCnoise), 0.8f },
+            (uint16_t)sizeof(PrimeCnoise), (uint16_t)alignof(PrimeCnoise), 0.8f, true, kCostHigh },
         { 2, 8, "FibonacciCluster", &make<FibonacciCluster>, &unmake<FibonacciCluster>,
-            (uint16_t)sizeof(FibonacciCluster), (uint16_t)alignof(FibonacciCluster), 1.0f },
+            (uint16_t)sizeof(FibonacciCluster), (uint16_t)alignof(FibonacciCluster), 1.0f, true, kCostHigh },
         { 2, 9, "partialCluster", &make<partialCluster>, &unmake<partialCluster>,
-            (uint16_t)sizeof(partialCluster), (uint16_t)alignof(partialCluster), 1.0f },
+            (uint16_t)sizeof(partialCluster), (uint16_t)alignof(partialCluster), 1.0f, true, kCostHigh },
         { 2, 10, "phasingCluster", &make<phasingCluster>, &unmake<phasingCluster>,
-            (uint16_t)sizeof(phasingCluster), (uint16_t)alignof(phasingCluster), 1.0f },
+            (uint16_t)sizeof(phasingCluster), (uint16_t)alignof(phasingCluster), 1.0f, true, kCostHigh },
 
         // -- Bank 3: effects-using algorithms --
         { 3, 1, "BasuraTotal", &make<BasuraTotal>, &unmake<BasuraTotal>,
-            (uint16_t)sizeof(BasuraTotal), (uint16_t)alignof(BasuraTotal), 1.0f },
+            (uint16_t)sizeof(BasuraTotal), (uint16_t)alignof(BasuraTotal), 1.0f, false, kCostHigh },
         { 3, 2, "Atari", &make<Atari>, &unmake<Atari>,
-            (uint16_t)sizeof(Atari), (uint16_t)alignof(Atari), 1.0f },
+            (uint16_t)sizeof(Atari), (uint16_t)alignof(Atari), 1.0f, true, kCostLow },
         { 3, 3, "WalkingFilomena", &make<WalkingFilomena>, &unmake<WalkingFilomena>,
-            (uint16_t)sizeof(WalkingFilomena), (uint16_t)alignof(WalkingFilomena), 1.0f },
+            (uint16_t)sizeof(WalkingFilomena), (uint16_t)alignof(WalkingFilomena), 1.0f, true, kCostMid },
         { 3, 4, "S_H", &make<S_H>, &unmake<S_H>,
-            (uint16_t)sizeof(S_H), (uint16_t)alignof(S_H), 1.0f },
+            (uint16_t)sizeof(S_H), (uint16_t)alignof(S_H), 1.0f, false, kCostHigh },
         { 3, 5, "arrayOnTheRocks", &make<arrayOnTheRocks>, &unmake<arrayOnTheRocks>,
-            (uint16_t)sizeof(arrayOnTheRocks), (uint16_t)alignof(arrayOnTheRocks), 1.0f },
+            (uint16_t)sizeof(arrayOnTheRocks), (uint16_t)alignof(arrayOnTheRocks), 1.0f, true, kCostLow },
         { 3, 6, "existencelsPain", &make<existencelsPain>, &unmake<existencelsPain>,
-            (uint16_t)sizeof(existencelsPain), (uint16_t)alignof(existencelsPain), 1.0f },
+            (uint16_t)sizeof(existencelsPain), (uint16_t)alignof(existencelsPain), 1.0f, true, kCostHigh },
         { 3, 7, "whoKnows", &make<whoKnows>, &unmake<whoKnows>,
-            (uint16_t)sizeof(whoKnows), (uint16_t)alignof(whoKnows), 1.0f },
+            (uint16_t)sizeof(whoKnows), (uint16_t)alignof(whoKnows), 1.0f, true, kCostHigh },
         { 3, 8, "satanWorkout", &make<satanWorkout>, &unmake<satanWorkout>,
-            (uint16_t)sizeof(satanWorkout), (uint16_t)alignof(satanWorkout), 1.0f },
+            (uint16_t)sizeof(satanWorkout), (uint16_t)alignof(satanWorkout), 1.0f, false, kCostHigh },
         { 3, 9, "Rwalk_BitCrushPW", &make<Rwalk_BitCrushPW>, &unmake<Rwalk_BitCrushPW>,
-            (uint16_t)sizeof(Rwalk_BitCrushPW), (uint16_t)alignof(Rwalk_BitCrushPW), 1.0f },
+            (uint16_t)sizeof(Rwalk_BitCrushPW), (uint16_t)alignof(Rwalk_BitCrushPW), 1.0f, false, kCostHigh },
         { 3, 10, "Rwalk_LFree", &make<Rwalk_LFree>, &unmake<Rwalk_LFree>,
-            (uint16_t)sizeof(Rwalk_LFree), (uint16_t)alignof(Rwalk_LFree), 1.0f },
+            (uint16_t)sizeof(Rwalk_LFree), (uint16_t)alignof(Rwalk_LFree), 1.0f, false, kCostHigh },
 
     // -- Bank 4: test/sanity --
     { 4, 1, "TestPlugin", &make<TestPlugin>, &unmake<TestPlugin>,
-      (uint16_t)sizeof(TestPlugin), (uint16_t)alignof(TestPlugin), 1.0f },
+      (uint16_t)sizeof(TestPlugin), (uint16_t)alignof(TestPlugin), 1.0f, true, kCostLow },
     { 4, 2, "WhiteNoise", &make<WhiteNoise>, &unmake<WhiteNoise>,
-      (uint16_t)sizeof(WhiteNoise), (uint16_t)alignof(WhiteNoise), 1.0f },
+      (uint16_t)sizeof(WhiteNoise), (uint16_t)alignof(WhiteNoise), 1.0f, true, kCostLow },
     { 4, 3, "TeensyAlt",  &make<TeensyAlt>,  &unmake<TeensyAlt>,
-      (uint16_t)sizeof(TeensyAlt),  (uint16_t)alignof(TeensyAlt),  1.0f },
+      (uint16_t)sizeof(TeensyAlt),  (uint16_t)alignof(TeensyAlt),  1.0f, true, kCostLow },
 };
 
 inline constexpr size_t kNumEntries = sizeof(kEntries) / sizeof(kEntries[0]);
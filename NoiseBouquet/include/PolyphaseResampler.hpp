@@ -0,0 +1,205 @@
+// =============================================================================
+// PolyphaseResampler.hpp  —  44.1 kHz algorithm output to the NT host rate
+// =============================================================================
+// The vendored algorithms render at AUDIO_SAMPLE_RATE_EXACT. This converts
+// their int16 stream to the host rate a span of output frames at a time.
+//
+// Quality settings:
+//   - kLinear   two-point interpolation: the original converter, cheapest,
+//               but the bright noise algorithms image and alias audibly.
+//   - kSinc8    8-tap windowed sinc.
+//   - kSinc16   16-tap windowed sinc.
+//
+// The sinc kernels (PolyphaseKernels) are precomputed for kPhases + 1
+// fractional positions (render() takes the nearest one): Blackman-windowed,
+// cut off just below the lower of the two Nyquist frequencies and normalised
+// to unity gain at DC. They are built once, in construct(): every host rate at
+// or above 44.1 kHz shares the same cutoff, so a rate change during step()
+// only retunes the ratio. One set serves every stream of a plugin instance;
+// each PolyphaseResampler holds only its stream's state. Source samples sit in a
+// mirrored ring so every kernel reads one contiguous window.
+//
+// render() first replays the phase walk of the span to find how many source
+// samples it consumes, pulls exactly those (plus the kernel's lookahead)
+// through NoisePlethoraPlugin::pullSpan(), then runs the kernel loop with no
+// further checks. No heap and no globals: kernels and resamplers live in the
+// instance's DRAM block.
+// =============================================================================
+#pragma once
+
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+
+#include "../algos/NoisePlethoraPlugin.hpp"
+
+class PolyphaseKernels {
+public:
+    static constexpr int kPhases = 256;
+
+    // ratio = source rate / host rate (44100 / NT_globals.sampleRate).
+    // Builds the tables: not for the audio thread.
+    void init(float ratio) {
+        ratio_  = ratio;
+        cutoff_ = cutoffFor(ratio);
+        build(kernel8_, 8, cutoff_);
+        build(kernel16_, 16, cutoff_);
+    }
+
+    // Follows a host rate change without touching the tables. Returns false
+    // when the new rate wants another cutoff (hosts below 44.1 kHz only):
+    // the tables keep their cutoff and the ratio is still updated.
+    bool retune(float ratio) {
+        ratio_ = ratio;
+        return cutoffFor(ratio) == cutoff_;
+    }
+
+    float ratio() const { return ratio_; }
+
+    // (kPhases + 1) rows of `taps` weights (8 or 16).
+    const float* rows(int taps) const { return taps == 16 ? kernel16_ : kernel8_; }
+
+private:
+    // Below the source Nyquist when upsampling, the host's otherwise.
+    static float cutoffFor(float ratio) {
+        return 0.9f * (ratio > 1.0f ? 1.0f / ratio : 1.0f);
+    }
+
+    // Row r weights taps base - (taps/2 - 1) .. base + taps/2 for an output
+    // at base + r / kPhases.
+    static void build(float* kernel, int taps, float cutoff) {
+        const int half = taps / 2;
+        for (int r = 0; r <= kPhases; ++r) {
+            float* h = kernel + r * taps;
+            const float frac = (float)r / (float)kPhases;
+            float sum = 0.0f;
+            for (int j = 0; j < taps; ++j) {
+                const float d = frac + (float)(half - 1 - j);
+                const float x = (float)M_PI * cutoff * d;
+                const float sinc = (std::fabs(x) < 1e-6f) ? 1.0f : std::sin(x) / x;
+                const float w = (float)M_PI * d / (float)half;
+                const float window = 0.42f + 0.5f * std::cos(w) + 0.08f * std::cos(2.0f * w);
+                h[j] = sinc * window;
+                sum += h[j];
+            }
+            for (int j = 0; j < taps; ++j) h[j] /= sum;
+        }
+    }
+
+    float kernel8_[(kPhases + 1) * 8];
+    float kernel16_[(kPhases + 1) * 16];
+    float ratio_  = 1.0f;
+    float cutoff_ = 0.9f;
+};
+
+class PolyphaseResampler {
+public:
+    enum Quality : uint8_t { kLinear, kSinc8, kSinc16, kNumQualities };
+
+    static constexpr int kMaxSpan = 64;    // output frames per render() call
+    // Holds the longest kernel window plus the source samples of one span,
+    // for host rates down to ~12 kHz.
+    static constexpr int kRingSize = 256;
+
+    // Binds the stream to a kernel set; reset after the set is retuned for a
+    // new ratio.
+    void init(const PolyphaseKernels* kernels) {
+        kernels_ = kernels;
+        reset();
+    }
+
+    // Takes effect on the next render(); the ring already holds the history
+    // any kernel needs.
+    void setQuality(Quality q) { quality_ = q; }
+
+    // Forget the source stream (new algorithm, or none).
+    void reset() {
+        std::memset(ring_, 0, sizeof(ring_));
+        phase_   = 0.0f;
+        base_    = 0;
+        written_ = 0;
+    }
+
+    // Renders n (<= kMaxSpan) host-rate frames of `algo` into out.
+    void render(NoisePlethoraPlugin* algo, float* out, int n) {
+        const float ratio = kernels_->ratio();
+        float p = phase_;
+        uint32_t advance = 0;
+        for (int k = 0; k < n; ++k) {
+            p += ratio;
+            while (p >= 1.0f) {
+                p -= 1.0f;
+                ++advance;
+            }
+        }
+
+        switch (quality_) {
+            case kSinc8:
+                fill(algo, base_ + advance + 4);
+                renderSinc<8>(kernels_->rows(8), ratio, out, n);
+                break;
+            case kSinc16:
+                fill(algo, base_ + advance + 8);
+                renderSinc<16>(kernels_->rows(16), ratio, out, n);
+                break;
+            default:
+                fill(algo, base_ + advance + 1);
+                renderLinear(ratio, out, n);
+                break;
+        }
+    }
+
+private:
+    static constexpr uint32_t kMask = kRingSize - 1;
+
+    // Pull source samples up to and including index `last`.
+    void fill(NoisePlethoraPlugin* algo, uint32_t last) {
+        while ((int32_t)(last - written_) >= 0) {
+            const int16_t* span;
+            const int m = algo->pullSpan(&span, (int)(last - written_) + 1);
+            for (int k = 0; k < m; ++k) {
+                const uint32_t slot = written_ & kMask;
+                ring_[slot] = ring_[slot + kRingSize] = int16_to_float_1v(span[k]);
+                ++written_;
+            }
+        }
+    }
+
+    // Source position of the output frame: base_ + phase_, with base_ + 1
+    // the next source sample.
+    inline void advance(float ratio) {
+        phase_ += ratio;
+        while (phase_ >= 1.0f) {
+            phase_ -= 1.0f;
+            ++base_;
+        }
+    }
+
+    void renderLinear(float ratio, float* out, int n) {
+        for (int k = 0; k < n; ++k) {
+            advance(ratio);
+            const float* x = ring_ + (base_ & kMask);
+            out[k] = x[0] + (x[1] - x[0]) * phase_;
+        }
+    }
+
+    template <int kTaps>
+    void renderSinc(const float* kernel, float ratio, float* out, int n) {
+        for (int k = 0; k < n; ++k) {
+            advance(ratio);
+            const float* x = ring_ + ((base_ - (kTaps / 2 - 1)) & kMask);
+            const float* h = kernel
+                           + (int)(phase_ * PolyphaseKernels::kPhases + 0.5f) * kTaps;
+            float acc = 0.0f;
+            for (int j = 0; j < kTaps; ++j) acc += h[j] * x[j];
+            out[k] = acc;
+        }
+    }
+
+    const PolyphaseKernels* kernels_ = nullptr;
+    float    ring_[kRingSize * 2];   // mirrored: slot s is also at s + kRingSize
+    float    phase_   = 0.0f;
+    uint32_t base_    = 0;
+    uint32_t written_ = 0;
+    Quality  quality_ = kSinc8;
+};
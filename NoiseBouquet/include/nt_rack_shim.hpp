@@ -32,6 +32,8 @@ namespace dsp {
 //   - empty()
 //   - shift()              -> pop one element
 //   - pushBuffer(T*, n)    -> push n elements in bulk
+// plus front()/contiguous()/consume() so NoisePlethoraPlugin::pullSpan() can
+// hand out the stored block without copying it.
 template <typename T, size_t N>
 class RingBuffer {
 public:
@@ -59,6 +61,15 @@ public:
         }
     }
 
+    // Oldest element, and how many follow it before the storage wraps.
+    const T* front() const { return &data[start & (N - 1)]; }
+    size_t contiguous() const {
+        const size_t toWrap = N - (start & (N - 1));
+        return size() < toWrap ? size() : toWrap;
+    }
+    // Pop n elements (n <= contiguous()) after reading them through front().
+    void consume(size_t n) { start += (int)n; }
+
 private:
     static_assert((N & (N - 1)) == 0, "RingBuffer N must be a power of two");
     T   data[N];
@@ -113,14 +124,29 @@ inline float uniform() {
 
 namespace nt_shim {
 
-// The vendored Befaco/Teensy units assume a fixed 44.1 kHz sample rate
-// (AUDIO_SAMPLE_RATE_EXACT). We honour that by always reporting 44100 here;
-// NoiseBouquet.cpp's step() resamples the algo output to NT's actual rate.
-// This keeps pitches and times identical to the original hardware.
+// The rate the algorithms render at. The vendored Befaco/Teensy units assume
+// a fixed 44.1 kHz sample rate (AUDIO_SAMPLE_RATE_EXACT), which is what an
+// unset rate reports; NoiseBouquet.cpp's step() resamples the algo output to
+// NT's actual rate. This keeps pitches and times identical to the original
+// hardware.
+//
+// In native-rate mode the plugin sets the host rate here instead, and the
+// units compute their phase increments and coefficients against it. Every
+// plugin instance sets its own rate before calling into its algorithm, so
+// instances in different modes can share the one value. A trivial
+// function-local static lives in .bss: no guard, no .data relocation.
+inline float& nt_render_rate() {
+    static float rate;           // 0 until set: the 44.1 kHz default
+    return rate;
+}
+
 struct Engine {
-    float getSampleRate() const { return 44100.0f; }
-    float getSampleTime() const { return 1.0f / 44100.0f; }
-    void  setSampleRate(float /*sr*/) {}
+    float getSampleRate() const {
+        const float sr = nt_render_rate();
+        return sr > 0.0f ? sr : 44100.0f;
+    }
+    float getSampleTime() const { return 1.0f / getSampleRate(); }
+    void  setSampleRate(float sr) { nt_render_rate() = sr; }
 };
 
 struct Context {
@@ -148,8 +174,8 @@ inline Context* nt_app_ptr() {
 // a `.data.rel` entry for the pointer's storage.
 #define APP (::nt_shim::nt_app_ptr())
 
-// Kept for source compatibility; the shim has no state to set.
-inline void setSampleRate(float /*sr*/) {}
+// Sets the rate the algorithms render at (see Engine).
+inline void setSampleRate(float sr) { nt_render_rate() = sr; }
 
 } // namespace nt_shim
 
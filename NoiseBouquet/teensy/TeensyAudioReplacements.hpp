@@ -11,6 +11,7 @@
 // M3: + effect_bitcrusher / effect_combine / effect_multiply / effect_wavefolder.
 // M4: + effect_freeverb / synth_pwm / synth_pinknoise for Bank 3.
 // M5: + effect_flange / effect_granular for Bank 1.
+// + synth_waveform_bank: the Bank-2 cluster oscillators and their mixer tree.
 #pragma once
 
 #include <rack.hpp>            // -> NoiseBouquet/include/rack.hpp -> nt_rack_shim.hpp
@@ -22,6 +23,7 @@
 #include "synth_whitenoise.hpp"
 #include "synth_pwm.hpp"
 #include "synth_waveform.hpp"
+#include "synth_waveform_bank.hpp"
 #include "filter_variable.hpp"
 #include "mixer.hpp"
 #include "effect_bitcrusher.h"
@@ -40,22 +40,18 @@ AudioEffectFreeverb::AudioEffectFreeverb() : AudioStream(1) {
 	memset(comb6buf, 0, sizeof(comb6buf));
 	memset(comb7buf, 0, sizeof(comb7buf));
 	memset(comb8buf, 0, sizeof(comb8buf));
-	comb1index = 0;
-	comb2index = 0;
-	comb3index = 0;
-	comb4index = 0;
-	comb5index = 0;
-	comb6index = 0;
-	comb7index = 0;
-	comb8index = 0;
-	comb1filter = 0;
-	comb2filter = 0;
-	comb3filter = 0;
-	comb4filter = 0;
-	comb5filter = 0;
-	comb6filter = 0;
-	comb7filter = 0;
-	comb8filter = 0;
+	combbuf[0] = comb1buf;
+	combbuf[1] = comb2buf;
+	combbuf[2] = comb3buf;
+	combbuf[3] = comb4buf;
+	combbuf[4] = comb5buf;
+	combbuf[5] = comb6buf;
+	combbuf[6] = comb7buf;
+	combbuf[7] = comb8buf;
+	for (int k = 0; k < kNumCombs; k++) {
+		combindex[k] = 0;
+		combfilter[k] = 0;
+	}
 	combdamp1 = 6553;
 	combdamp2 = 26215;
 	combfeeback = 27524;
@@ -63,131 +59,141 @@ AudioEffectFreeverb::AudioEffectFreeverb() : AudioStream(1) {
 	memset(allpass2buf, 0, sizeof(allpass2buf));
 	memset(allpass3buf, 0, sizeof(allpass3buf));
 	memset(allpass4buf, 0, sizeof(allpass4buf));
-	allpass1index = 0;
-	allpass2index = 0;
-	allpass3index = 0;
-	allpass4index = 0;
+	for (int k = 0; k < kNumAllpasses; k++) {
+		allpassindex[k] = 0;
+	}
 }
 
 
 // cleaner sat16 by http://www.moseleyinstruments.com/
-__attribute__((unused))
-static int16_t sat16(int32_t n, int rshift) {
+// Written without branches so the lane loops below vectorise.
+static inline int16_t sat16(int32_t n, int rshift) __attribute__((always_inline, unused));
+static inline int16_t sat16(int32_t n, int rshift) {
 	// we should always round towards 0
 	// to avoid recirculating round-off noise
 	//
 	// a 2s complement positive number is always
 	// rounded down, so we only need to take
 	// care of negative numbers
-	if (n < 0) {
-		n = n + (~(0xFFFFFFFFUL << rshift));
+	n = (n + (n < 0 ? (int32_t)~(0xFFFFFFFFUL << rshift) : 0)) >> rshift;
+	n = n > 32767 ? 32767 : n;
+	n = n < -32768 ? -32768 : n;
+	return n;
+}
+
+// Samples from sample i of the block to its end, or to the end of a line of
+// the given length read from index, whichever comes first.
+static inline int span(int length, int index, int i) {
+	int n = length - index;
+	return n < AUDIO_BLOCK_SAMPLES - i ? n : AUDIO_BLOCK_SAMPLES - i;
+}
+
+// The eight combs are independent given the input, so they run as eight
+// lanes: each line's next block of samples is copied into its column of
+// `comblanes`, every sample then updates all eight filters at once, and the
+// new values are copied back. The copies also add the outputs into sum.
+void AudioEffectFreeverb::combs(const int16_t* input, int32_t* sum) {
+	int16_t (*lanes)[kNumCombs] = comblanes;
+
+	for (int k = 0; k < kNumCombs; k++) {
+		const int16_t* buf = combbuf[k];
+		int index = combindex[k];
+		int i = 0;
+		while (i < AUDIO_BLOCK_SAMPLES) {
+			int n = span(kCombLength[k], index, i);
+			const int16_t* line = buf + index;
+			for (int j = 0; j < n; j++) {
+				int16_t bufout = line[j];
+				lanes[i + j][k] = bufout;
+				sum[i + j] += bufout;
+			}
+			i += n;
+			index = (index + n) % kCombLength[k];
+		}
 	}
-	n = n >> rshift;
-	if (n > 32767) {
-		return 32767;
+
+	int32_t filter[kNumCombs];
+	for (int k = 0; k < kNumCombs; k++) {
+		filter[k] = combfilter[k];
 	}
-	if (n < -32768) {
-		return -32768;
+	const int32_t damp1 = combdamp1;
+	const int32_t damp2 = combdamp2;
+	const int32_t feedback = combfeeback;
+	for (int i = 0; i < AUDIO_BLOCK_SAMPLES; i++) {
+		int16_t* lane = lanes[i];
+		const int32_t in = input[i];
+		for (int k = 0; k < kNumCombs; k++) {
+			filter[k] = sat16(lane[k] * damp2 + filter[k] * damp1, 15);
+			lane[k] = sat16(in + sat16(filter[k] * feedback, 15), 0);
+		}
+	}
+	for (int k = 0; k < kNumCombs; k++) {
+		combfilter[k] = filter[k];
+	}
+
+	for (int k = 0; k < kNumCombs; k++) {
+		int16_t* buf = combbuf[k];
+		int index = combindex[k];
+		int i = 0;
+		while (i < AUDIO_BLOCK_SAMPLES) {
+			int n = span(kCombLength[k], index, i);
+			int16_t* line = buf + index;
+			for (int j = 0; j < n; j++) {
+				line[j] = lanes[i + j][k];
+			}
+			i += n;
+			index = (index + n) % kCombLength[k];
+		}
+		combindex[k] = index;
+	}
+}
+
+// One allpass over the whole block. Its line is longer than a block, so no
+// sample depends on another one of the same block.
+void AudioEffectFreeverb::allpass(int16_t* buf, uint16_t length, uint16_t& index, int16_t* data) {
+	int i = 0;
+	while (i < AUDIO_BLOCK_SAMPLES) {
+		int n = span(length, index, i);
+		int16_t* line = buf + index;
+		for (int j = 0; j < n; j++) {
+			int16_t output = data[i + j];
+			int16_t bufout = line[j];
+			line[j] = output + (bufout >> 1);
+			data[i + j] = sat16(bufout - output, 1);
+		}
+		i += n;
+		index = (index + n) % length;
 	}
-	return n;
 }
 
 void AudioEffectFreeverb::update(const audio_block_t* block, audio_block_t* outblock) {
-	int i;
-	int16_t input, bufout, output;
-	int32_t sum;
+	int16_t* input = blockinput;
+	int32_t* sum = blocksum;
+	int16_t* data = blockdata;
 
 	if (!block || !outblock) {
 		return;
 	}
 
-	for (i = 0; i < AUDIO_BLOCK_SAMPLES; i++) {
+	for (int i = 0; i < AUDIO_BLOCK_SAMPLES; i++) {
 		// TODO: scale numerical range depending on roomsize & damping
-		input = sat16(block->data[i] * 8738, 17); // for numerical headroom
-		sum = 0;
-
-		bufout = comb1buf[comb1index];
-		sum += bufout;
-		comb1filter = sat16(bufout * combdamp2 + comb1filter * combdamp1, 15);
-		comb1buf[comb1index] = sat16(input + sat16(comb1filter * combfeeback, 15), 0);
-		if (++comb1index >= sizeof(comb1buf) / sizeof(int16_t))
-			comb1index = 0;
-
-		bufout = comb2buf[comb2index];
-		sum += bufout;
-		comb2filter = sat16(bufout * combdamp2 + comb2filter * combdamp1, 15);
-		comb2buf[comb2index] = sat16(input + sat16(comb2filter * combfeeback, 15), 0);
-		if (++comb2index >= sizeof(comb2buf) / sizeof(int16_t))
-			comb2index = 0;
-
-		bufout = comb3buf[comb3index];
-		sum += bufout;
-		comb3filter = sat16(bufout * combdamp2 + comb3filter * combdamp1, 15);
-		comb3buf[comb3index] = sat16(input + sat16(comb3filter * combfeeback, 15), 0);
-		if (++comb3index >= sizeof(comb3buf) / sizeof(int16_t))
-			comb3index = 0;
-
-		bufout = comb4buf[comb4index];
-		sum += bufout;
-		comb4filter = sat16(bufout * combdamp2 + comb4filter * combdamp1, 15);
-		comb4buf[comb4index] = sat16(input + sat16(comb4filter * combfeeback, 15), 0);
-		if (++comb4index >= sizeof(comb4buf) / sizeof(int16_t))
-			comb4index = 0;
-
-		bufout = comb5buf[comb5index];
-		sum += bufout;
-		comb5filter = sat16(bufout * combdamp2 + comb5filter * combdamp1, 15);
-		comb5buf[comb5index] = sat16(input + sat16(comb5filter * combfeeback, 15), 0);
-		if (++comb5index >= sizeof(comb5buf) / sizeof(int16_t))
-			comb5index = 0;
-
-		bufout = comb6buf[comb6index];
-		sum += bufout;
-		comb6filter = sat16(bufout * combdamp2 + comb6filter * combdamp1, 15);
-		comb6buf[comb6index] = sat16(input + sat16(comb6filter * combfeeback, 15), 0);
-		if (++comb6index >= sizeof(comb6buf) / sizeof(int16_t))
-			comb6index = 0;
-
-		bufout = comb7buf[comb7index];
-		sum += bufout;
-		comb7filter = sat16(bufout * combdamp2 + comb7filter * combdamp1, 15);
-		comb7buf[comb7index] = sat16(input + sat16(comb7filter * combfeeback, 15), 0);
-		if (++comb7index >= sizeof(comb7buf) / sizeof(int16_t))
-			comb7index = 0;
-
-		bufout = comb8buf[comb8index];
-		sum += bufout;
-		comb8filter = sat16(bufout * combdamp2 + comb8filter * combdamp1, 15);
-		comb8buf[comb8index] = sat16(input + sat16(comb8filter * combfeeback, 15), 0);
-		if (++comb8index >= sizeof(comb8buf) / sizeof(int16_t))
-			comb8index = 0;
-
-		output = sat16(sum * 31457, 17);
-
-		bufout = allpass1buf[allpass1index];
-		allpass1buf[allpass1index] = output + (bufout >> 1);
-		output = sat16(bufout - output, 1);
-		if (++allpass1index >= sizeof(allpass1buf) / sizeof(int16_t))
-			allpass1index = 0;
-
-		bufout = allpass2buf[allpass2index];
-		allpass2buf[allpass2index] = output + (bufout >> 1);
-		output = sat16(bufout - output, 1);
-		if (++allpass2index >= sizeof(allpass2buf) / sizeof(int16_t))
-			allpass2index = 0;
-
-		bufout = allpass3buf[allpass3index];
-		allpass3buf[allpass3index] = output + (bufout >> 1);
-		output = sat16(bufout - output, 1);
-		if (++allpass3index >= sizeof(allpass3buf) / sizeof(int16_t))
-			allpass3index = 0;
-
-		bufout = allpass4buf[allpass4index];
-		allpass4buf[allpass4index] = output + (bufout >> 1);
-		output = sat16(bufout - output, 1);
-		if (++allpass4index >= sizeof(allpass4buf) / sizeof(int16_t))
-			allpass4index = 0;
-
-		outblock->data[i] = sat16(output * 30, 0);
+		input[i] = sat16(block->data[i] * 8738, 17); // for numerical headroom
+		sum[i] = 0;
+	}
+
+	combs(input, sum);
+
+	for (int i = 0; i < AUDIO_BLOCK_SAMPLES; i++) {
+		// The product wraps for the loudest sums, as the original's does.
+		data[i] = sat16((int32_t)((uint32_t)sum[i] * 31457u), 17);
+	}
+
+	allpass(allpass1buf, kAllpassLength[0], allpassindex[0], data);
+	allpass(allpass2buf, kAllpassLength[1], allpassindex[1], data);
+	allpass(allpass3buf, kAllpassLength[2], allpassindex[2], data);
+	allpass(allpass4buf, kAllpassLength[3], allpassindex[3], data);
+
+	for (int i = 0; i < AUDIO_BLOCK_SAMPLES; i++) {
+		outblock->data[i] = sat16(data[i] * 30, 0);
 	}
 }
\ No newline at end of file
@@ -52,6 +52,18 @@ public:
 		//__enable_irq();
 	}
 private:
+	static constexpr int kNumCombs = 8;
+	static constexpr int kNumAllpasses = 4;
+	// Delay lengths, in samples. All are longer than a block, so the
+	// samples a block reads from a line are never ones it writes.
+	static constexpr uint16_t kCombLength[kNumCombs] = {
+		1116, 1188, 1277, 1356, 1422, 1491, 1557, 1617
+	};
+	static constexpr uint16_t kAllpassLength[kNumAllpasses] = { 556, 441, 341, 225 };
+
+	void combs(const int16_t* input, int32_t* sum);
+	static void allpass(int16_t* buf, uint16_t length, uint16_t& index, int16_t* data);
+
 	int16_t comb1buf[1116];
 	int16_t comb2buf[1188];
 	int16_t comb3buf[1277];
@@ -60,22 +72,9 @@ private:
 	int16_t comb6buf[1491];
 	int16_t comb7buf[1557];
 	int16_t comb8buf[1617];
-	uint16_t comb1index;
-	uint16_t comb2index;
-	uint16_t comb3index;
-	uint16_t comb4index;
-	uint16_t comb5index;
-	uint16_t comb6index;
-	uint16_t comb7index;
-	uint16_t comb8index;
-	int16_t comb1filter;
-	int16_t comb2filter;
-	int16_t comb3filter;
-	int16_t comb4filter;
-	int16_t comb5filter;
-	int16_t comb6filter;
-	int16_t comb7filter;
-	int16_t comb8filter;
+	int16_t* combbuf[kNumCombs];
+	uint16_t combindex[kNumCombs];
+	int16_t combfilter[kNumCombs];
 	int16_t combdamp1;
 	int16_t combdamp2;
 	int16_t combfeeback;
@@ -83,8 +82,10 @@ private:
 	int16_t allpass2buf[441];
 	int16_t allpass3buf[341];
 	int16_t allpass4buf[225];
-	uint16_t allpass1index;
-	uint16_t allpass2index;
-	uint16_t allpass3index;
-	uint16_t allpass4index;
+	uint16_t allpassindex[kNumAllpasses];
+	// Per-block working buffers, kept off the audio thread's stack.
+	int16_t comblanes[AUDIO_BLOCK_SAMPLES][kNumCombs];
+	int16_t blockinput[AUDIO_BLOCK_SAMPLES];
+	int32_t blocksum[AUDIO_BLOCK_SAMPLES];
+	int16_t blockdata[AUDIO_BLOCK_SAMPLES];
 };
\ No newline at end of file
@@ -95,7 +95,7 @@ public:
 			n = 1.0f;
 		else if (n < -1.0f)
 			n = -1.0f;
-		int32_t c = (int32_t)(milliseconds * (AUDIO_SAMPLE_RATE_EXACT / 1000.0f));
+		int32_t c = (int32_t)(milliseconds * (APP->engine->getSampleRate() / 1000.0f));
 		if (c == 0) {
 			amplitude(n);
 			return;
@@ -2,6 +2,60 @@
 
 #include "audio_core.hpp"
 
+// Phase increment for freq, shared by the oscillators below and
+// AudioSynthWaveformBank.
+static inline uint32_t waveform_phase_increment(float freq) {
+
+	// for reproducibility, max frequency cuts out at 1/2 Teensy sample rate
+	// (unless we're running at very low sample rates, in which case use those to limit range)
+	const float maxFrequency = std::min(AUDIO_SAMPLE_RATE_EXACT, APP->engine->getSampleRate()) / 2.0f;
+
+	if (freq < 0.0f) {
+		freq = 0.0;
+	}
+	else if (freq > maxFrequency) {
+		freq = maxFrequency;
+	}
+	uint32_t phase_increment = freq * (4294967296.0f / APP->engine->getSampleRate());
+	if (phase_increment > 0x7FFE0000u)
+		phase_increment = 0x7FFE0000;
+	return phase_increment;
+}
+
+// Phase step of one frequency-modulated sample: inc scaled by 2^octaves, where
+// octaves = mod * modulation_factor (4096 per octave, 27 fractional bits).
+static inline uint32_t waveform_fm_step(int16_t mod, uint32_t modulation_factor, uint32_t inc) {
+	int32_t n = mod * modulation_factor; // n is # of octaves to mod
+	int32_t ipart = n >> 27; // 4 integer bits
+	n &= 0x7FFFFFF;          // 27 fractional bits
+#ifdef IMPROVE_EXPONENTIAL_ACCURACY
+	// exp2 polynomial suggested by Stefan Stenzel on "music-dsp"
+	// mail list, Wed, 3 Sep 2014 10:08:55 +0200
+	int32_t x = n << 3;
+	n = multiply_accumulate_32x32_rshift32_rounded(536870912, x, 1494202713);
+	int32_t sq = multiply_32x32_rshift32_rounded(x, x);
+	n = multiply_accumulate_32x32_rshift32_rounded(n, sq, 1934101615);
+	n = n + (multiply_32x32_rshift32_rounded(sq,
+	         multiply_32x32_rshift32_rounded(x, 1358044250)) << 1);
+	n = n << 1;
+#else
+	// exp2 algorithm by Laurent de Soras
+	// https://www.musicdsp.org/en/latest/Other/106-fast-exp2-approximation.html
+	n = (n + 134217728) << 3;
+
+	n = multiply_32x32_rshift32_rounded(n, n);
+	n = multiply_32x32_rshift32_rounded(n, 715827883) << 3;
+	n = n + 715827882;
+#endif
+	uint32_t scale = n >> (14 - ipart);
+	uint64_t phstep = (uint64_t)inc * scale;
+	uint32_t phstep_msw = phstep >> 32;
+	if (phstep_msw < 0x7FFE) {
+		return phstep >> 16;
+	}
+	return 0x7FFE0000;
+}
+
 class AudioSynthWaveform : public AudioStream {
 public:
 	AudioSynthWaveform(void) : AudioStream(0),
@@ -12,20 +66,7 @@ public:
 	}
 
 	void frequency(float freq) {
-
-		// for reproducibility, max frequency cuts out at 1/2 Teensy sample rate
-		// (unless we're running at very low sample rates, in which case use those to limit range)
-		const float maxFrequency = std::min(AUDIO_SAMPLE_RATE_EXACT, APP->engine->getSampleRate()) / 2.0f;
-
-		if (freq < 0.0f) {
-			freq = 0.0;
-		}
-		else if (freq > maxFrequency) {
-			freq = maxFrequency;
-		}
-		phase_increment = freq * (4294967296.0f / APP->engine->getSampleRate());
-		if (phase_increment > 0x7FFE0000u)
-			phase_increment = 0x7FFE0000;
+		phase_increment = waveform_phase_increment(freq);
 	}
 	void phase(float angle) {
 		if (angle < 0.0f) {
@@ -254,20 +295,7 @@ public:
 	}
 
 	void frequency(float freq) {
-
-		// for reproducibility, max frequency cuts out at 1/2 Teensy sample rate
-		// (unless we're running at very low sample rates, in which case use those to limit range)
-		const float maxFrequency = std::min(AUDIO_SAMPLE_RATE_EXACT, APP->engine->getSampleRate()) / 2.0f;
-
-		if (freq < 0.0f) {
-			freq = 0.0;
-		}
-		else if (freq > maxFrequency) {
-			freq = maxFrequency;
-		}
-		phase_increment = freq * (4294967296.0f / APP->engine->getSampleRate());
-		if (phase_increment > 0x7FFE0000u)
-			phase_increment = 0x7FFE0000;
+		phase_increment = waveform_phase_increment(freq);
 	}
 	void amplitude(float n) {	// 0 to 1.0
 		if (n < 0) {
@@ -339,37 +367,7 @@ public:
 			// Frequency Modulation
 			bp = moddata->data;
 			for (i = 0; i < AUDIO_BLOCK_SAMPLES; i++) {
-				int32_t n = (*bp++) * modulation_factor; // n is # of octaves to mod
-				int32_t ipart = n >> 27; // 4 integer bits
-				n &= 0x7FFFFFF;          // 27 fractional bits
-#ifdef IMPROVE_EXPONENTIAL_ACCURACY
-				// exp2 polynomial suggested by Stefan Stenzel on "music-dsp"
-				// mail list, Wed, 3 Sep 2014 10:08:55 +0200
-				int32_t x = n << 3;
-				n = multiply_accumulate_32x32_rshift32_rounded(536870912, x, 1494202713);
-				int32_t sq = multiply_32x32_rshift32_rounded(x, x);
-				n = multiply_accumulate_32x32_rshift32_rounded(n, sq, 1934101615);
-				n = n + (multiply_32x32_rshift32_rounded(sq,
-				         multiply_32x32_rshift32_rounded(x, 1358044250)) << 1);
-				n = n << 1;
-#else
-				// exp2 algorithm by Laurent de Soras
-				// https://www.musicdsp.org/en/latest/Other/106-fast-exp2-approximation.html
-				n = (n + 134217728) << 3;
-
-				n = multiply_32x32_rshift32_rounded(n, n);
-				n = multiply_32x32_rshift32_rounded(n, 715827883) << 3;
-				n = n + 715827882;
-#endif
-				uint32_t scale = n >> (14 - ipart);
-				uint64_t phstep = (uint64_t)inc * scale;
-				uint32_t phstep_msw = phstep >> 32;
-				if (phstep_msw < 0x7FFE) {
-					ph += phstep >> 16;
-				}
-				else {
-					ph += 0x7FFE0000;
-				}
+				ph += waveform_fm_step(*bp++, modulation_factor, inc);
 				phasedata[i] = ph;
 			}
 		}
@@ -0,0 +1,207 @@
+#pragma once
+
+#include "audio_core.hpp"
+#include "synth_waveform.hpp"
+
+// N AudioSynthWaveformModulated oscillators of one waveform and amplitude,
+// summed through the AudioMixer4 tree the cluster algorithms wire them into:
+// lanes 0-3 into the first mixer, 4-7 into the second and so on, all at unity
+// gain, then the group mixers into a final one. The output is sample for
+// sample what that graph produces, saturation order included.
+//
+// Each lane is rendered and mixed in one pass over the block, with no
+// per-oscillator output block or mixer zero/add passes in between. The lanes
+// are the same loop over different phase accumulators, so the waveform switch
+// happens once per block and the sample loop is straight integer code the
+// compiler can vectorise.
+//
+// Frequency modulation comes either from one block shared by every lane
+// (update) or from one block per lane (updateEach). Shape modulation is only
+// implemented for WAVEFORM_PULSE; WAVEFORM_TRIANGLE_VARIABLE renders as a
+// triangle, like AudioSynthWaveformModulated without a shape input. Waveforms
+// that keep per-oscillator state (arbitrary, sample and hold) and tone offsets
+// are not supported and render silence.
+template <int N>
+class AudioSynthWaveformBank : public AudioStream {
+	static_assert(N >= 1 && N <= 16, "one AudioMixer4 per four lanes, and one above them");
+
+public:
+	AudioSynthWaveformBank(void) : AudioStream(2),
+		modulation_factor(32768), magnitude(0), tone_type(WAVEFORM_SINE) {
+		for (int k = 0; k < N; k++) {
+			phase_accumulator[k] = 0;
+			phase_increment[k] = 0;
+		}
+	}
+
+	void frequency(int lane, float freq) {
+		phase_increment[lane] = waveform_phase_increment(freq);
+	}
+	void amplitude(float n) {	// 0 to 1.0
+		if (n < 0) {
+			n = 0;
+		}
+		else if (n > 1.0f) {
+			n = 1.0f;
+		}
+		magnitude = n * 65536.0f;
+	}
+	void frequencyModulation(float octaves) {
+		if (octaves > 12.0f) {
+			octaves = 12.0f;
+		}
+		else if (octaves < 0.1f) {
+			octaves = 0.1f;
+		}
+		modulation_factor = octaves * 4096.0f;
+	}
+	void begin(short t_type) {
+		tone_type = t_type;
+	}
+	void begin(float t_amp, short t_type) {
+		amplitude(t_amp);
+		begin(t_type);
+	}
+
+	// Every lane frequency-modulated by moddata, if any.
+	void update(const audio_block_t* moddata, const audio_block_t* shapedata, audio_block_t* out) {
+		render(moddata, 0, shapedata, out);
+	}
+
+	// Lane k frequency-modulated by moddata[k].
+	void updateEach(const audio_block_t* moddata, const audio_block_t* shapedata, audio_block_t* out) {
+		render(moddata, 1, shapedata, out);
+	}
+
+private:
+	void render(const audio_block_t* moddata, int modStride, const audio_block_t* shapedata, audio_block_t* out) {
+		if (!out) {
+			return;
+		}
+
+		switch (tone_type) {
+			case WAVEFORM_SINE:
+				mix<WAVEFORM_SINE>(moddata, modStride, nullptr, out);
+				break;
+			case WAVEFORM_PULSE:
+				if (shapedata) {
+					mix<WAVEFORM_PULSE>(moddata, modStride, shapedata->data, out);
+					break;
+				}
+			// fall through
+			case WAVEFORM_SQUARE:
+				mix<WAVEFORM_SQUARE>(moddata, modStride, nullptr, out);
+				break;
+			case WAVEFORM_SAWTOOTH:
+				mix<WAVEFORM_SAWTOOTH>(moddata, modStride, nullptr, out);
+				break;
+			case WAVEFORM_SAWTOOTH_REVERSE:
+				mix<WAVEFORM_SAWTOOTH_REVERSE>(moddata, modStride, nullptr, out);
+				break;
+			case WAVEFORM_TRIANGLE_VARIABLE:
+			case WAVEFORM_TRIANGLE:
+				mix<WAVEFORM_TRIANGLE>(moddata, modStride, nullptr, out);
+				break;
+			default:
+				out->zeroAudioBlock();
+				break;
+		}
+	}
+
+	// Group g (lanes 4g..4g+3) is summed into group, then added to out, which
+	// is what the group mixer followed by the final mixer compute. The first
+	// group goes to out directly, as 0 + x never saturates.
+	template <int kShape>
+	void mix(const audio_block_t* moddata, int modStride, const int16_t* width, audio_block_t* out) {
+		for (int k = 0; k < N; k++) {
+			const int16_t* mod = moddata ? moddata[k * modStride].data : nullptr;
+			int16_t* acc = k < 4 ? out->data : group;
+			if ((k & 3) == 0) {
+				memset(acc, 0, sizeof(int16_t) * AUDIO_BLOCK_SAMPLES);
+			}
+			if (mod) {
+				lane<kShape, true>(k, mod, width, acc);
+			}
+			else {
+				lane<kShape, false>(k, mod, width, acc);
+			}
+			if (k >= 4 && ((k & 3) == 3 || k == N - 1)) {
+				for (int i = 0; i < AUDIO_BLOCK_SAMPLES; i++) {
+					out->data[i] = saturate16(out->data[i] + group[i]);
+				}
+			}
+		}
+	}
+
+	// One oscillator, added into acc with the mixer's saturation. The phase of
+	// sample i is taken after the modulated step, or before the plain one, as
+	// in AudioSynthWaveformModulated::update(). Only the modulated phases are
+	// a running sum; unmodulated ones are computed in the sample loop, which
+	// then carries no dependency from one sample to the next.
+	template <int kShape, bool kModulated>
+	inline void lane(int k, const int16_t* mod, const int16_t* width, int16_t* acc) {
+		const uint32_t inc = phase_increment[k];
+		const int32_t mag = magnitude;
+		const int16_t magnitude15 = signed_saturate_rshift(mag, 16, 1);
+		const uint32_t ph = phase_accumulator[k];
+
+		if (kModulated) {
+			uint32_t p = ph;
+			for (int i = 0; i < AUDIO_BLOCK_SAMPLES; i++) {
+				p += waveform_fm_step(mod[i], modulation_factor, inc);
+				phasedata[i] = p;
+			}
+			phase_accumulator[k] = p;
+		}
+		else {
+			phase_accumulator[k] = ph + inc * AUDIO_BLOCK_SAMPLES;
+		}
+
+		for (int i = 0; i < AUDIO_BLOCK_SAMPLES; i++) {
+			const uint32_t p = kModulated ? phasedata[i] : ph + inc * i;
+
+			int16_t v;
+			if (kShape == WAVEFORM_SINE) {
+				uint32_t index = p >> 24;
+				int32_t val1 = AudioWaveformSine[index];
+				int32_t val2 = AudioWaveformSine[index + 1];
+				uint32_t scale = (p >> 8) & 0xFFFF;
+				val2 *= scale;
+				val1 *= 0x10000 - scale;
+				v = multiply_32x32_rshift32(val1 + val2, mag);
+			}
+			else if (kShape == WAVEFORM_PULSE) {
+				uint32_t w = ((width[i] + 0x8000) & 0xFFFF) << 16;
+				v = p < w ? magnitude15 : -magnitude15;
+			}
+			else if (kShape == WAVEFORM_SQUARE) {
+				v = (p & 0x80000000) ? -magnitude15 : magnitude15;
+			}
+			else if (kShape == WAVEFORM_SAWTOOTH) {
+				v = signed_multiply_32x16t(mag, p);
+			}
+			else if (kShape == WAVEFORM_SAWTOOTH_REVERSE) {
+				v = signed_multiply_32x16t(0xFFFFFFFFu - mag, p);
+			}
+			else {
+				uint32_t phtop = p >> 30;
+				if (phtop == 1 || phtop == 2) {
+					v = ((0xFFFF - (p >> 15)) * mag) >> 16;
+				}
+				else {
+					v = (((int32_t)p >> 15) * mag) >> 16;
+				}
+			}
+
+			acc[i] = saturate16(acc[i] + v);
+		}
+	}
+
+	uint32_t phase_accumulator[N];
+	uint32_t phase_increment[N];
+	uint32_t modulation_factor;
+	int32_t  magnitude;
+	short    tone_type;
+	uint32_t phasedata[AUDIO_BLOCK_SAMPLES];
+	int16_t  group[AUDIO_BLOCK_SAMPLES];
+};
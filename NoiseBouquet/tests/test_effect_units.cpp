@@ -7,6 +7,9 @@
 // through a plugin, which keeps M3 isolated from the Bank/Program framework.
 // Each test renders a short deterministic WAV and asserts the effect is both
 // audible and meaningfully different from its dry input.
+//
+// The oscillator bank is checked against the graph it replaces instead, and
+// the freeverb against the upstream per-sample version of itself.
 // =============================================================================
 
 #include "../../test_harness/test_framework.h"
@@ -17,10 +20,13 @@
 #include "../teensy/dspinst.h"
 #include "../teensy/synth_dc.hpp"
 #include "../teensy/synth_waveform.hpp"
+#include "../teensy/synth_waveform_bank.hpp"
+#include "../teensy/mixer.hpp"
 #include "../teensy/effect_bitcrusher.h"
 #include "../teensy/effect_combine.hpp"
 #include "../teensy/effect_multiply.h"
 #include "../teensy/effect_wavefolder.hpp"
+#include "../teensy/effect_freeverb.hpp"
 
 #include <cmath>
 #include <cstring>
@@ -34,7 +40,8 @@ static int blocksFor(float seconds) {
 }
 
 static void prepareStandaloneAudio() {
-    nt_shim::setSampleRate(static_cast<float>(NtTestHarness::getSampleRate()));
+    // The units render at their 44.1 kHz default, as inside the plugin.
+    nt_shim::setSampleRate(AUDIO_SAMPLE_RATE_EXACT);
     teensy::seed = 1;
 }
 
@@ -198,3 +205,155 @@ TestResult test_effect_wavefolder_wav() {
     ASSERT_GT(maxDiff, 0.005f, "wavefolder meaningfully alters waveform");
     TEST_PASS();
 }
+
+// Renders the bank and the AudioSynthWaveformModulated + AudioMixer4 tree it
+// stands for side by side, with lane k modulated by mods[k] (or nothing).
+template <int N>
+static bool bankMatchesGraph(short type, float amp, AudioSynthWaveform* mods,
+                             bool shared, audio_block_t* shape) {
+    AudioSynthWaveformModulated osc[N];
+    AudioMixer4 mixers[5];
+    AudioSynthWaveformBank<N> bank;
+    bank.begin(amp, type);
+    for (int k = 0; k < N; ++k) {
+        float f = 97.0f * (k + 1) * 1.37f;
+        osc[k].begin(amp, f, type);
+        bank.frequency(k, f);
+    }
+
+    audio_block_t mod[N] = {}, lane[16] = {}, group[5] = {}, out = {};
+    for (int b = 0; b < 64; ++b) {
+        const int nMods = !mods ? 0 : shared ? 1 : N;
+        for (int k = 0; k < nMods; ++k) mods[k].update(&mod[k]);
+        for (int k = 0; k < N; ++k)
+            osc[k].update(!mods ? nullptr : &mod[shared ? 0 : k], shape, &lane[k]);
+        for (int g = 0; g < 4; ++g) {
+            const audio_block_t* in[4];
+            for (int j = 0; j < 4; ++j) in[j] = 4 * g + j < N ? &lane[4 * g + j] : nullptr;
+            mixers[g].update(in[0], in[1], in[2], in[3], &group[g]);
+        }
+        mixers[4].update(&group[0], N > 4 ? &group[1] : nullptr,
+                         N > 8 ? &group[2] : nullptr, N > 12 ? &group[3] : nullptr, &group[4]);
+
+        if (!mods) bank.update(nullptr, shape, &out);
+        else if (shared) bank.update(&mod[0], shape, &out);
+        else bank.updateEach(mod, shape, &out);
+        if (std::memcmp(out.data, group[4].data, sizeof(out.data)) != 0) return false;
+    }
+    return true;
+}
+
+TestResult test_waveform_bank_matches_graph() {
+    TEST_BEGIN("AudioSynthWaveformBank matches oscillators + mixer tree");
+    prepareStandaloneAudio();
+
+    AudioSynthWaveform mods[16];
+    for (int k = 0; k < 16; ++k) mods[k].begin(0.8f, 3.0f + 41.0f * k, WAVEFORM_SINE);
+    AudioSynthWaveformDc dc;
+    dc.amplitude(-0.4f);
+    audio_block_t width = {};
+    dc.update(&width);
+
+    // Full-scale lanes: the tree saturates in every group and at the top.
+    ASSERT_TRUE(bankMatchesGraph<16>(WAVEFORM_SAWTOOTH, 1.0f, nullptr, false, nullptr),
+                "16 saws, no modulation");
+    ASSERT_TRUE(bankMatchesGraph<16>(WAVEFORM_SQUARE, 0.9f, mods, true, nullptr),
+                "16 squares, shared FM");
+    ASSERT_TRUE(bankMatchesGraph<6>(WAVEFORM_SINE, 1.0f, mods, false, nullptr),
+                "6 sines, FM per lane");
+    ASSERT_TRUE(bankMatchesGraph<6>(WAVEFORM_PULSE, 0.7f, nullptr, false, &width),
+                "6 pulses, shared width");
+    ASSERT_TRUE(bankMatchesGraph<16>(WAVEFORM_TRIANGLE_VARIABLE, 0.3f, mods, true, nullptr),
+                "16 triangles, shared FM");
+    ASSERT_TRUE(bankMatchesGraph<11>(WAVEFORM_SAWTOOTH_REVERSE, 0.5f, mods, false, nullptr),
+                "11 reverse saws, partial last group");
+    TEST_PASS();
+}
+
+// The upstream Teensy freeverb, one sample at a time, with the eight combs
+// and four allpasses in arrays. AudioEffectFreeverb must match it bit for bit.
+struct ReferenceFreeverb {
+    static constexpr int kCombLength[8] = { 1116, 1188, 1277, 1356, 1422, 1491, 1557, 1617 };
+    static constexpr int kAllpassLength[4] = { 556, 441, 341, 225 };
+
+    int16_t comb[8][1617] = {};
+    int combIndex[8] = {};
+    int16_t combFilter[8] = {};
+    int16_t allpass[4][556] = {};
+    int allpassIndex[4] = {};
+    int16_t damp1 = 6553, damp2 = 26215, feedback = 27524;
+
+    static int16_t sat16(int32_t n, int rshift) {
+        if (n < 0) n = n + (~(0xFFFFFFFFUL << rshift));
+        n = n >> rshift;
+        if (n > 32767) return 32767;
+        if (n < -32768) return -32768;
+        return n;
+    }
+
+    void roomsize(float n) {
+        n = n > 1.0f ? 1.0f : n < 0.0f ? 0.0f : n;
+        feedback = (int)(n * 9175.04f) + 22937;
+    }
+
+    void damping(float n) {
+        n = n > 1.0f ? 1.0f : n < 0.0f ? 0.0f : n;
+        damp1 = (int)(n * 13107.2f);
+        damp2 = 32768 - damp1;
+    }
+
+    void update(const audio_block_t* block, audio_block_t* outblock) {
+        for (int i = 0; i < AUDIO_BLOCK_SAMPLES; i++) {
+            int16_t input = sat16(block->data[i] * 8738, 17);
+            int32_t sum = 0;
+            for (int k = 0; k < 8; k++) {
+                int16_t bufout = comb[k][combIndex[k]];
+                sum += bufout;
+                combFilter[k] = sat16(bufout * damp2 + combFilter[k] * damp1, 15);
+                comb[k][combIndex[k]] = sat16(input + sat16(combFilter[k] * feedback, 15), 0);
+                if (++combIndex[k] >= kCombLength[k]) combIndex[k] = 0;
+            }
+            // Upstream multiplies as int32; wrap explicitly to stay defined.
+            int16_t output = sat16((int32_t)((uint32_t)sum * 31457u), 17);
+            for (int k = 0; k < 4; k++) {
+                int16_t bufout = allpass[k][allpassIndex[k]];
+                allpass[k][allpassIndex[k]] = output + (bufout >> 1);
+                output = sat16(bufout - output, 1);
+                if (++allpassIndex[k] >= kAllpassLength[k]) allpassIndex[k] = 0;
+            }
+            outblock->data[i] = sat16(output * 30, 0);
+        }
+    }
+};
+
+constexpr int ReferenceFreeverb::kCombLength[8];
+constexpr int ReferenceFreeverb::kAllpassLength[4];
+
+TestResult test_freeverb_matches_reference() {
+    TEST_BEGIN("AudioEffectFreeverb matches the per-sample reference");
+    static AudioEffectFreeverb reverb;  // ~20 kB of lines each: keep them
+    static ReferenceFreeverb reference; // off the stack
+
+    // Full-scale noise bursts, with the settings moved between them, so the
+    // lines wrap many times and the sums saturate.
+    static const float settings[][2] = { { 0.5f, 0.2f }, { 1.0f, 0.0f }, { 0.2f, 1.0f } };
+    uint32_t rng = 12345;
+    audio_block_t in = {}, out = {}, expected = {};
+    for (const auto& s : settings) {
+        reverb.roomsize(s[0]);
+        reverb.damping(s[1]);
+        reference.roomsize(s[0]);
+        reference.damping(s[1]);
+        for (int b = 0; b < 200; ++b) {
+            for (int i = 0; i < BLOCK_SIZE; ++i) {
+                rng = rng * 1664525u + 1013904223u;
+                in.data[i] = b < 20 ? (int16_t)(rng >> 16) : 0;
+            }
+            reverb.update(&in, &out);
+            reference.update(&in, &expected);
+            ASSERT_TRUE(std::memcmp(out.data, expected.data, sizeof(out.data)) == 0,
+                        "output identical to the reference");
+        }
+    }
+    TEST_PASS();
+}
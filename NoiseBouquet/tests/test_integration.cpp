@@ -18,7 +18,12 @@
 #include "../../test_harness/plugin_harness.h"
 #include "../../test_harness/wav_writer.h"
 #include "../../test_harness/sha256.h"
+#include "../../test_harness/perf_registry.h"
 
+#include "../algos/NoisePlethoraPlugin.hpp"
+#include "../include/PolyphaseResampler.hpp"
+
+#include <algorithm>
 #include <cmath>
 #include <cstdio>
 #include <cstring>
@@ -45,8 +50,24 @@ enum {
     kParamX,
     kParamY,
     kParamGain,
+    kParamQuality,
+    kParamRenderRate,
+    kNumParams,
 };
 
+// Second engine ("Engines" specification = 2), appended after the above.
+enum {
+    kParamOut2 = kNumParams,
+    kParamOutMode2,
+    kParamBank2,
+    kParamProgram2,
+    kParamX2,
+    kParamY2,
+    kParamGain2,
+    kNumParamsDual,
+};
+static constexpr int OUTPUT_BUS_2 = 14 - 1; // matches kParamOut2 default
+
 // Program layout from PluginRegistry.hpp.
 static constexpr int kProg_radioOhNo          = 1;
 static constexpr int kProg_Rwalk_SineFMFlange = 2;
@@ -92,6 +113,8 @@ TestResult test_effect_bitcrusher_wav();
 TestResult test_effect_combine_wav();
 TestResult test_effect_multiply_wav();
 TestResult test_effect_wavefolder_wav();
+TestResult test_waveform_bank_matches_graph();
+TestResult test_freeverb_matches_reference();
 
 // -----------------------------------------------------------------------------
 // Helpers
@@ -145,13 +168,13 @@ static int countZeroCrossings(const float* samples, int count) {
 // =============================================================================
 
 TestResult test_plugin_loads() {
-    TEST_BEGIN("plugin loads and exposes 7 parameters");
+    TEST_BEGIN("plugin loads and exposes 9 parameters");
     PluginInstance plugin;
     ASSERT_TRUE(createPlugin(plugin), "plugin constructed");
     ASSERT_NOT_NULL(plugin.factory(), "factory present");
     ASSERT_TRUE(std::strcmp(plugin.name(), "Noise Bouquet") == 0,
                 "factory name = 'Noise Bouquet'");
-    ASSERT_EQ(plugin.numParameters(), 7, "7 parameters defined");
+    ASSERT_EQ(plugin.numParameters(), 9, "9 parameters defined");
     TEST_PASS();
 }
 
@@ -270,7 +293,8 @@ TestResult test_unrouted_no_crash() {
 /// Helper: fully complete the crossfade triggered by a program change so
 /// subsequent measurements reflect the new algorithm at unity gain.
 static void waitForSwitch(PluginInstance& plugin) {
-    // 30 ms fade-out + 30 ms fade-in = 60 ms; round up generously.
+    // A few blocks to build the new program + the 30 ms crossfade; round
+    // up generously.
     int blocks = (int)(NtTestHarness::getSampleRate() * 0.10f / BLOCK_SIZE);
     for (int i = 0; i < blocks; ++i) plugin.step(BLOCK_SIZE);
 }
@@ -336,6 +360,86 @@ TestResult test_program_switch_to_teensy_alt() {
     TEST_PASS();
 }
 
+TestResult test_program_switch_has_no_gap() {
+    TEST_BEGIN("Program change crossfades without a silent gap");
+    PluginInstance plugin;
+    ASSERT_TRUE(createPlugin(plugin), "plugin constructed");
+    plugin.setParameter(kParamProgram, kProg_TestPlugin);
+
+    // WhiteNoise keeps playing while TestPlugin is built, then the two
+    // overlap: no block of the switch may drop out.
+    float minPeak = 1.0f;
+    for (int i = 0; i < blocksFor(0.1f); ++i) {
+        plugin.step(BLOCK_SIZE);
+        float p = PluginInstance::peak(plugin.getBus(OUTPUT_BUS, BLOCK_SIZE), BLOCK_SIZE);
+        if (p < minPeak) minPeak = p;
+    }
+    ASSERT_GT(minPeak, 0.05f, "every block of the switch is audible");
+    TEST_PASS();
+}
+
+// -----------------------------------------------------------------------------
+// Dual engine
+// -----------------------------------------------------------------------------
+
+static bool createDualPlugin(PluginInstance& plugin) {
+    static const int32_t specs[] = { 2 };
+    if (!plugin.load(0)) return false;
+    plugin.initStatic();
+    return plugin.construct(specs);
+}
+
+TestResult test_dual_engine_separate_outputs() {
+    TEST_BEGIN("Two engines play their own programs on their own outputs");
+    PluginInstance plugin;
+    ASSERT_TRUE(createDualPlugin(plugin), "plugin constructed");
+    ASSERT_EQ(plugin.numParameters(), (int)kNumParamsDual, "second engine's parameters");
+    ASSERT_EQ(plugin.getParameter(kParamOut2), OUTPUT_BUS_2 + 1, "second engine on output 2");
+
+    // Both engines switch at once: the second waits for the first.
+    plugin.setParameter(kParamProgram, kProg_TestPlugin);
+    plugin.setParameter(kParamProgram2, kProg_TeensyAlt);
+    waitForSwitch(plugin);
+    waitForSwitch(plugin);
+
+    float peakA = 0.0f, peakB = 0.0f, diff = 0.0f;
+    for (int i = 0; i < 32; ++i) {
+        plugin.step(BLOCK_SIZE);
+        const float* a = plugin.getBus(OUTPUT_BUS, BLOCK_SIZE);
+        const float* b = plugin.getBus(OUTPUT_BUS_2, BLOCK_SIZE);
+        peakA = std::max(peakA, PluginInstance::peak(a, BLOCK_SIZE));
+        peakB = std::max(peakB, PluginInstance::peak(b, BLOCK_SIZE));
+        for (int k = 0; k < BLOCK_SIZE; ++k) diff = std::max(diff, std::fabs(a[k] - b[k]));
+    }
+    ASSERT_GT(peakA, 0.05f, "first engine audible");
+    ASSERT_GT(peakB, 0.01f, "second engine audible");
+    ASSERT_GT(diff, 0.01f, "engines play different programs");
+
+    plugin.setParameter(kParamGain2, 0);
+    for (int i = 0; i < 8; ++i) plugin.step(BLOCK_SIZE);
+    ASSERT_LT(PluginInstance::peak(plugin.getBus(OUTPUT_BUS_2, BLOCK_SIZE), BLOCK_SIZE),
+              1e-6f, "second engine's gain is its own");
+    ASSERT_GT(PluginInstance::peak(plugin.getBus(OUTPUT_BUS, BLOCK_SIZE), BLOCK_SIZE),
+              0.05f, "first engine unaffected");
+    TEST_PASS();
+}
+
+TestResult test_dual_engine_switch_leaves_other_playing() {
+    TEST_BEGIN("A program change on one engine leaves the other playing");
+    PluginInstance plugin;
+    ASSERT_TRUE(createDualPlugin(plugin), "plugin constructed");
+    plugin.setParameter(kParamProgram, kProg_TestPlugin);
+
+    float minPeak = 1.0f;
+    for (int i = 0; i < blocksFor(0.1f); ++i) {
+        plugin.step(BLOCK_SIZE);
+        float p = PluginInstance::peak(plugin.getBus(OUTPUT_BUS_2, BLOCK_SIZE), BLOCK_SIZE);
+        if (p < minPeak) minPeak = p;
+    }
+    ASSERT_GT(minPeak, 0.05f, "second engine audible through the switch");
+    TEST_PASS();
+}
+
 TestResult test_xy_changes_are_smoothed() {
     TEST_BEGIN("X/Y parameter changes ramp over multiple blocks");
     PluginInstance plugin;
@@ -385,7 +489,7 @@ TestResult test_bank1_first_slot_audible() {
 }
 
 TestResult test_parameter_string_program_names() {
-    TEST_BEGIN("parameterString returns Bank/Program names");
+    TEST_BEGIN("parameterString returns Bank/Program names with CPU marks");
     PluginInstance plugin;
     ASSERT_TRUE(createPlugin(plugin), "plugin constructed");
 
@@ -403,6 +507,7 @@ TestResult test_parameter_string_program_names() {
     ASSERT_TRUE(str(kParamBank, 1) == "Bank 1", "Bank 1 label");
 
     // Program names need the current Bank in v[]; createPlugin defaults to Bank 4.
+    // Mid- and high-cost programs carry a " +" / " ++" CPU mark.
     ASSERT_TRUE(str(kParamProgram, kProg_TestPlugin) == "TestPlugin",
                 "Program 1 = TestPlugin");
     ASSERT_TRUE(str(kParamProgram, kProg_WhiteNoise) == "WhiteNoise",
@@ -413,25 +518,25 @@ TestResult test_parameter_string_program_names() {
                 "empty Bank-4 slot shows '--'");
 
     plugin.setParameter(kParamBank, kBank2);
-    ASSERT_TRUE(str(kParamProgram, kProg_clusterSaw) == "clusterSaw",
+    ASSERT_TRUE(str(kParamProgram, kProg_clusterSaw) == "clusterSaw +",
                 "Bank 2 / Program 1 = clusterSaw");
-    ASSERT_TRUE(str(kParamProgram, kProg_PrimeCluster) == "PrimeCluster",
+    ASSERT_TRUE(str(kParamProgram, kProg_PrimeCluster) == "PrimeCluster ++",
                 "Bank 2 / Program 6 = PrimeCluster");
-    ASSERT_TRUE(str(kParamProgram, kProg_phasingCluster) == "phasingCluster",
+    ASSERT_TRUE(str(kParamProgram, kProg_phasingCluster) == "phasingCluster ++",
                 "Bank 2 / Program 10 = phasingCluster");
 
     plugin.setParameter(kParamBank, kBank3);
-    ASSERT_TRUE(str(kParamProgram, kProg_BasuraTotal) == "BasuraTotal",
+    ASSERT_TRUE(str(kParamProgram, kProg_BasuraTotal) == "BasuraTotal ++",
                 "Bank 3 / Program 1 = BasuraTotal");
     ASSERT_TRUE(str(kParamProgram, kProg_arrayOnTheRocks) == "arrayOnTheRocks",
                 "Bank 3 / Program 5 = arrayOnTheRocks");
-    ASSERT_TRUE(str(kParamProgram, kProg_Rwalk_LFree) == "Rwalk_LFree",
+    ASSERT_TRUE(str(kParamProgram, kProg_Rwalk_LFree) == "Rwalk_LFree ++",
                 "Bank 3 / Program 10 = Rwalk_LFree");
 
     plugin.setParameter(kParamBank, kBank1);
     ASSERT_TRUE(str(kParamProgram, kProg_radioOhNo) == "radioOhNo",
                 "Bank 1 / Program 1 = radioOhNo");
-    ASSERT_TRUE(str(kParamProgram, kProg_resonoise) == "resonoise",
+    ASSERT_TRUE(str(kParamProgram, kProg_resonoise) == "resonoise +",
                 "Bank 1 / Program 6 = resonoise");
     ASSERT_TRUE(str(kParamProgram, kProg_basurilla) == "basurilla",
                 "Bank 1 / Program 10 = basurilla");
@@ -490,9 +595,9 @@ TestResult test_test_plugin_wav() {
                   NtTestHarness::getSampleRate(), 1);
     ASSERT_TRUE(wav.isOpen(), "WAV file opened");
 
-    // The first ~60 ms of the WAV is the fade-out of WhiteNoise into the
-    // fade-in of TestPlugin — deterministic and useful for ear-checking the
-    // crossfade.
+    // The first ~35 ms of the WAV holds the build of TestPlugin and its
+    // crossfade with WhiteNoise — deterministic and useful for ear-checking
+    // the crossfade.
     float peak = renderToWav(plugin, wav, 1.0f);
     wav.close();
     ASSERT_GT(peak, 0.05f, "TestPlugin produces audio after switch");
@@ -690,7 +795,9 @@ TestResult test_bank1_all_slots_audible() {
     for (const auto& check : checks) {
         selectProgram(plugin, kBank1, check.program);
         float maxPeak = 0.0f;
-        for (int i = 0; i < 16; ++i) {
+        // grainGlitchII is silent until it has captured its first grain,
+        // ~130 ms after it is built into a fresh arena.
+        for (int i = 0; i < 48; ++i) {
             plugin.step(BLOCK_SIZE);
             const float* bus = plugin.getBus(OUTPUT_BUS, BLOCK_SIZE);
             float p = PluginInstance::peak(bus, BLOCK_SIZE);
@@ -776,6 +883,208 @@ TestResult test_bank3_all_slots_audible() {
     TEST_PASS();
 }
 
+// -----------------------------------------------------------------------------
+// Block pull (NoisePlethoraPlugin::pullSpan)
+// -----------------------------------------------------------------------------
+
+/// Emits a running int16 counter, one AUDIO_BLOCK_SAMPLES block at a time.
+class RampPlugin : public NoisePlethoraPlugin {
+public:
+    int blocks = 0;
+    AudioStream& getStream() override { return stream; }
+    unsigned char getPort() override { return 0; }
+
+protected:
+    void processGraphAsBlock(TeensyBuffer& buffer) override {
+        int16_t data[AUDIO_BLOCK_SAMPLES];
+        for (int i = 0; i < AUDIO_BLOCK_SAMPLES; ++i) {
+            data[i] = (int16_t)(blocks * AUDIO_BLOCK_SAMPLES + i);
+        }
+        buffer.pushBuffer(data, AUDIO_BLOCK_SAMPLES);
+        ++blocks;
+    }
+
+private:
+    AudioStream stream{0};
+};
+
+TestResult test_pull_span_matches_sample_pull() {
+    TEST_BEGIN("pullSpan() hands out the same stream as processGraph()");
+    RampPlugin ramp;
+    int expected = 0;
+    bool inOrder = true;
+    bool withinLimit = true;
+    // Mix span sizes that straddle block boundaries with single-sample pulls.
+    const int sizes[] = { 50, 1, 100, 128, 77, 3, 300 };
+    for (int round = 0; round < 8; ++round) {
+        for (int size : sizes) {
+            int left = size;
+            while (left > 0) {
+                const int16_t* span = nullptr;
+                const int n = ramp.pullSpan(&span, left);
+                if (n < 1 || n > left) withinLimit = false;
+                for (int k = 0; k < n; ++k) {
+                    if (span[k] != (int16_t)expected++) inOrder = false;
+                }
+                left -= n;
+            }
+            const float f = ramp.processGraph();
+            if (f != int16_to_float_1v((int16_t)expected++)) inOrder = false;
+        }
+    }
+    ASSERT_TRUE(withinLimit, "spans are 1..maxFrames long");
+    ASSERT_TRUE(inOrder, "spans and single pulls continue the same stream");
+    ASSERT_EQ(ramp.blocks, (expected + AUDIO_BLOCK_SAMPLES - 1) / AUDIO_BLOCK_SAMPLES,
+              "one processGraphAsBlock() per 128 samples");
+    TEST_PASS();
+}
+
+// -----------------------------------------------------------------------------
+// Resampler (PolyphaseResampler, 44.1 kHz -> 48 kHz)
+// -----------------------------------------------------------------------------
+
+/// Emits a sine (or DC with freq = 0) at the algorithms' 44.1 kHz rate.
+class TonePlugin : public NoisePlethoraPlugin {
+public:
+    double freq  = 0.0;
+    double level = 0.5;
+    AudioStream& getStream() override { return stream; }
+    unsigned char getPort() override { return 0; }
+
+protected:
+    void processGraphAsBlock(TeensyBuffer& buffer) override {
+        int16_t data[AUDIO_BLOCK_SAMPLES];
+        for (int i = 0; i < AUDIO_BLOCK_SAMPLES; ++i) {
+            data[i] = (int16_t)(32767.0 * level * std::cos(phase));
+            phase += 2.0 * M_PI * freq / 44100.0;
+        }
+        buffer.pushBuffer(data, AUDIO_BLOCK_SAMPLES);
+    }
+
+private:
+    AudioStream stream{0};
+    double phase = 0.0;
+};
+
+/// Amplitude of the `freq` component of x (Goertzel).
+static double toneLevel(const float* x, int n, double freq, double fs) {
+    const double c = 2.0 * std::cos(2.0 * M_PI * freq / fs);
+    double s1 = 0.0, s2 = 0.0;
+    for (int i = 0; i < n; ++i) {
+        const double s = x[i] + c * s1 - s2;
+        s2 = s1;
+        s1 = s;
+    }
+    return std::sqrt(s1 * s1 + s2 * s2 - c * s1 * s2) / (n * 0.5);
+}
+
+/// Renders `n` 48 kHz frames of `tone` at the given quality.
+static void resampleTone(TonePlugin& tone, PolyphaseResampler::Quality q,
+                         std::vector<float>& out, int n) {
+    static PolyphaseKernels kernels; // ~25 kB of tables: keep them off the stack
+    static PolyphaseResampler rs;
+    kernels.init(44100.0f / 48000.0f);
+    rs.init(&kernels);
+    rs.setQuality(q);
+    out.assign(n, 0.0f);
+    // Uneven spans, as the crossfade segments hand out.
+    int k = 0;
+    for (int span = 1; k < n; span = span % PolyphaseResampler::kMaxSpan + 7) {
+        const int m = (n - k < span) ? n - k : span;
+        rs.render(&tone, out.data() + k, m);
+        k += m;
+    }
+}
+
+TestResult test_resampler_retune_matches_init() {
+    TEST_BEGIN("retuning the kernels for a new host rate matches a rebuild");
+    static PolyphaseKernels retuned, built; // ~25 kB each: keep them off the stack
+    retuned.init(44100.0f / 48000.0f);
+    ASSERT_TRUE(retuned.retune(44100.0f / 96000.0f), "48k -> 96k keeps the tables");
+    built.init(44100.0f / 96000.0f);
+    ASSERT_TRUE(retuned.ratio() == built.ratio(), "ratio follows the host rate");
+    for (int taps : { 8, 16 }) {
+        ASSERT_TRUE(std::memcmp(retuned.rows(taps), built.rows(taps),
+                                (PolyphaseKernels::kPhases + 1) * taps * sizeof(float)) == 0,
+                    "tables identical to a rebuild");
+    }
+    ASSERT_TRUE(!retuned.retune(44100.0f / 32000.0f), "a host below 44.1 kHz wants another cutoff");
+    TEST_PASS();
+}
+
+TestResult test_resampler_unity_dc() {
+    TEST_BEGIN("resampler passes DC at unity gain at every quality");
+    std::vector<float> out;
+    for (int q = 0; q < PolyphaseResampler::kNumQualities; ++q) {
+        TonePlugin dc;
+        resampleTone(dc, (PolyphaseResampler::Quality)q, out, 4800);
+        float worst = 0.0f;
+        for (int i = 64; i < (int)out.size(); ++i) {
+            worst = std::max(worst, std::fabs(out[i] - 0.5f));
+        }
+        ASSERT_TRUE(worst < 1e-3f, "DC level preserved");
+    }
+    TEST_PASS();
+}
+
+TestResult test_resampler_image_rejection() {
+    TEST_BEGIN("sinc resampling rejects the 44.1 kHz images");
+    // A 10 kHz tone images at 44.1 - 10 kHz, which folds to 13.9 kHz at 48 kHz.
+    const double image = 48000.0 - (44100.0 - 10000.0);
+    double levels[PolyphaseResampler::kNumQualities];
+    std::vector<float> out;
+    for (int q = 0; q < PolyphaseResampler::kNumQualities; ++q) {
+        TonePlugin tone;
+        tone.freq = 10000.0;
+        resampleTone(tone, (PolyphaseResampler::Quality)q, out, 48000);
+        const int skip = 4800;
+        const double wanted = toneLevel(out.data() + skip, 48000 - skip, tone.freq, 48000.0);
+        ASSERT_TRUE(wanted > 0.4, "10 kHz passband within 2 dB");
+        levels[q] = toneLevel(out.data() + skip, 48000 - skip, image, 48000.0) / wanted;
+    }
+    ASSERT_TRUE(levels[PolyphaseResampler::kLinear] > 0.03, "linear images audibly (above -30 dB)");
+    ASSERT_TRUE(levels[PolyphaseResampler::kSinc8] < 0.001, "8-tap image below -60 dB");
+    ASSERT_TRUE(levels[PolyphaseResampler::kSinc16] < levels[PolyphaseResampler::kSinc8],
+                "16-tap rejects more than 8-tap");
+    TEST_PASS();
+}
+
+// -----------------------------------------------------------------------------
+// Native render rate ("Render rate" = Host)
+// -----------------------------------------------------------------------------
+
+/// Zero crossings of TestPlugin's sine over `blocks` blocks.
+static int sineCrossings(PluginInstance& plugin, int blocks) {
+    int crossings = 0;
+    for (int i = 0; i < blocks; ++i) {
+        plugin.step(BLOCK_SIZE);
+        crossings += countZeroCrossings(plugin.getBus(OUTPUT_BUS, BLOCK_SIZE), BLOCK_SIZE);
+    }
+    return crossings;
+}
+
+TestResult test_native_rate_keeps_pitch() {
+    TEST_BEGIN("native render rate keeps the 44.1 kHz pitch");
+    PluginInstance plugin;
+    ASSERT_TRUE(createPlugin(plugin), "plugin constructed");
+    selectProgram(plugin, kBank4, kProg_TestPlugin);
+    plugin.setParameter(kParamX, 4900);  // 2401 Hz, clear of the sample grid
+    plugin.setParameter(kParamY, 6000);  // sine
+    waitForSwitch(plugin);
+    const int resampled = sineCrossings(plugin, 100);
+
+    // Rebuilds TestPlugin against the host rate, through the crossfade.
+    plugin.setParameter(kParamRenderRate, 1);
+    waitForSwitch(plugin);
+    const int native = sineCrossings(plugin, 100);
+
+    // 100 blocks of a 2.4 kHz sine at 48 kHz cross zero ~640 times; a unit
+    // still stepping at 44.1 kHz would run 8.8% sharp.
+    ASSERT_GT(resampled, 600, "sine audible before the switch");
+    ASSERT_TRUE(std::abs(native - resampled) <= 4, "same pitch at the host rate");
+    TEST_PASS();
+}
+
 // =============================================================================
 // Regression: golden SHA-256 hashes for all WAV outputs
 // (Verbatim port of PolyLofi/tests/test_integration.cpp::test_golden_wav_hashes)
@@ -855,6 +1164,51 @@ TestResult test_golden_wav_hashes() {
     TEST_PASS();
 }
 
+// =============================================================================
+// Performance baseline: the golden renders re-run and timed per WAV scenario
+// =============================================================================
+TestResult test_perf_baseline() {
+    TEST_BEGIN("Performance baseline (cycles/frame vs tests/perf_baseline.txt)");
+    const bool withinBudget = PerfRegistry::check("tests/perf_baseline.txt", {
+        test_white_noise_default_wav,
+        test_white_noise_half_gain_wav,
+        test_test_plugin_wav,
+        test_teensy_alt_wav,
+        test_cluster_saw_wav,
+        test_pw_cluster_wav,
+        test_cr_cluster2_wav,
+        test_sine_fm_cluster_wav,
+        test_tri_fm_cluster_wav,
+        test_prime_cluster_wav,
+        test_prime_cnoise_wav,
+        test_fibonacci_cluster_wav,
+        test_partial_cluster_wav,
+        test_phasing_cluster_wav,
+        test_basura_total_wav,
+        test_atari_wav,
+        test_walking_filomena_wav,
+        test_s_h_wav,
+        test_array_on_the_rocks_wav,
+        test_existencels_pain_wav,
+        test_who_knows_wav,
+        test_satan_workout_wav,
+        test_rwalk_bitcrush_pw_wav,
+        test_rwalk_lfree_wav,
+        test_radio_oh_no_wav,
+        test_rwalk_sine_fm_flange_wav,
+        test_xmod_ring_sqr_wav,
+        test_xmod_ring_sine_wav,
+        test_cross_mod_ring_wav,
+        test_resonoise_wav,
+        test_grain_glitch_wav,
+        test_grain_glitch_ii_wav,
+        test_grain_glitch_iii_wav,
+        test_basurilla_wav,
+    });
+    ASSERT_TRUE(withinBudget, "no render scenario slower than baseline tolerance");
+    TEST_PASS();
+}
+
 // =============================================================================
 // Main
 // =============================================================================
@@ -909,6 +1263,7 @@ int main() {
 
         // Regression check (comes after all WAV writers)
         test_golden_wav_hashes,
+        test_perf_baseline,
 
         // Lifecycle and functional tests (order doesn't affect golden hashes)
         test_plugin_loads,
@@ -921,11 +1276,29 @@ int main() {
         // Bank/Program switching (M2a)
         test_program_switch_to_test_plugin,
         test_program_switch_to_teensy_alt,
+        test_program_switch_has_no_gap,
+        test_dual_engine_separate_outputs,
+        test_dual_engine_switch_leaves_other_playing,
         test_xy_changes_are_smoothed,
         test_bank1_first_slot_audible,
         test_parameter_string_program_names,
         test_bank1_all_slots_audible,
         test_bank2_all_slots_audible,
         test_bank3_all_slots_audible,
+
+        // Block pull
+        test_pull_span_matches_sample_pull,
+
+        // Resampler
+        test_resampler_retune_matches_init,
+        test_resampler_unity_dc,
+        test_resampler_image_rejection,
+
+        // Native render rate
+        test_native_rate_keeps_pitch,
+
+        // Cluster oscillator bank
+        test_waveform_bank_matches_graph,
+        test_freeverb_matches_reference,
     });
 }
@@ -0,0 +1,141 @@
+// =============================================================================
+// tools/ProgramProfile.cpp  —  host-side CPU/memory profile of every program
+// =============================================================================
+// Builds each registry entry on its own in a zeroed arena, the way the plugin
+// does, and renders a sweep of X/Y settings at 44.1 kHz. Prints one line per
+// program: arena bytes, ns per 128-sample block (mean and worst block over
+// the sweep), cost relative to WhiteNoise and the cost class that ratio
+// falls in, next to the class recorded in PluginRegistry.hpp.
+//
+// Host nanoseconds are not NT cycles, but the ratios between programs carry
+// over well enough to rank them. Lines marked '!' disagree with the
+// registry; rerun before editing it, the boundaries are not sharp.
+//
+//   make profile
+//   ./bin/ProgramProfile 5          # passes over the sweep (default 3)
+// =============================================================================
+
+#include "../include/PluginRegistry.hpp"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+namespace NtTestHarness {
+    void setSampleRate(uint32_t sr);
+}
+
+// Sweep: kSteps x kSteps X/Y points, kBlocks blocks rendered at each after
+// a short settle.
+static constexpr int kSteps  = 5;
+static constexpr int kSettle = 4;
+static constexpr int kBlocks = 32;
+
+// Cost classes, as multiples of WhiteNoise's mean block time.
+static constexpr double kMidRatio  = 6.0;
+static constexpr double kHighRatio = 10.0;
+
+struct Profile {
+    double meanNs = 0.0;
+    double maxNs  = 0.0;
+};
+
+alignas(np_registry::kMaxAlgoAlign) static uint8_t arena[np_registry::kMaxAlgoSize];
+
+static double renderBlock(NoisePlethoraPlugin* algo, float x, float y) {
+    const auto t0 = std::chrono::steady_clock::now();
+    algo->process(x, y);
+    int n = 0;
+    while (n < AUDIO_BLOCK_SAMPLES) {
+        const int16_t* span;
+        n += algo->pullSpan(&span, AUDIO_BLOCK_SAMPLES - n);
+    }
+    const auto t1 = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::nano>(t1 - t0).count();
+}
+
+// One pass over the sweep from a fresh build. Every pass starts from the
+// same state, so taking the fastest of several filters out host noise.
+static Profile profilePass(const np_registry::Entry& e) {
+    std::memset(arena, 0, e.sizeOf);
+    NoisePlethoraPlugin* algo = e.factory(arena);
+    algo->init();
+
+    Profile p;
+    double total = 0.0;
+    int blocks = 0;
+    for (int i = 0; i < kSteps; ++i) {
+        for (int j = 0; j < kSteps; ++j) {
+            const float x = (float)i / (kSteps - 1);
+            const float y = (float)j / (kSteps - 1);
+            for (int b = 0; b < kSettle; ++b) renderBlock(algo, x, y);
+            for (int b = 0; b < kBlocks; ++b) {
+                const double ns = renderBlock(algo, x, y);
+                total += ns;
+                if (ns > p.maxNs) p.maxNs = ns;
+                ++blocks;
+            }
+        }
+    }
+    p.meanNs = total / blocks;
+    e.destroy(algo);
+    return p;
+}
+
+static Profile profile(const np_registry::Entry& e, int passes) {
+    Profile best = profilePass(e);
+    for (int k = 1; k < passes; ++k) {
+        const Profile p = profilePass(e);
+        if (p.meanNs < best.meanNs) best.meanNs = p.meanNs;
+        if (p.maxNs < best.maxNs) best.maxNs = p.maxNs;
+    }
+    return best;
+}
+
+static np_registry::Cost classify(double ratio) {
+    if (ratio >= kHighRatio) return np_registry::kCostHigh;
+    if (ratio >= kMidRatio)  return np_registry::kCostMid;
+    return np_registry::kCostLow;
+}
+
+static const char* costName(np_registry::Cost c) {
+    switch (c) {
+        case np_registry::kCostHigh: return "high";
+        case np_registry::kCostMid:  return "mid";
+        default:                     return "low";
+    }
+}
+
+int main(int argc, char** argv) {
+    const int passes = (argc > 1) ? std::atoi(argv[1]) : 3;
+    NtTestHarness::setSampleRate(44100);
+    nt_shim::setSampleRate(44100.0f);
+
+    Profile results[np_registry::kNumEntries];
+    for (size_t i = 0; i < np_registry::kNumEntries; ++i) {
+        results[i] = profile(np_registry::kEntries[i], passes < 1 ? 1 : passes);
+    }
+    const np_registry::Entry* ref = np_registry::find(4, 2);
+    const double refNs = results[ref - np_registry::kEntries].meanNs;
+
+    printf("%-5s %-20s %7s %10s %10s %7s  %-5s %-8s\n",
+           "prog", "name", "bytes", "mean ns", "max ns", "x ref", "class", "registry");
+    int disagree = 0;
+    for (size_t i = 0; i < np_registry::kNumEntries; ++i) {
+        const np_registry::Entry& e = np_registry::kEntries[i];
+        const Profile& p = results[i];
+        const double ratio = p.meanNs / refNs;
+        const np_registry::Cost c = classify(ratio);
+        const bool differs = c != e.cost;
+        disagree += differs;
+        printf("%d.%-3d %-20s %7u %10.0f %10.0f %7.1f  %-5s %-8s%s\n",
+               e.bank, e.slot, e.name, (unsigned)e.sizeOf, p.meanNs, p.maxNs, ratio,
+               costName(c), costName(e.cost), differs ? " !" : "");
+    }
+    printf("\narena: %u bytes (largest program), align %u\n",
+           (unsigned)np_registry::kMaxAlgoSize, (unsigned)np_registry::kMaxAlgoAlign);
+    printf("classes: mid >= %.0fx, high >= %.0fx WhiteNoise; %d differ from the registry\n",
+           kMidRatio, kHighRatio, disagree);
+    return 0;
+}
@@ -101,8 +101,8 @@ struct _OneiroiAlgorithm_DTC
     PatchState patchState;
 	Oneiroi* Oneiroi_;
 	AudioBuffer* buffer;
+	Arena arena;
 	float semi= 0.f, fine=0.f, v8c = 0.f, prevClockValue = 0.f, pitchInput=0.f;
-	uint8_t dtcMemory[_allocatableDTCMemorySize];
 	int16_t undoStack[UNDO_STACK_SIZE][NUM_UNDOABLE_PARAMS];
     // Invariant: undoStack[undoCursor] always matches the live parameter values.
     // undoCursor == -1 means no history exists yet.
@@ -112,11 +112,19 @@ struct _OneiroiAlgorithm_DTC
     // Looper file loading
     _NT_wavRequest wavReq     = {};    // must persist until callback fires
     bool     wavLoading       = false;
+    bool     wavPendingRead   = false; // step() issues wavReq once streaming stopped
     uint32_t wavFileFrames    = 0;     // frames requested (known before callback)
     bool     wavPendingSet    = false; // step() reads this to apply length param
     int16_t  wavPendingLen    = 0;     // pending kParamlooperLength value
     int      looperFolder     = 0;
     int      looperFile       = 0;
+
+    // Looper streaming, for files longer than the looper buffer
+    _NT_wavRequest streamReq  = {};    // must persist until callback fires
+    uint32_t streamFolder     = 0;
+    uint32_t streamSample     = 0;
+    uint32_t streamPendingFrames = 0;  // step() opens a stream of this length
+    bool     streamPendingStop = false; // step() stops streaming
 };
 
 struct _OneiroiAlgorithm : public _NT_algorithm
@@ -346,21 +354,27 @@ static void wavLoadCallback(void* data, bool success) {
 
     FloatArray* buf = dtc->Oneiroi_->GetLooperFloatArray();
     float* bufData  = buf->getData();
+    float* fileData = bufData + kLooperChannelBufferLength; // where the file was read
     uint32_t fileFrames = dtc->wavFileFrames;
 
-    // Tile L channel to fill the full channel buffer if file is shorter than ~5.46 s.
+    // Tile the file to fill a channel's worth of frames if it is shorter than ~5.46 s.
     if (fileFrames < (uint32_t)kLooperChannelBufferLength) {
         uint32_t pos = fileFrames;
         while (pos < (uint32_t)kLooperChannelBufferLength) {
             uint32_t toCopy = (uint32_t)kLooperChannelBufferLength - pos;
             if (toCopy > fileFrames) toCopy = fileFrames;
-            memcpy(bufData + pos, bufData, toCopy * sizeof(float));
+            memcpy(fileData + pos, fileData, toCopy * sizeof(float));
             pos += toCopy;
         }
     }
 
-    // Mirror L to R so the looper plays the file on both channels.
-    memcpy(bufData + kLooperChannelBufferLength, bufData, kLooperChannelBufferLength * sizeof(float));
+    // Spread it to both channels of the interleaved buffer. Going forward,
+    // frame i only overwrites file samples before i, which are already read.
+    for (int32_t i = 0; i < kLooperChannelBufferLength; i++) {
+        float v = fileData[i];
+        bufData[i * 2] = v;
+        bufData[i * 2 + 1] = v;
+    }
 
     // Compute the looper length parameter value that best matches the file duration.
     // lengthLUT_ maps 0..1 → kLooperLoopLengthMin..kLooperChannelBufferLength using x^3 (expo y=3).
@@ -380,12 +394,147 @@ static void wavLoadCallback(void* data, bool success) {
     dtc->wavPendingSet = true;
 }
 
+// ---------------------------------------------------------------------------
+// Looper stream callback
+// Called from the SD card thread when a stream window has been read.
+// ---------------------------------------------------------------------------
+static void streamLoadCallback(void* data, bool success) {
+    auto* dtc = static_cast<_OneiroiAlgorithm_DTC*>(data);
+    dtc->Oneiroi_->GetLooperStream()->Loaded(success);
+}
+
+// Starts/stops the looper stream as requested by parameterChanged() and
+// issues the read for the next stream window, if one is needed.
+static void serviceLooperStream(_OneiroiAlgorithm_DTC* dtc) {
+    LooperStream* stream = dtc->Oneiroi_->GetLooperStream();
+    if (stream->IsLoading() || dtc->wavLoading)
+        return;
+
+    if (dtc->streamPendingStop) {
+        dtc->streamPendingStop = false;
+        dtc->Oneiroi_->StopLooperStream();
+    }
+    if (dtc->wavPendingRead) {
+        // The stream was playing from the buffer the file is read into.
+        dtc->wavPendingRead = false;
+        if (NT_readSampleFrames(dtc->wavReq))
+            dtc->wavLoading = true;
+        return;
+    }
+    if (dtc->streamPendingFrames > 0) {
+        dtc->Oneiroi_->StartLooperStream((int32_t)dtc->streamPendingFrames);
+        dtc->streamPendingFrames = 0;
+    }
+
+    LooperStream::Request request;
+    if (!NT_isSdCardMounted() || !stream->NextRequest(request))
+        return;
+
+    dtc->streamReq.folder       = dtc->streamFolder;
+    dtc->streamReq.sample       = dtc->streamSample;
+    dtc->streamReq.dst          = request.dst;
+    dtc->streamReq.numFrames    = (uint32_t)request.frames;
+    dtc->streamReq.startOffset  = (uint32_t)request.start;
+    dtc->streamReq.channels     = kNT_WavMono;
+    dtc->streamReq.bits         = kNT_WavBits32;
+    dtc->streamReq.progress     = kNT_WavNoProgress;
+    dtc->streamReq.callback     = streamLoadCallback;
+    dtc->streamReq.callbackData = dtc;
+    if (!NT_readSampleFrames(dtc->streamReq))
+        stream->Loaded(false);
+}
+
+enum
+{
+	kSpecAmbienceRate,
+	kNumSpecs,
+};
+
+// Ambience rate: 0 = full, 1 = half, 2 = quarter sample rate for the reverb
+// network (see Ambience).
+static const _NT_specification specifications[] = {
+	{ .name = "Ambience rate", .min = 0, .max = 2, .def = 0, .type = kNT_typeGeneric },
+};
+
+static void setupPatchState(PatchState& state, const int32_t* specifications)
+{
+	state.sampleRate = NT_globals.sampleRate;
+	state.blockSize = NT_globals.maxFramesPerStep;
+	state.blockRate = NT_globals.sampleRate/NT_globals.maxFramesPerStep;
+	state.ambienceDecimation = 1 << specifications[kSpecAmbienceRate];
+}
+
+// Everything an instance allocates, in allocation order. construct() runs it
+// against the real arena; reserveEngine() counts the same allocations for
+// calculateRequirements(), so the two must change together.
+static Oneiroi* createEngine(Arena& arena, PatchCtrls* patchCtrls, PatchCvs* patchCvs, PatchState* patchState, AudioBuffer** buffer)
+{
+	*buffer = NTSampleBuffer::create(arena, 2, patchState->blockSize);
+	return Oneiroi::create(arena, patchCtrls, patchCvs, patchState);
+}
+
+// DTC arena region starts after the (aligned) DTC struct.
+static constexpr size_t kDtcArenaOffset = Arena::Align(sizeof(_OneiroiAlgorithm_DTC));
+
+// Dry run: count what createEngine() would allocate at the current sample
+// rate and block size, without building anything.
+static void reserveEngine(Arena& sizing, const int32_t* specifications)
+{
+	PatchState patchState = {};
+	setupPatchState(patchState, specifications);
+	NTSampleBuffer::reserve(sizing, 2, patchState.blockSize);
+	Oneiroi::reserve(sizing, &patchState);
+}
+
+// The hot reserve of the most recent sizing and what it was sized for. The
+// host calls calculateRequirements() just before construct(), which picks
+// the reserve up from here instead of sizing the engine a second time.
+static struct
+{
+	int32_t ambienceRate = -1;
+	uint32_t sampleRate = 0;
+	uint32_t maxFramesPerStep = 0;
+	size_t hotReserve = 0;
+} lastSizing;
+
+// The first pass measures the Placement::Hot working set, the second reserves
+// DTC for it and lets the Auto allocations share what is left.
+static Arena sizeEngine(const int32_t* specifications)
+{
+	Arena hot(Arena::kDtcBudget);
+	reserveEngine(hot, specifications);
+	Arena sizing(hot.hotUsed());
+	reserveEngine(sizing, specifications);
+
+	lastSizing.ambienceRate = specifications[kSpecAmbienceRate];
+	lastSizing.sampleRate = NT_globals.sampleRate;
+	lastSizing.maxFramesPerStep = NT_globals.maxFramesPerStep;
+	lastSizing.hotReserve = sizing.hotReserve();
+
+	return sizing;
+}
+
+// The hot reserve calculateRequirements() sized these specifications with.
+static size_t hotReserveFor(const int32_t* specifications)
+{
+	if (lastSizing.ambienceRate != specifications[kSpecAmbienceRate] ||
+		lastSizing.sampleRate != NT_globals.sampleRate ||
+		lastSizing.maxFramesPerStep != NT_globals.maxFramesPerStep)
+	{
+		sizeEngine(specifications);
+	}
+
+	return lastSizing.hotReserve;
+}
+
 void calculateRequirements( _NT_algorithmRequirements& req, const int32_t* specifications )
 {
+	Arena sizing = sizeEngine(specifications);
+
 	req.numParameters = ARRAY_SIZE(parameters);
 	req.sram = sizeof(_OneiroiAlgorithm);
-	req.dram = _allocatableMemorySize;
-	req.dtc = sizeof(_OneiroiAlgorithm_DTC);
+	req.dram = sizing.dramUsed();
+	req.dtc = kDtcArenaOffset + sizing.dtcUsed();
 	req.itc = 0;
 }
 
@@ -393,14 +542,8 @@ _NT_algorithm*	construct( const _NT_algorithmMemoryPtrs& ptrs, const _NT_algorit
 {
 	_OneiroiAlgorithm_DTC* dtc = new (ptrs.dtc) _OneiroiAlgorithm_DTC();
 	_OneiroiAlgorithm* alg = new (ptrs.sram) _OneiroiAlgorithm( (_OneiroiAlgorithm_DTC*)ptrs.dtc );
-	_allocatedMemory = 0;
-	_allocatedDTCMemory = 0;
-	_allocatableMemory = ptrs.dram;
-	_allocatableDTCMemory = &(dtc->dtcMemory[0]);
-    alg->dtc->patchState.sampleRate = NT_globals.sampleRate;
-	alg->dtc->patchState.blockSize =  NT_globals.maxFramesPerStep;
-	alg->dtc->patchState.blockRate =  NT_globals.sampleRate/NT_globals.maxFramesPerStep;
-	alg->dtc->buffer = NTSampleBuffer::create(2, NT_globals.maxFramesPerStep);
+	dtc->arena = Arena(ptrs.dram, req.dram, ptrs.dtc + kDtcArenaOffset, req.dtc - kDtcArenaOffset, hotReserveFor(specifications));
+	setupPatchState(alg->dtc->patchState, specifications);
 	auto & pc = alg->dtc->patchCtrls;
 	pc.oscPitch = 261.63f;
 	pc.osc2Vol = 0.9f;
@@ -423,7 +566,7 @@ _NT_algorithm*	construct( const _NT_algorithmMemoryPtrs& ptrs, const _NT_algorit
     alg->dtc->patchCvs.filterResonance = 0.f;
 	alg->dtc->patchCvs.filterCutoff = 0.f;
 	
-	alg->dtc->Oneiroi_ = Oneiroi::create(&alg->dtc->patchCtrls, &alg->dtc->patchCvs, &alg->dtc->patchState);
+	alg->dtc->Oneiroi_ = createEngine(dtc->arena, &alg->dtc->patchCtrls, &alg->dtc->patchCvs, &alg->dtc->patchState, &alg->dtc->buffer);
 	alg->parameters = parameters;
 	alg->parameterPages = &parameterPages;
 	alg->dtc->patchState.startupPhase = StartupPhase::STARTUP_DONE;
@@ -493,10 +636,12 @@ void step( _NT_algorithm* self, float* busFrames, int numFramesBy4 )
 	// Apply deferred looper length parameter (set by wavLoadCallback on SD thread)
 	if (dtc->wavPendingSet) {
 		dtc->wavPendingSet = false;
+		dtc->Oneiroi_->LooperBufferLoaded();
 		NT_setParameterFromAudio(NT_algorithmIndex(self),
 		                         kParamlooperLength + NT_parameterOffset(),
 		                         dtc->wavPendingLen);
 	}
+	serviceLooperStream(dtc);
 
 	int numFrames = numFramesBy4 * 4;
 	float* outL = busFrames + ( pThis->v[kParamLeftOutput] - 1 ) * numFrames;
@@ -506,22 +651,15 @@ void step( _NT_algorithm* self, float* busFrames, int numFramesBy4 )
 
 	NTSampleBuffer* myBuffer = static_cast<NTSampleBuffer*>(dtc->buffer); 
 	myBuffer->setSize(numFrames);
-    myBuffer->clear();
-	FloatArray chLArray = myBuffer->getSamples(LEFT_CHANNEL); 
-	FloatArray chRArray = myBuffer->getSamples(RIGHT_CHANNEL); 
-	
-	if (pThis->v[kParamLeftInput] > 0 && pThis->v[kParamRightInput] > 0){
-		float* inL = busFrames + ( pThis->v[kParamLeftInput] - 1 ) * numFrames;
-	    float* inR = busFrames + ( pThis->v[kParamRightInput] - 1 ) * numFrames;
-		for ( int i=0; i<numFrames; ++i ){
-		chRArray[i] = inR[i];
-		chLArray[i] = inL[i];
-		}
-	} else if (pThis->v[kParamLeftInput] > 0){
-		float* inL = busFrames + ( pThis->v[kParamLeftInput] - 1 ) * numFrames;
-		for ( int i=0; i<numFrames; ++i ){
-		chRArray[i] = inL[i];
-		chLArray[i] = inL[i];
+
+	// Inputs are read and outputs written by Oneiroi::Process() directly.
+	const float* inL = nullptr;
+	const float* inR = nullptr;
+	if (pThis->v[kParamLeftInput] > 0){
+		inL = busFrames + ( pThis->v[kParamLeftInput] - 1 ) * numFrames;
+		inR = inL;
+		if (pThis->v[kParamRightInput] > 0){
+			inR = busFrames + ( pThis->v[kParamRightInput] - 1 ) * numFrames;
 		}
 	}
     if(pThis->v[kParamClockInput] > 0){
@@ -540,32 +678,7 @@ void step( _NT_algorithm* self, float* busFrames, int numFramesBy4 )
 
 	dtc->patchCtrls.oscPitch = 261.63f * semi2Ratio(pThis->dtc->semi) * semi2Ratio(pThis->dtc->fine/100.f) *semi2Ratio(pThis->dtc->v8c*12.f) * semi2Ratio(pThis->dtc->pitchInput*12.f); 
 	
-    dtc->Oneiroi_->Process(*myBuffer);
-	if ( !replaceR )
-	{ // are these loops really faster than putting the if inside?
-		for ( int i=0; i<numFrames; ++i ){
-			outR[i] += chRArray[i];
-		}
-	}
-	else
-	{
-		for ( int i=0; i<numFrames; ++i ){
-			outR[i] = chRArray[i];
-		}
-	}
-
-	if ( !replaceL )
-	{ 
-		for ( int i=0; i<numFrames; ++i ){
-			outL[i] += chLArray[i];
-		}
-	}
-	else
-	{
-		for ( int i=0; i<numFrames; ++i ){
-			outL[i] =chLArray[i];
-		}
-	}
+    dtc->Oneiroi_->Process(inL, inR, *myBuffer, outL, outR, replaceL, replaceR);
 }
 // do this in custom ui
 void parameterChanged( _NT_algorithm* self, int p )
@@ -778,17 +891,29 @@ void parameterChanged( _NT_algorithm* self, int p )
     case kParamLooperFile: {
         dtc->looperFile = pThis->v[p];
         int fileVal = pThis->v[p];
-        if (fileVal > 0 && !dtc->wavLoading && NT_isSdCardMounted()) {
+        if (fileVal > 0 && !dtc->wavLoading && !dtc->wavPendingRead && !dtc->Oneiroi_->GetLooperStream()->IsLoading() && NT_isSdCardMounted()) {
             _NT_wavInfo info;
             NT_getSampleFileInfo((uint32_t)dtc->looperFolder, (uint32_t)(fileVal - 1), info);
-            if (info.numFrames > 0) {
+            if (info.numFrames > (uint32_t)kLooperChannelBufferLength) {
+                // Too long for the buffer: stream it from the card. step()
+                // opens the stream, the loop spans the whole file.
+                uint32_t frames = info.numFrames;
+                if (frames > (uint32_t)kLooperStreamMaxFrames)
+                    frames = (uint32_t)kLooperStreamMaxFrames;
+                dtc->streamFolder = (uint32_t)dtc->looperFolder;
+                dtc->streamSample = (uint32_t)(fileVal - 1);
+                dtc->streamPendingStop = false;
+                dtc->streamPendingFrames = frames;
+                dtc->wavPendingLen = 1000;
+                dtc->wavPendingSet = true;
+            } else if (info.numFrames > 0) {
                 uint32_t frames = info.numFrames;
-                if (frames > (uint32_t)kLooperChannelBufferLength)
-                    frames = (uint32_t)kLooperChannelBufferLength;
+                dtc->streamPendingFrames = 0;
+                dtc->streamPendingStop = true;
                 FloatArray* buf = dtc->Oneiroi_->GetLooperFloatArray();
                 dtc->wavReq.folder      = (uint32_t)dtc->looperFolder;
                 dtc->wavReq.sample      = (uint32_t)(fileVal - 1);
-                dtc->wavReq.dst         = buf->getData();
+                dtc->wavReq.dst         = buf->getData() + kLooperChannelBufferLength;
                 dtc->wavReq.numFrames   = frames;
                 dtc->wavReq.startOffset = 0;
                 dtc->wavReq.channels    = kNT_WavMono;
@@ -797,7 +922,11 @@ void parameterChanged( _NT_algorithm* self, int p )
                 dtc->wavReq.callback    = wavLoadCallback;
                 dtc->wavReq.callbackData = dtc;
                 dtc->wavFileFrames = frames;
-                if (NT_readSampleFrames(dtc->wavReq))
+                // Never read into the buffer under an open stream, step()
+                // closes it first.
+                if (dtc->Oneiroi_->GetLooperStream()->IsOpen())
+                    dtc->wavPendingRead = true;
+                else if (NT_readSampleFrames(dtc->wavReq))
                     dtc->wavLoading = true;
             }
         }
@@ -883,11 +1012,12 @@ bool	draw( _NT_algorithm* self )
     NT_floatToString(debugc, pThis->dtc->patchState.debugvalue4);	
 	NT_drawText( 180, 50, debugc );
 
-	NT_floatToString(debugc, ((float)_allocatedMemory/_allocatableMemorySize));	
+	// Arena footprint in kB
+	NT_floatToString(debugc, pThis->dtc->arena.dramUsed() / 1024.f);	
 	NT_drawText( 10, 35, "DRAM:" );
 	NT_drawText( 60, 35, debugc );
 
-	NT_floatToString(debugc, ((float)_allocatedDTCMemory/_allocatableDTCMemorySize));	
+	NT_floatToString(debugc, pThis->dtc->arena.dtcUsed() / 1024.f);	
 	NT_drawText( 100, 35, "DTC:" );
 	NT_drawText( 140, 35, debugc );
 		
@@ -938,8 +1068,8 @@ static const _NT_factory factory =
 	.guid = NT_MULTICHAR( 'B', 'o', 'O', 'I' ),
 	.name = "Oneiroi",
 	.description = "Oneiroi from Befaco",
-	.numSpecifications = 0,
-	.specifications = NULL,
+	.numSpecifications = kNumSpecs,
+	.specifications = specifications,
 	.calculateRequirements = calculateRequirements,
 	.construct = construct,
 	.parameterChanged = parameterChanged,
@@ -0,0 +1,77 @@
+#pragma once
+
+#include "Commons.h"
+
+/**
+ * @brief Decides whether an effect has to run this block.
+ *        A closed mix control means the effect is not heard, so it does not
+ *        run at all. With the mix open it runs while there is input, and
+ *        after the input stops until its wet output has stayed below
+ *        kActivitySleepEnergy for holdSamples. Then it sleeps: its buffers
+ *        are not cleared, whatever is left in them is below the threshold.
+ *        Input above the threshold wakes it on the same block.
+ *
+ *        holdSamples should cover the longest silent gap the effect can
+ *        produce on its own (e.g. its maximum delay time).
+ */
+class ActivityTracker
+{
+private:
+    int holdBlocks_;
+    int quietBlocks_;
+    bool awake_;
+
+public:
+    ActivityTracker(int32_t holdSamples, size_t blockSize)
+    {
+        holdBlocks_ = holdSamples / blockSize + 1;
+        quietBlocks_ = 0;
+        awake_ = false;
+    }
+    ~ActivityTracker() {}
+
+    static ActivityTracker* create(Arena& arena, int32_t holdSamples, size_t blockSize)
+    {
+        return new (arena) ActivityTracker(holdSamples, blockSize);
+    }
+
+    static void reserve(Arena& arena)
+    {
+        arena.reserve(sizeof(ActivityTracker));
+    }
+
+    static void destroy(ActivityTracker* obj)
+    {
+        //delete obj;
+    }
+
+    // Call before processing with the mean square of the effect's input.
+    // Returns true if the effect has to run.
+    bool Wake(float vol, float inputEnergy)
+    {
+        if (vol <= 0.f)
+        {
+            awake_ = false;
+        }
+        else if (inputEnergy >= kActivitySleepEnergy)
+        {
+            awake_ = true;
+            quietBlocks_ = 0;
+        }
+
+        return awake_;
+    }
+
+    // Call after processing with the wet energy (mean square) of the block.
+    void Update(float inputEnergy, float wetEnergy)
+    {
+        if (inputEnergy >= kActivitySleepEnergy || wetEnergy >= kActivitySleepEnergy)
+        {
+            quietBlocks_ = 0;
+        }
+        else if (++quietBlocks_ >= holdBlocks_)
+        {
+            awake_ = false;
+        }
+    }
+};
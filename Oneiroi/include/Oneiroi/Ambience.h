@@ -7,6 +7,7 @@
 #include "EnvFollower.h"
 #include "DcBlockingFilter.h"
 #include "Compressor.h"
+#include "Polyphase.h"
 
 class Damp
 {
@@ -16,7 +17,7 @@ private:
     int hp_, lp_, fHp_, fLp_;
 
 public:
-    Damp(float sampleRate)
+    Damp(Arena& arena, float sampleRate)
     {
         hi_ = 0;
         lo_ = 0;
@@ -24,8 +25,8 @@ public:
         lp_ = 60;
         fHp_ = M2F(hp_);
         fLp_ = M2F(lp_);
-        highShelf = BiquadFilter::create(sampleRate);
-        lowShelf = BiquadFilter::create(sampleRate);
+        highShelf = BiquadFilter::create(arena, sampleRate);
+        lowShelf = BiquadFilter::create(arena, sampleRate);
     }
     ~Damp()
     {
@@ -33,9 +34,16 @@ public:
         BiquadFilter::destroy(lowShelf);
     }
 
-    static Damp* create(float sampleRate)
+    static Damp* create(Arena& arena, float sampleRate)
     {
-        return new Damp(sampleRate);
+        return new (arena, Placement::Hot) Damp(arena, sampleRate);
+    }
+
+    static void reserve(Arena& arena)
+    {
+        arena.reserve(sizeof(Damp), Placement::Hot);
+        BiquadFilter::reserve(arena);
+        BiquadFilter::reserve(arena);
     }
 
     static void destroy(Damp* damp)
@@ -98,11 +106,12 @@ public:
 class Diffuse
 {
 public:
-    Diffuse()
+    Diffuse(Arena& arena, int decimation)
     {
+        decimation_ = decimation;
         for (int i = 0; i < kAmbienceNofDiffusers; i++)
         {
-            diffuse_[i] = DelayLine::create(kAmbienceBufferSize);
+            diffuse_[i] = DelayLine::create(arena, kAmbienceBufferSize / decimation_);
         }
 
         fbOut_ = 0.f;
@@ -120,9 +129,18 @@ public:
         }
     }
 
-    static Diffuse* create()
+    static Diffuse* create(Arena& arena, int decimation = 1)
+    {
+        return new (arena, Placement::Hot) Diffuse(arena, decimation);
+    }
+
+    static void reserve(Arena& arena, int decimation = 1)
     {
-        return new Diffuse();
+        arena.reserve(sizeof(Diffuse), Placement::Hot);
+        for (int i = 0; i < kAmbienceNofDiffusers; i++)
+        {
+            DelayLine::reserve(arena, kAmbienceBufferSize / decimation);
+        }
     }
 
     static void destroy(Diffuse* diffuse)
@@ -135,10 +153,10 @@ public:
         size_ = size;
         for (size_t i = 0; i < kAmbienceNofDiffusers - 1; i++)
         {
-            newDelayTimes_[i] = M2D(size + 2.f * (i + 1));
+            newDelayTimes_[i] = M2D(size + 2.f * (i + 1)) / decimation_;
         }
 
-        newDelayTimes_[kAmbienceNofDiffusers - 1] = M2D(size - 7.f);
+        newDelayTimes_[kAmbienceNofDiffusers - 1] = M2D(size - 7.f) / decimation_;
         SetRT(time_);
         needsUpdate_ = true;
     }
@@ -146,7 +164,7 @@ public:
     void SetRT(float time)
     {
         time_ = time;
-        rt_ = Db2A((delayTimes_[kAmbienceNofDiffusers - 1] / M2D(time)) * -60.f);
+        rt_ = Db2A((delayTimes_[kAmbienceNofDiffusers - 1] * decimation_ / M2D(time)) * -60.f);
         if (rt_ >= kOne) {
             rt_ = 1.f;
         }
@@ -200,15 +218,86 @@ private:
     DelayLine *diffuse_[kAmbienceNofDiffusers];
     float delayTimes_[kAmbienceNofDiffusers], newDelayTimes_[kAmbienceNofDiffusers];
     float size_, time_, rt_, df_, fbOut_, outs_[kAmbienceNofDiffusers];
+    int decimation_;
     bool needsUpdate_;
 }; // End Diffuse
 
+/**
+ * @brief Takes a signal down to fs / factor and back up through cascaded
+ *        half-band polyphase stages, factor being 2 or 4. The stage
+ *        filters are the same allpass pairs in both directions, so the
+ *        round trip has no latency beyond their phase response.
+ */
+class RateConverter
+{
+public:
+    RateConverter(int factor)
+    {
+        stages_ = factor >> 1;
+        for (int i = 0; i < stages_; i++)
+        {
+            down_[i].init();
+            up_[i].init();
+        }
+    }
+    ~RateConverter() {}
+
+    static RateConverter* create(Arena& arena, int factor)
+    {
+        return new (arena, Placement::Hot) RateConverter(factor);
+    }
+
+    static void reserve(Arena& arena)
+    {
+        arena.reserve(sizeof(RateConverter), Placement::Hot);
+    }
+
+    static void destroy(RateConverter* obj)
+    {
+        //delete obj;
+    }
+
+    // Consumes factor input samples.
+    inline float Down(const float* in)
+    {
+        float a = down_[0].downsample(in[0], in[1]);
+        if (1 == stages_)
+        {
+            return a;
+        }
+        float b = down_[0].downsample(in[2], in[3]);
+
+        return down_[1].downsample(a, b);
+    }
+
+    // Produces factor output samples.
+    inline void Up(float in, float* out)
+    {
+        if (1 == stages_)
+        {
+            up_[0].upsample(in, out[0], out[1]);
+
+            return;
+        }
+        float a, b;
+        up_[1].upsample(in, a, b);
+        up_[0].upsample(a, out[0], out[1]);
+        up_[0].upsample(b, out[2], out[3]);
+    }
+
+private:
+    // Stage 0 is between fs and fs / 2, stage 1 between fs / 2 and fs / 4.
+    Polyphase2x down_[2];
+    Polyphase2x up_[2];
+    int stages_;
+}; // End RateConverter
+
 class ReversedBuffer
 {
 public:
-    ReversedBuffer(int32_t s) : s_{s}
+    ReversedBuffer(Arena& arena, int32_t s) : s_{s}
     {
-        line_ = FloatArray::create(s);
+        line_ = FloatArray::create(arena, s, Placement::Bulk);
         i_ = 0; // Input pointer
         o_ = s_ - 1; // Output pointer
         bs_ = s_ >> 1; // Reverse max block size is half the buffer size
@@ -221,9 +310,15 @@ public:
         FloatArray::destroy(line_);
     }
 
-    static ReversedBuffer* create(int32_t size)
+    static ReversedBuffer* create(Arena& arena, int32_t size)
     {
-        return new ReversedBuffer(size);
+        return new (arena, Placement::Hot) ReversedBuffer(arena, size);
+    }
+
+    static void reserve(Arena& arena, int32_t size)
+    {
+        arena.reserve(sizeof(ReversedBuffer), Placement::Hot);
+        FloatArray::reserve(arena, size, Placement::Bulk);
     }
 
     static void destroy(ReversedBuffer* line)
@@ -309,10 +404,14 @@ private:
     EnvFollower* ef_[2];
     Compressor* comp_[2];
     DcBlockingFilter* dc_[2];
+    RateConverter* converters_[2];
+
+    int decimation_;
 
     float amp_, pan_, decay_, spaceTime_;
     float reverse_;
     float xi_;
+    float wetEnergy_;
 
     Lut<float, 32> decayLUT{0.f, -160.f, Lut<float, 32>::Type::LUT_TYPE_EXPO};
 
@@ -415,22 +514,71 @@ private:
         }
     }
 
+    // One sample of the reverb network, at fs / decimation_.
+    inline void ProcessNetwork(float lIn, float rIn, float r, float x, float& left, float& right)
+    {
+        left = reversers_[LEFT_CHANNEL]->LastOut() * reverse_ + lIn * r;
+        right = reversers_[RIGHT_CHANNEL]->LastOut() * reverse_ + rIn * r;
+
+        reversers_[LEFT_CHANNEL]->Process(lIn);
+        reversers_[RIGHT_CHANNEL]->Process(rIn);
+
+        float leftFb = dampFilters_[LEFT_CHANNEL]->Process(left + diffusers_[RIGHT_CHANNEL]->GetFbOut());
+        float rightFb = dampFilters_[RIGHT_CHANNEL]->Process(right + diffusers_[LEFT_CHANNEL]->GetFbOut());
+
+        leftFb = HardClip(left * (1.f - pan_) + leftFb);
+        rightFb = HardClip(right * pan_ + rightFb);
+
+        leftFb *= 1.f - ef_[LEFT_CHANNEL]->process(leftFb);
+        rightFb *= 1.f - ef_[RIGHT_CHANNEL]->process(rightFb);
+
+        leftFb = dc_[LEFT_CHANNEL]->process(leftFb);
+        rightFb = dc_[RIGHT_CHANNEL]->process(rightFb);
+
+        left = diffusers_[LEFT_CHANNEL]->Process(leftFb, x);
+        right = diffusers_[RIGHT_CHANNEL]->Process(rightFb, x);
+    }
+
+    // Compressor and dry/wet mix of one output sample, at fs.
+    inline void ProcessOutput(float lIn, float rIn, float left, float right, float a, float& energy, float& leftOut, float& rightOut)
+    {
+        left = comp_[LEFT_CHANNEL]->process(left * a) * kAmbienceMakeupGain;
+        right = comp_[RIGHT_CHANNEL]->process(right * a) * kAmbienceMakeupGain;
+        energy += left * left + right * right;
+
+        leftOut = CheapEqualPowerCrossFade(lIn, left, patchCtrls_->ambienceVol, 1.4f);
+        rightOut = CheapEqualPowerCrossFade(rIn, right, patchCtrls_->ambienceVol, 1.4f);
+    }
+
 public:
-    Ambience(PatchCtrls* patchCtrls, PatchCvs* patchCvs, PatchState* patchState)
+    Ambience(Arena& arena, PatchCtrls* patchCtrls, PatchCvs* patchCvs, PatchState* patchState)
     {
         patchCtrls_ = patchCtrls;
         patchCvs_ = patchCvs;
         patchState_ = patchState;
 
+        // The reverb network (reversers, damping, diffusers) can run at
+        // fs / decimation_; the dry path and the compressors stay at fs.
+        decimation_ = patchState_->ambienceDecimation;
+        float networkRate = patchState_->sampleRate / decimation_;
+
         for (size_t i = 0; i < 2; i++)
         {
-            dampFilters_[i] = Damp::create(patchState_->sampleRate);
-            diffusers_[i] = Diffuse::create();
-            reversers_[i] = ReversedBuffer::create(kAmbienceBufferSize);
-            ef_[i] = EnvFollower::create();
-            dc_[i] = DcBlockingFilter::create();
-            comp_[i] = Compressor::create(patchState_->sampleRate);
+            dampFilters_[i] = Damp::create(arena, networkRate);
+            diffusers_[i] = Diffuse::create(arena, decimation_);
+            reversers_[i] = ReversedBuffer::create(arena, kAmbienceBufferSize / decimation_);
+            ef_[i] = EnvFollower::create(arena);
+            dc_[i] = DcBlockingFilter::create(arena);
+            comp_[i] = Compressor::create(arena, patchState_->sampleRate);
             comp_[i]->setThreshold(-20);
+            converters_[i] = nullptr;
+            if (decimation_ > 1)
+            {
+                // Keep the follower and the blocker time constants.
+                ef_[i]->setLambda(powf(EnvFollower::kDefaultLambda, decimation_));
+                dc_[i]->setTimeConstant(dc_[i]->getTimeConstant() / decimation_);
+                converters_[i] = RateConverter::create(arena, decimation_);
+            }
         }
 
         dampFilters_[LEFT_CHANNEL]->SetHp(112);
@@ -439,11 +587,12 @@ public:
         dampFilters_[RIGHT_CHANNEL]->SetHp(96);
         dampFilters_[RIGHT_CHANNEL]->SetLp(51);
 
-        panner_ = SineOscillator::create(patchState_->blockRate);
+        panner_ = SineOscillator::create(arena, patchState_->blockRate);
 
         amp_ = 1.f;
         pan_ = 0.5f;
-        xi_ = 1.f / patchState_->blockSize;
+        xi_ = (float)decimation_ / patchState_->blockSize;
+        wetEnergy_ = 0;
     }
     ~Ambience()
     {
@@ -455,13 +604,34 @@ public:
             EnvFollower::destroy(ef_[i]);
             DcBlockingFilter::destroy(dc_[i]);
             Compressor::destroy(comp_[i]);
+            RateConverter::destroy(converters_[i]);
         }
         SineOscillator::destroy(panner_);
     }
 
-    static Ambience* create(PatchCtrls* patchCtrls, PatchCvs* patchCvs, PatchState* patchState)
+    static Ambience* create(Arena& arena, PatchCtrls* patchCtrls, PatchCvs* patchCvs, PatchState* patchState)
     {
-        return new Ambience(patchCtrls, patchCvs, patchState);
+        return new (arena, Placement::Hot) Ambience(arena, patchCtrls, patchCvs, patchState);
+    }
+
+    static void reserve(Arena& arena, PatchState* patchState)
+    {
+        int decimation = patchState->ambienceDecimation;
+        arena.reserve(sizeof(Ambience), Placement::Hot);
+        for (size_t i = 0; i < 2; i++)
+        {
+            Damp::reserve(arena);
+            Diffuse::reserve(arena, decimation);
+            ReversedBuffer::reserve(arena, kAmbienceBufferSize / decimation);
+            EnvFollower::reserve(arena);
+            DcBlockingFilter::reserve(arena);
+            Compressor::reserve(arena);
+            if (decimation > 1)
+            {
+                RateConverter::reserve(arena);
+            }
+        }
+        SineOscillator::reserve(arena);
     }
 
     static void destroy(Ambience* obj)
@@ -469,6 +639,12 @@ public:
         //delete obj;
     }
 
+    // Mean square of the wet signal over the last processed block.
+    float GetWetEnergy()
+    {
+        return wetEnergy_;
+    }
+
     void process(AudioBuffer &input, AudioBuffer &output)
     {
         size_t size = output.getSize();
@@ -491,45 +667,50 @@ public:
         }
 
         float r = 1.f - reverse_;
+        float a = Map(decay_, 0.f, 1.f, amp_ * 1.3f, amp_);
         float x = 0;
-        
-        for (size_t i = 0; i < size; i++)
-        {
-            float lIn = Clamp(leftIn[i], -3.f, 3.f);
-            float rIn = Clamp(rightIn[i], -3.f, 3.f);
-            
-            float left = reversers_[LEFT_CHANNEL]->LastOut() * reverse_ + lIn * r;
-            float right = reversers_[RIGHT_CHANNEL]->LastOut() * reverse_ + rIn * r;
-        
-            reversers_[LEFT_CHANNEL]->Process(lIn);
-            reversers_[RIGHT_CHANNEL]->Process(rIn);
-
-            float leftFb = dampFilters_[LEFT_CHANNEL]->Process(left + diffusers_[RIGHT_CHANNEL]->GetFbOut());
-            float rightFb = dampFilters_[RIGHT_CHANNEL]->Process(right + diffusers_[LEFT_CHANNEL]->GetFbOut());
-
-            leftFb = HardClip(left * (1.f - pan_) + leftFb);
-            rightFb = HardClip(right * pan_ + rightFb);
-            
-
-            leftFb *= 1.f - ef_[LEFT_CHANNEL]->process(leftFb);
-            rightFb *= 1.f - ef_[RIGHT_CHANNEL]->process(rightFb);
+        float energy = 0;
 
-            leftFb = dc_[LEFT_CHANNEL]->process(leftFb);
-            rightFb = dc_[RIGHT_CHANNEL]->process(rightFb);
-
-            left = diffusers_[LEFT_CHANNEL]->Process(leftFb, x);
-            right = diffusers_[RIGHT_CHANNEL]->Process(rightFb, x);
-            
-            x += xi_;
-
-            float a = Map(decay_, 0.f, 1.f, amp_ * 1.3f, amp_);
+        if (1 == decimation_)
+        {
+            for (size_t i = 0; i < size; i++)
+            {
+                float lIn = Clamp(leftIn[i], -3.f, 3.f);
+                float rIn = Clamp(rightIn[i], -3.f, 3.f);
 
-            left = comp_[LEFT_CHANNEL]->process(left * a) * kAmbienceMakeupGain;
-            right = comp_[RIGHT_CHANNEL]->process(right * a) * kAmbienceMakeupGain;
+                float left, right;
+                ProcessNetwork(lIn, rIn, r, x, left, right);
+                x += xi_;
 
-            leftOut[i] = CheapEqualPowerCrossFade(lIn, left, patchCtrls_->ambienceVol, 1.4f);
-            rightOut[i] = CheapEqualPowerCrossFade(rIn, right, patchCtrls_->ambienceVol, 1.4f);
+                ProcessOutput(lIn, rIn, left, right, a, energy, leftOut[i], rightOut[i]);
+            }
+        }
+        else
+        {
+            // Block sizes are multiples of 4.
+            float lIns[4], rIns[4], lWets[4], rWets[4];
+            for (size_t i = 0; i < size; i += decimation_)
+            {
+                for (int j = 0; j < decimation_; j++)
+                {
+                    lIns[j] = Clamp(leftIn[i + j], -3.f, 3.f);
+                    rIns[j] = Clamp(rightIn[i + j], -3.f, 3.f);
+                }
+
+                float left, right;
+                ProcessNetwork(converters_[LEFT_CHANNEL]->Down(lIns), converters_[RIGHT_CHANNEL]->Down(rIns), r, x, left, right);
+                x += xi_;
+
+                converters_[LEFT_CHANNEL]->Up(left, lWets);
+                converters_[RIGHT_CHANNEL]->Up(right, rWets);
+
+                for (int j = 0; j < decimation_; j++)
+                {
+                    ProcessOutput(lIns[j], rIns[j], lWets[j], rWets[j], a, energy, leftOut[i + j], rightOut[i + j]);
+                }
+            }
         }
+        wetEnergy_ = energy / size;
         diffusers_[LEFT_CHANNEL]->UpdateDelayTimes();
         diffusers_[RIGHT_CHANNEL]->UpdateDelayTimes();
     }
@@ -0,0 +1,229 @@
+#pragma once
+
+#include <cstddef>
+#include <new>
+#include <stdint.h>
+
+/**
+ * Where an allocation should live.
+ *
+ * Auto: the original Patch.h policy, small objects to DTC while it lasts.
+ * Hot:  state touched every sample (filter poles, delay taps, compressor and
+ *       follower state). Gets a DTC region reserved ahead of everything else.
+ * Cold: objects read at most once per block or only at setup. Always DRAM.
+ * Bulk: sample memory. Always DRAM.
+ *
+ * Factories pass the hint for the object they build, e.g.
+ * `new (arena, Placement::Hot) ResonatorBank(...)`. The hints are picked by hand
+ * and nothing feeds the measurements back into them: tools/ArenaReport.cpp
+ * prints where every allocation lands, so review it when the graph changes.
+ */
+enum class Placement : uint8_t
+{
+    Auto,
+    Hot,
+    Cold,
+    Bulk,
+};
+
+#ifdef ONEIROI_ARENA_REPORT
+struct ArenaRecord
+{
+    const void* site; // Return address inside the allocating factory
+    size_t size;
+    Placement placement;
+    bool dtc;
+};
+
+struct ArenaReport
+{
+    static constexpr size_t kMaxRecords = 1024;
+    ArenaRecord records[kMaxRecords];
+    size_t count = 0;
+};
+#endif
+
+/**
+ * Per-instance bump allocator for the Oneiroi object graph.
+ *
+ * Every create() factory takes the arena of the instance being built and
+ * allocates with `new (arena) T(...)`. Nothing is ever freed: the whole graph
+ * lives as long as the algorithm and the host reclaims the memory in one go.
+ *
+ * DTC is split in two: the first hotReserve bytes hold Placement::Hot
+ * allocations, the rest is shared by Auto allocations under
+ * kDtcMaxAllocation. Everything else goes to DRAM.
+ *
+ * A sizing arena is built with the hot reserve only and has no memory behind
+ * it. calculateRequirements() walks the engine's reserve() functions against
+ * one to learn its exact DRAM/DTC footprint: each reserve() mirrors its
+ * create() and counts the same allocations, in the same order and with the
+ * same hints, without constructing anything. Sizing with a reserve of
+ * kDtcBudget measures the hot working set itself. The host tests check that
+ * a real build lands exactly on the sized footprint.
+ */
+class Arena
+{
+public:
+    static constexpr size_t kAlign = 8;
+    static constexpr size_t kDtcMaxAllocation = 1200;
+    static constexpr size_t kDtcBudget = 10000;
+
+    // Sizing arena.
+    explicit Arena(size_t hotReserve = 0)
+    {
+        hotReserve_ = hotReserve < kDtcBudget ? hotReserve : kDtcBudget;
+    }
+
+    // Arena over the memory the host handed to construct(). hotReserve must
+    // match the sizing pass that produced dtcSize.
+    Arena(uint8_t* dram, size_t dramSize, uint8_t* dtc, size_t dtcSize, size_t hotReserve)
+    {
+        dram_ = dram;
+        dramSize_ = dramSize;
+        dtc_ = dtc;
+        dtcSize_ = dtcSize;
+        hotReserve_ = hotReserve;
+    }
+
+    // Object and filter state. Only a backed arena hands out memory; a sizing
+    // arena counts the request and returns nullptr.
+    void* allocate(size_t size, Placement placement = Placement::Auto)
+    {
+        return Place(Align(size), placement);
+    }
+
+    // Sample memory (delay lines, loop buffers, block buffers). Small block
+    // buffers may stay Auto; long lines that are only read at a few taps per
+    // sample should be Bulk.
+    void* allocateBuffer(size_t size, Placement placement = Placement::Auto)
+    {
+#ifdef ONEIROI_ARENA_REPORT
+        site_ = __builtin_return_address(0);
+#endif
+        return allocate(size, placement);
+    }
+
+    // Sizing pass: count an allocation the matching create() will make.
+    void reserve(size_t size, Placement placement = Placement::Auto)
+    {
+        Place(Align(size), placement);
+    }
+
+    size_t dramUsed() const
+    {
+        return dramUsed_;
+    }
+    // The hot region counts in full, so a backed arena given dtcUsed() bytes
+    // has the same layout as the sizing pass.
+    size_t dtcUsed() const
+    {
+        return hotReserve_ + sharedUsed_;
+    }
+    size_t hotUsed() const
+    {
+        return hotUsed_;
+    }
+    size_t hotReserve() const
+    {
+        return hotReserve_;
+    }
+    size_t dramSize() const
+    {
+        return dramSize_;
+    }
+    size_t dtcSize() const
+    {
+        return dtcSize_;
+    }
+
+#ifdef ONEIROI_ARENA_REPORT
+    void setReport(ArenaReport* report)
+    {
+        report_ = report;
+    }
+    void setSite(const void* site)
+    {
+        site_ = site;
+    }
+#endif
+
+    static constexpr size_t Align(size_t size)
+    {
+        return (size + kAlign - 1) & ~(kAlign - 1);
+    }
+
+private:
+    uint8_t* dram_ = nullptr;
+    uint8_t* dtc_ = nullptr;
+    size_t dramSize_ = 0;
+    size_t dtcSize_ = kDtcBudget;
+    size_t hotReserve_ = 0;
+    size_t dramUsed_ = 0;
+    size_t sharedUsed_ = 0;
+    size_t hotUsed_ = 0;
+#ifdef ONEIROI_ARENA_REPORT
+    ArenaReport* report_ = nullptr;
+    const void* site_ = nullptr;
+#endif
+
+    // A backed arena gets exactly the DTC its sizing pass used, so every
+    // allocation lands in the same region in both passes.
+    uint8_t* Place(size_t size, Placement placement)
+    {
+        uint8_t* base = dtc_;
+        size_t offset;
+        bool dtc = true;
+        if (placement == Placement::Hot && hotUsed_ + size <= hotReserve_)
+        {
+            offset = hotUsed_;
+            hotUsed_ += size;
+        }
+        else if (placement != Placement::Cold && placement != Placement::Bulk &&
+            size < kDtcMaxAllocation && hotReserve_ + sharedUsed_ + size <= dtcSize_)
+        {
+            offset = hotReserve_ + sharedUsed_;
+            sharedUsed_ += size;
+        }
+        else
+        {
+            base = dram_;
+            offset = dramUsed_;
+            dramUsed_ += size;
+            dtc = false;
+        }
+
+#ifdef ONEIROI_ARENA_REPORT
+        if (report_ != nullptr && report_->count < ArenaReport::kMaxRecords)
+        {
+            ArenaRecord& record = report_->records[report_->count++];
+            record.site = site_;
+            record.size = size;
+            record.placement = placement;
+            record.dtc = dtc;
+        }
+#else
+        (void)dtc;
+#endif
+
+        return base != nullptr ? base + offset : nullptr;
+    }
+};
+
+// noexcept, so a nullptr from a sizing arena skips the constructor instead of
+// running it on nothing.
+inline void* operator new(size_t size, Arena& arena, Placement placement = Placement::Auto) noexcept
+{
+#ifdef ONEIROI_ARENA_REPORT
+    arena.setSite(__builtin_return_address(0));
+#endif
+    return arena.allocate(size, placement);
+}
+
+inline void* operator new[](size_t size, Arena& arena, Placement placement = Placement::Auto) noexcept
+{
+#ifdef ONEIROI_ARENA_REPORT
+    arena.setSite(__builtin_return_address(0));
+#endif
+    return arena.allocate(size, placement);
+}
@@ -30,7 +30,7 @@ public:
     for(int i=0; i<getChannels(); ++i)
       getSamples(i).copyTo(other.getSamples(i));
   }
-  static AudioBuffer* create(int channels, int samples);
+  static AudioBuffer* create(Arena& arena, int channels, int samples);
   static void destroy(AudioBuffer* buffer);
 };
 
@@ -55,6 +55,14 @@ public:
     return state;
   }
 
+  /* one sample of a transposed direct form II stage, as BiquadFilter runs it */
+  static inline float step(float x, float b0, float b1, float b2, float a1, float a2, float& d1, float& d2){
+    float y = b0 * x + d1;
+    d1 = b1 * x + a1 * y + d2;
+    d2 = b2 * x + a2 * y;
+    return y;
+  }
+
   static void setLowPass(float* coefficients, float omega, float q){
     float K = tanf(omega);
     float norm = 1 / (1 + K / q + K * K);
@@ -284,10 +292,7 @@ public:
       float d1 = state[k*BIQUAD_STATE_VARIABLES_PER_STAGE];
       float d2 = state[k*BIQUAD_STATE_VARIABLES_PER_STAGE+1];
       for(size_t n=0; n<size; n++){ //manually apply filter, one stage
-        float out=b0 * input[n] + d1; 
-        d1 = b1 * input[n] + a1 * out + d2;
-        d2 = b2 * input[n] + a2 * out;
-        output[n]=out;
+        output[n] = FilterStage::step(input[n], b0, b1, b2, a1, a2, d1, d2);
         state[k*BIQUAD_STATE_VARIABLES_PER_STAGE]=d1;
         state[k*BIQUAD_STATE_VARIABLES_PER_STAGE+1]=d2;
       }
@@ -407,8 +412,17 @@ public:
     copyCoefficients(); //set all the other stages
   }
 
-  static BiquadFilter* create(float sr, size_t stages=1){
-    return new BiquadFilter(sr, new float[stages*BIQUAD_COEFFICIENTS_PER_STAGE], new float[stages*BIQUAD_STATE_VARIABLES_PER_STAGE], stages);
+  static BiquadFilter* create(Arena& arena, float sr, size_t stages=1){
+    // One allocation per statement, so the order is the one reserve() counts.
+    void* obj = operator new(sizeof(BiquadFilter), arena, Placement::Hot);
+    float* coefficients = new (arena, Placement::Hot) float[stages*BIQUAD_COEFFICIENTS_PER_STAGE];
+    float* state = new (arena, Placement::Hot) float[stages*BIQUAD_STATE_VARIABLES_PER_STAGE];
+    return new (obj) BiquadFilter(sr, coefficients, state, stages);
+  }
+  static void reserve(Arena& arena, size_t stages=1){
+    arena.reserve(sizeof(BiquadFilter), Placement::Hot);
+    arena.reserve(stages*BIQUAD_COEFFICIENTS_PER_STAGE*sizeof(float), Placement::Hot);
+    arena.reserve(stages*BIQUAD_STATE_VARIABLES_PER_STAGE*sizeof(float), Placement::Hot);
   }
 
   static void destroy(BiquadFilter* filter){
@@ -427,10 +441,10 @@ public:
   MultiBiquadFilter(float sr, float* coefs, float* states, size_t stages, BiquadFilter* filters, size_t len) :
     BiquadFilter(sr, coefs, states, stages), filters(filters), channels(len){}
   virtual ~MultiBiquadFilter(){}
-  static MultiBiquadFilter* create(float sr, size_t channels, size_t stages=1){
-    BiquadFilter* filters = new BiquadFilter[channels-1];
-    float* coefs = new float[stages*BIQUAD_COEFFICIENTS_PER_STAGE];
-    float* states = new float[stages*BIQUAD_STATE_VARIABLES_PER_STAGE*channels];
+  static MultiBiquadFilter* create(Arena& arena, float sr, size_t channels, size_t stages=1){
+    BiquadFilter* filters = new (arena, Placement::Hot) BiquadFilter[channels-1];
+    float* coefs = new (arena, Placement::Hot) float[stages*BIQUAD_COEFFICIENTS_PER_STAGE];
+    float* states = new (arena, Placement::Hot) float[stages*BIQUAD_STATE_VARIABLES_PER_STAGE*channels];
     FloatArray coefficients(coefs, stages*BIQUAD_COEFFICIENTS_PER_STAGE);
     float* mystate = states;
     for(size_t ch=1; ch<channels; ++ch){
@@ -440,7 +454,7 @@ public:
       filters[ch-1].setState(FloatArray(states, stages*BIQUAD_STATE_VARIABLES_PER_STAGE));
       filters[ch-1].setCoefficients(coefficients); // shared coefficients
     }
-    return new MultiBiquadFilter(sr, coefs, mystate, stages, filters, channels);
+    return new (arena, Placement::Hot) MultiBiquadFilter(sr, coefs, mystate, stages, filters, channels);
   }  
   static void destroy(MultiBiquadFilter* filter){
     ////delete[] filter->coefficients;
@@ -467,11 +481,11 @@ class StereoBiquadFilter : public MultiBiquadFilter {
 public:
   StereoBiquadFilter(float sr, float* coefs, float* states, size_t stages, BiquadFilter* filters) :
     MultiBiquadFilter(sr, coefs, states, stages, filters, 2) {}
-  static StereoBiquadFilter* create(float sr, size_t stages=1){
+  static StereoBiquadFilter* create(Arena& arena, float sr, size_t stages=1){
     size_t channels = 2;
-    BiquadFilter* filters = new BiquadFilter[channels-1];
-    float* coefs = new float[stages*BIQUAD_COEFFICIENTS_PER_STAGE];
-    float* states = new float[stages*BIQUAD_STATE_VARIABLES_PER_STAGE*channels];
+    BiquadFilter* filters = new (arena, Placement::Hot) BiquadFilter[channels-1];
+    float* coefs = new (arena, Placement::Hot) float[stages*BIQUAD_COEFFICIENTS_PER_STAGE];
+    float* states = new (arena, Placement::Hot) float[stages*BIQUAD_STATE_VARIABLES_PER_STAGE*channels];
     FloatArray coefficients(coefs, stages*BIQUAD_COEFFICIENTS_PER_STAGE);
     float* mystate = states;
     for(size_t ch=1; ch<channels; ++ch){
@@ -481,7 +495,7 @@ public:
       filters[ch-1].setState(FloatArray(states, stages*BIQUAD_STATE_VARIABLES_PER_STAGE));
       filters[ch-1].setCoefficients(coefficients); // shared coefficients
     }
-    return new StereoBiquadFilter(sr, coefs, mystate, stages, filters);
+    return new (arena, Placement::Hot) StereoBiquadFilter(sr, coefs, mystate, stages, filters);
   }
   static void destroy(StereoBiquadFilter* filter){
     MultiBiquadFilter::destroy(filter);
@@ -221,8 +221,8 @@ public:
     setAll(0);
   }
 
-  static CircularBuffer<DataType>* create(IndexType len){
-    CircularBuffer<DataType>* obj = new CircularBuffer<DataType>(new DataType[len], len);
+  static CircularBuffer<DataType>* create(Arena& arena, IndexType len){
+    CircularBuffer<DataType>* obj = new (arena) CircularBuffer<DataType>((DataType*)arena.allocateBuffer(len*sizeof(DataType)), len);
     obj->clear();
     return obj;
   }
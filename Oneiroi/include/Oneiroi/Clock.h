@@ -17,22 +17,28 @@ private:
     bool firstSyncIn_;
 
 public:
-    Clock(PatchCtrls* patchCtrls, PatchState* patchState)
+    Clock(Arena& arena, PatchCtrls* patchCtrls, PatchState* patchState)
     {
         patchCtrls_ = patchCtrls;
         patchState_ = patchState;
 
         clockSource_ = ClockSource::CLOCK_SOURCE_EXTERNAL;
 
-        patchState_->tempo = TapTempo::create(patchState_->blockRate, kLooperChannelBufferLength);
+        patchState_->tempo = TapTempo::create(arena, patchState_->blockRate, kLooperChannelBufferLength);
         patchState_->tempo->setFrequency(kInternalClockFreq);
         samplesSinceSyncIn_ = kExternalClockLimit;
     }
     ~Clock() {}
 
-    static Clock* create(PatchCtrls* patchCtrls, PatchState* patchState)
+    static Clock* create(Arena& arena, PatchCtrls* patchCtrls, PatchState* patchState)
     {
-        return new Clock(patchCtrls, patchState);
+        return new (arena, Placement::Cold) Clock(arena, patchCtrls, patchState);
+    }
+
+    static void reserve(Arena& arena)
+    {
+        arena.reserve(sizeof(Clock), Placement::Cold);
+        TapTempo::reserve(arena);
     }
 
     static void destroy(Clock* obj)
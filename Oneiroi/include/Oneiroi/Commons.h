@@ -81,6 +81,7 @@ static const float kLooperTriggerFadeSamplesR = 1.f / kLooperTriggerFadeSamples;
 static const int32_t kLooperTotalBufferLength = 1 << 19; // 524288 samples for both channels (interleaved) = 5.46 seconds stereo buffer
 //static const int32_t kLooperTotalBufferLength = 480000; // samples for both channels (interleaved) = ~8 seconds stereo buffer
 static const int32_t kLooperChannelBufferLength = kLooperTotalBufferLength / 2;
+static const int32_t kLooperStreamMaxFrames = 1 << 24; // ~5.8 minutes, start/length stay exact as floats
 constexpr float kLooperNoiseLevel = 0.2f;
 constexpr float kLooperInputGain = 1.f;
 constexpr float kLooperResampleGain = 1.f;
@@ -146,6 +147,8 @@ constexpr int32_t kEchoFadeSamples = 2400; // 50 ms @ audio rate
 constexpr int32_t kEchoMinLengthSamples = 480; // 10 ms @ audio rate
 constexpr int32_t kEchoMaxLengthSamples = 192000; // 4 seconds @ audio rate
 constexpr int kEchoTaps = 4;
+constexpr int kEchoLines = 2; // The taps of a channel share its line
+constexpr size_t kEchoBlockSamples = 64; // Processing chunk, must not exceed the shortest tap (see Echo::process)
 const float kEchoTapsRatios[kEchoTaps] = { 0.75f, 0.25f, 0.375f, 1.f };  // TAP_LEFT_A (1/2 dot), TAP_LEFT_B (1/8), TAP_RIGHT_A (1/8 dot), TAP_RIGHT_B (1)
 const float kEchoTapsFeedbacks[kEchoTaps] = { 0.35f, 0.65f, 0.55f, 0.45f };
 const int32_t kEchoMaxExternalClockSamples = kEchoMaxLengthSamples / kModClockRatios[kClockNofRatios - 1]; // Maximum period for the external clock
@@ -171,6 +174,7 @@ constexpr float kAmbienceMakeupGain = 1.2f;
 
 static const float kOutputFadeInc = 1.f / 16.f;
 constexpr float kOutputMakeupGain = 6.f;
+constexpr float kActivitySleepEnergy = 1e-8f; // Wet mean square below which an idle effect sleeps (-80 dBFS)
 
 constexpr float kParamCatchUpDelta = 0.005f;
 
@@ -305,6 +309,7 @@ struct PatchState
     float sampleRate;
     float blockRate;
     int blockSize;
+    int ambienceDecimation; // 1, 2 or 4, see Ambience
 
     FloatArray inputLevel;
     FloatArray efModLevel;
@@ -897,6 +902,21 @@ public:
         expoY_ = y;
     }
 
+    void SetRange(T min, T max)
+    {
+        min_ = min;
+        max_ = max;
+
+        if (LUT_TYPE_EXPO == type_)
+        {
+            Expo();
+        }
+        else if (LUT_TYPE_LINEAR == type_)
+        {
+            Linear();
+        }
+    }
+
     T GetValue(int pos)
     {
         return lut_[pos];
@@ -38,9 +38,14 @@ public:
 
     };
 
-    static Compressor* create(float sampleRate)
+    static Compressor* create(Arena& arena, float sampleRate)
     {
-        return new Compressor(sampleRate);
+        return new (arena, Placement::Hot) Compressor(sampleRate);
+    }
+
+    static void reserve(Arena& arena)
+    {
+        arena.reserve(sizeof(Compressor), Placement::Hot);
     }
 
     static void destroy(Compressor* obj)
@@ -94,6 +99,25 @@ public:
         return input * leftCv;
     }
 
+    // In place, same as process(float) on every sample.
+    void process(float* samples, size_t size)
+    {
+        float s1 = leftS1_;
+        for (size_t i = 0; i < size; i++)
+        {
+            float input = samples[i];
+            float sideInput = fabs(input);
+
+            float cte = (sideInput >= s1 ? cteAT_ : cteRL_);
+            s1 = sideInput + cte * (s1 - sideInput);
+
+            float cv = (s1 <= thrlin_ ? 1.f : powf(s1 * thrlinr_, expo_));
+
+            samples[i] = input * cv;
+        }
+        leftS1_ = s1;
+    }
+
     void process(AudioBuffer &input, AudioBuffer &output)
     {
         int size = input.getSize();
@@ -47,9 +47,9 @@ public:
     CircularBuffer<T>::write(in, len);
     delay(out, len, beginDelay + len, endDelay + len); // set delays relative to where we started writing
   }
-  static CrossFadingCircularBuffer<T>* create(size_t len, size_t blocksize){
+  static CrossFadingCircularBuffer<T>* create(Arena& arena, size_t len, size_t blocksize){
     CrossFadingCircularBuffer<T>* obj =
-      new CrossFadingCircularBuffer<T>(new T[len], len, FloatArray::create(blocksize));
+      new (arena) CrossFadingCircularBuffer<T>((T*)arena.allocateBuffer(len*sizeof(T)), len, FloatArray::create(arena, blocksize));
     obj->clear();
     return obj;
   }
@@ -13,7 +13,16 @@ private:
   float x1, y1;
   float R;
 public:
-  DcBlockingFilter(float R = 0.995): x1(0), y1(0), R(R) {}
+  static constexpr float DEFAULT_R = 0.995f;
+
+  DcBlockingFilter(float R = DEFAULT_R): x1(0), y1(0), R(R) {}
+
+  /* one sample on external state, for filters kept in lanes */
+  static inline float step(float x, float& x1, float& y1, float R = DEFAULT_R){
+    y1 = x - x1 + R*y1;
+    x1 = x;
+    return y1;
+  }
 
   /**
    * Get adaptation time constant in samples.
@@ -33,9 +42,7 @@ public:
 
   /* process a single sample and return the result */
   float process(float x){
-    y1 = x - x1 + R*y1;
-    x1 = x;
-    return y1;
+    return step(x, x1, y1, R);
   }
   
   void process(float* input, float* output, size_t size){
@@ -63,8 +70,11 @@ public:
     process(in, out, in.getSize());
   }
 
-  static DcBlockingFilter* create(float R=0.995){
-    return new DcBlockingFilter(R);
+  static DcBlockingFilter* create(Arena& arena, float R=DEFAULT_R){
+    return new (arena, Placement::Hot) DcBlockingFilter(R);
+  }
+  static void reserve(Arena& arena){
+    arena.reserve(sizeof(DcBlockingFilter), Placement::Hot);
   }
 
   static void destroy(DcBlockingFilter* obj){
@@ -76,7 +86,7 @@ class StereoDcBlockingFilter : public MultiSignalProcessor {
 private:
   DcBlockingFilter left, right;
 public:
-  StereoDcBlockingFilter(float R = 0.995): left(R), right(R) {}
+  StereoDcBlockingFilter(float R = DcBlockingFilter::DEFAULT_R): left(R), right(R) {}
 
   /**
    * Get adaptation time constant in samples.
@@ -97,8 +107,17 @@ public:
     right.process(input.getSamples(RIGHT_CHANNEL), output.getSamples(RIGHT_CHANNEL));
   }
 
-  static StereoDcBlockingFilter* create(float R=0.995){
-    return new StereoDcBlockingFilter(R);
+  /* process a single stereo frame in place */
+  void process(float& l, float& r){
+    l = left.process(l);
+    r = right.process(r);
+  }
+
+  static StereoDcBlockingFilter* create(Arena& arena, float R=DcBlockingFilter::DEFAULT_R){
+    return new (arena, Placement::Hot) StereoDcBlockingFilter(R);
+  }
+  static void reserve(Arena& arena){
+    arena.reserve(sizeof(StereoDcBlockingFilter), Placement::Hot);
   }
 
   static void destroy(StereoDcBlockingFilter* obj){
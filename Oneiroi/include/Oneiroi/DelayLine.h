@@ -3,6 +3,7 @@
 #include "Commons.h"
 #include "Interpolator.h"
 #include <stdint.h>
+#include <string.h>
 
 class DelayLine
 {
@@ -11,10 +12,10 @@ private:
     uint32_t size_, writeIndex_, delay_;
 
 public:
-    DelayLine(uint32_t size)
+    DelayLine(Arena& arena, uint32_t size)
     {
         size_ = size;
-        buffer_ = FloatArray::create(size_);
+        buffer_ = FloatArray::create(arena, size_, Placement::Bulk);
         delay_ = size_ - 1;
         writeIndex_ = 0;
     }
@@ -23,9 +24,15 @@ public:
         FloatArray::destroy(buffer_);
     }
 
-    static DelayLine* create(uint32_t size)
+    static DelayLine* create(Arena& arena, uint32_t size)
     {
-        return new DelayLine(size);
+        return new (arena, Placement::Hot) DelayLine(arena, size);
+    }
+
+    static void reserve(Arena& arena, uint32_t size)
+    {
+        arena.reserve(sizeof(DelayLine), Placement::Hot);
+        FloatArray::reserve(arena, size, Placement::Bulk);
     }
 
     static void destroy(DelayLine* line)
@@ -75,6 +82,62 @@ public:
         return v * (1.f - x) + read(index2) * x;
     }
 
+    /**
+     * @brief Block version of read(float): out[k] is what read(index) would
+     *        return after k more writes. The caller must not write in
+     *        between, so size must not exceed index + 1. Consecutive outputs
+     *        share a sample, so each costs one buffer load.
+     */
+    inline void read(float index, float* out, size_t size)
+    {
+        uint32_t idx = (uint32_t)index;
+        float frac = index - idx;
+
+        // Position of y1 for the first output; y0 is the one after it.
+        int32_t i = writeIndex_ - idx - 2;
+        while (i < 0)
+        {
+            i += size_;
+        }
+        float y1 = Clamp(buffer_[i], -3.f, 3.f);
+        i++;
+
+        size_t k = 0;
+        while (k < size)
+        {
+            if ((uint32_t)i >= size_)
+            {
+                i = 0;
+            }
+            size_t span = size - k < size_ - i ? size - k : size_ - i;
+            const float* src = buffer_.getData() + i;
+            for (size_t j = 0; j < span; j++)
+            {
+                float y0 = Clamp(src[j], -3.f, 3.f);
+                out[k + j] = Interpolator::linear(y0, y1, frac);
+                y1 = y0;
+            }
+            k += span;
+            i += span;
+        }
+    }
+
+    inline void write(const float* values, size_t size)
+    {
+        size_t k = 0;
+        while (k < size)
+        {
+            size_t span = size - k < size_ - writeIndex_ ? size - k : size_ - writeIndex_;
+            memcpy(buffer_.getData() + writeIndex_, values + k, span * sizeof(float));
+            k += span;
+            writeIndex_ += span;
+            if (writeIndex_ >= size_)
+            {
+                writeIndex_ -= size_;
+            }
+        }
+    }
+
     inline void write(float value, int stride = 1)
     {
         buffer_[writeIndex_] = value;
@@ -34,8 +34,8 @@ public:
   void process(FloatArray input, FloatArray output){
     buffer.delay(input, output, input.getSize(), delay);
   }
-  static DelayProcessor* create(size_t len){
-    return new DelayProcessor(new float[len], len);
+  static DelayProcessor* create(Arena& arena, size_t len){
+    return new (arena) DelayProcessor((float*)arena.allocateBuffer(len*sizeof(float)), len);
   }
   static void destroy(DelayProcessor* obj){
     delete[] obj->buffer.getData();
@@ -75,8 +75,8 @@ public:
     // buffer.delay(input, output, input.getSize(), buffer.getFractionalDelay(), delay);
     buffer.delay(input, output, input.getSize(), delay);
   }
-  static FractionalDelayProcessor* create(size_t len){
-    return new FractionalDelayProcessor(new float[len], len);
+  static FractionalDelayProcessor* create(Arena& arena, size_t len){
+    return new (arena) FractionalDelayProcessor((float*)arena.allocateBuffer(len*sizeof(float)), len);
   }
   static void destroy(FractionalDelayProcessor* obj){
     delete[] obj->buffer.getData();
@@ -118,8 +118,8 @@ public:
     buffer.delay(input, output, input.getSize(), delay, newDelay);
     delay = newDelay;
   }
-  static FastFractionalDelayProcessor* create(size_t len){
-    return new FastFractionalDelayProcessor(new float[len], new float[len], len);
+  static FastFractionalDelayProcessor* create(Arena& arena, size_t len){
+    return new (arena) FastFractionalDelayProcessor((float*)arena.allocateBuffer(len*sizeof(float)), (float*)arena.allocateBuffer(len*sizeof(float)), len);
   }
   static void destroy(FastFractionalDelayProcessor* obj){
     delete[] obj->buffer.getData();
@@ -153,8 +153,8 @@ public:
   void process(FloatArray input, FloatArray output){
     ringbuffer->delay(input, output, input.getSize(), delay);
   }
-  static CrossFadingDelayProcessor* create(size_t delay_len, size_t buffer_len){
-    return new CrossFadingDelayProcessor(CrossFadingCircularFloatBuffer::create(delay_len, buffer_len));
+  static CrossFadingDelayProcessor* create(Arena& arena, size_t delay_len, size_t buffer_len){
+    return new (arena) CrossFadingDelayProcessor(CrossFadingCircularFloatBuffer::create(arena, delay_len, buffer_len));
   }
   static void destroy(CrossFadingDelayProcessor* obj){
     CrossFadingCircularFloatBuffer::destroy(obj->ringbuffer);
@@ -42,12 +42,12 @@ private:
     }
 
 public:
-    DjFilter(float sampleRate)
+    DjFilter(Arena& arena, float sampleRate)
     {
         for (size_t i = 0; i < 2; i++)
         {
-            lpfs_[i] = StateVariableFilter::create(sampleRate);
-            hpfs_[i] = StateVariableFilter::create(sampleRate);
+            lpfs_[i] = StateVariableFilter::create(arena, sampleRate);
+            hpfs_[i] = StateVariableFilter::create(arena, sampleRate);
         }
 
         filter_ = FilterType::NO_FILTER;
@@ -64,9 +64,19 @@ public:
         }
     }
 
-    static DjFilter* create(float sampleRate)
+    static DjFilter* create(Arena& arena, float sampleRate)
     {
-        return new DjFilter(sampleRate);
+        return new (arena, Placement::Hot) DjFilter(arena, sampleRate);
+    }
+
+    static void reserve(Arena& arena)
+    {
+        arena.reserve(sizeof(DjFilter), Placement::Hot);
+        for (size_t i = 0; i < 2; i++)
+        {
+            StateVariableFilter::reserve(arena);
+            StateVariableFilter::reserve(arena);
+        }
     }
 
     static void destroy(DjFilter* obj)
@@ -27,9 +27,9 @@ public:
     output.add(mix_buffer);
   }
   template <typename... Args>
-  static DryWetSignalProcessor<Processor>* create(size_t blocksize, Args&&... args){
-    FloatArray buffer = FloatArray::create(blocksize);
-    return new DryWetSignalProcessor<Processor>(buffer, std::forward<Args>(args)...);
+  static DryWetSignalProcessor<Processor>* create(Arena& arena, size_t blocksize, Args&&... args){
+    FloatArray buffer = FloatArray::create(arena, blocksize);
+    return new (arena) DryWetSignalProcessor<Processor>(buffer, std::forward<Args>(args)...);
   }    
   static void destroy(DryWetSignalProcessor<Processor>* obj){
     FloatArray::destroy(obj->mix_buffer);
@@ -60,9 +60,9 @@ public:
     output.add(*mix_buffer);
   }
  template <typename... Args>
-  static DryWetMultiSignalProcessor<Processor>* create(size_t channels, size_t blocksize, Args&&... args){
-    AudioBuffer* buffer = NTSampleBuffer::create(channels, blocksize);
-    return new DryWetMultiSignalProcessor<Processor>(buffer, std::forward<Args>(args)...);
+  static DryWetMultiSignalProcessor<Processor>* create(Arena& arena, size_t channels, size_t blocksize, Args&&... args){
+    AudioBuffer* buffer = NTSampleBuffer::create(arena, channels, blocksize);
+    return new (arena) DryWetMultiSignalProcessor<Processor>(buffer, std::forward<Args>(args)...);
   }    
   static void destroy(DryWetMultiSignalProcessor<Processor>* obj){
     AudioBuffer::destroy(obj->mix_buffer);
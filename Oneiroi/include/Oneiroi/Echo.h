@@ -20,27 +20,39 @@ enum EchoTap
 class Echo
 {
 private:
+    // Per-chunk working buffers, kept off the audio thread's stack.
+    struct Chunk
+    {
+        float outs[kEchoTaps][kEchoBlockSamples];
+        float fade[kEchoBlockSamples];
+        float fbs[kEchoLines][kEchoBlockSamples];
+        float wet[2][kEchoBlockSamples];
+        float ins[2][kEchoBlockSamples];
+    };
+
     PatchCtrls* patchCtrls_;
     PatchCvs* patchCvs_;
     PatchState* patchState_;
 
-    DelayLine* lines_[kEchoTaps];
+    DelayLine* lines_[kEchoLines];
     DjFilter* filter_;
     EnvFollower* ef_[2];
     Compressor* comp_[2];
+    Chunk* chunk_;
 
     HysteresisQuantizer densityQuantizer_;
 
     int clockRatiosIndex_;
     float echoDensity_, oldDensity_;
 
-    float levels_[kEchoTaps], outs_[kEchoTaps];
+    float levels_[kEchoTaps];
     float tapsTimes_[kEchoTaps], newTapsTimes_[kEchoTaps], maxTapsTimes_[kEchoTaps];
     float repeats_, filterValue_;
     float xi_;
 
     bool externalClock_;
     bool infinite_;
+    float wetEnergy_;
 
     void SetTapTime(int idx, float time)
     {
@@ -142,19 +154,21 @@ private:
     }
 
 public:
-    Echo(PatchCtrls* patchCtrls, PatchCvs* patchCvs, PatchState* patchState)
+    Echo(Arena& arena, PatchCtrls* patchCtrls, PatchCvs* patchCvs, PatchState* patchState)
     {
         patchCtrls_ = patchCtrls;
         patchCvs_ = patchCvs;
         patchState_ = patchState;
 
+        for (size_t i = 0; i < kEchoLines; i++)
+        {
+            lines_[i] = DelayLine::create(arena, kEchoMaxLengthSamples);
+        }
         for (size_t i = 0; i < kEchoTaps; i++)
         {
-            lines_[i] = DelayLine::create(kEchoMaxLengthSamples);
             tapsTimes_[i] = kEchoMaxLengthSamples - 1;
             SetMaxTapTime(i, tapsTimes_[i] * kEchoTapsRatios[i]);
             levels_[i] = 0;
-            outs_[i] = 0;
         }
 
         echoDensity_ = 1.f;
@@ -164,21 +178,24 @@ public:
 
         externalClock_ = false;
         infinite_ = false;
+        wetEnergy_ = 0;
 
-        filter_ = DjFilter::create(patchState_->sampleRate);
+        filter_ = DjFilter::create(arena, patchState_->sampleRate);
 
         for (size_t i = 0; i < 2; i++)
         {
-            comp_[i] = Compressor::create(patchState_->sampleRate);
+            comp_[i] = Compressor::create(arena, patchState_->sampleRate);
             comp_[i]->setThreshold(-16);
-            ef_[i] = EnvFollower::create();
+            ef_[i] = EnvFollower::create(arena);
         }
 
+        chunk_ = new (arena) Chunk;
+
         densityQuantizer_.Init(kClockUnityRatioIndex, 0.15f, false);
     }
     ~Echo()
     {
-        for (size_t i = 0; i < kEchoTaps; i++)
+        for (size_t i = 0; i < kEchoLines; i++)
         {
             DelayLine::destroy(lines_[i]);
         }
@@ -190,9 +207,25 @@ public:
         }
     }
 
-    static Echo* create(PatchCtrls* patchCtrls, PatchCvs* patchCvs, PatchState* patchState)
+    static Echo* create(Arena& arena, PatchCtrls* patchCtrls, PatchCvs* patchCvs, PatchState* patchState)
     {
-        return new Echo(patchCtrls, patchCvs, patchState);
+        return new (arena, Placement::Hot) Echo(arena, patchCtrls, patchCvs, patchState);
+    }
+
+    static void reserve(Arena& arena)
+    {
+        arena.reserve(sizeof(Echo), Placement::Hot);
+        for (size_t i = 0; i < kEchoLines; i++)
+        {
+            DelayLine::reserve(arena, kEchoMaxLengthSamples);
+        }
+        DjFilter::reserve(arena);
+        for (size_t i = 0; i < 2; i++)
+        {
+            Compressor::reserve(arena);
+            EnvFollower::reserve(arena);
+        }
+        arena.reserve(sizeof(Chunk));
     }
 
     static void destroy(Echo* obj)
@@ -200,6 +233,12 @@ public:
         delete obj;
     }
 
+    // Mean square of the wet signal over the last processed block.
+    float GetWetEnergy()
+    {
+        return wetEnergy_;
+    }
+
     void process(AudioBuffer &input, AudioBuffer &output)
     {
         size_t size = output.getSize();
@@ -226,65 +265,103 @@ public:
             return;
         }
 
+        // Tap times only change once per block (internal clock) or crossfade
+        // once per block (external clock), so the taps are read as spans.
+        if (!externalClock_)
+        {
+            SetDensity(d);
+        }
+
         float x = 0;
+        float energy = 0;
+
+        // Every tap is at least kEchoMinLengthSamples * 0.25 long, so a chunk
+        // of kEchoBlockSamples only reads samples written before it.
+        float (*outs)[kEchoBlockSamples] = chunk_->outs;
+        float* fade = chunk_->fade;
+        float (*fbs)[kEchoBlockSamples] = chunk_->fbs;
+        float (*wet)[kEchoBlockSamples] = chunk_->wet;
+        float (*ins)[kEchoBlockSamples] = chunk_->ins;
 
-        for (size_t i = 0; i < size; i++)
+        for (size_t offset = 0; offset < size; offset += kEchoBlockSamples)
         {
+            size_t n = size - offset < kEchoBlockSamples ? size - offset : kEchoBlockSamples;
+
             // Using crossfade between two different tap times when the clock is
             // external and a filtered density param for when the clock is
             // internal (for pitch shifting effect).
-            if (externalClock_)
+            for (size_t tap = 0; tap < kEchoTaps; tap++)
             {
-                outs_[TAP_LEFT_A] = lines_[TAP_LEFT_A]->read(tapsTimes_[TAP_LEFT_A], newTapsTimes_[TAP_LEFT_A], x); // A
-                outs_[TAP_LEFT_B] = lines_[TAP_LEFT_B]->read(tapsTimes_[TAP_LEFT_B], newTapsTimes_[TAP_LEFT_B], x); // B
-                outs_[TAP_RIGHT_A] = lines_[TAP_RIGHT_A]->read(tapsTimes_[TAP_RIGHT_A], newTapsTimes_[TAP_RIGHT_A], x); // A
-                outs_[TAP_RIGHT_B] = lines_[TAP_RIGHT_B]->read(tapsTimes_[TAP_RIGHT_B], newTapsTimes_[TAP_RIGHT_B], x); // B
-
-                x += xi_;
+                DelayLine* line = lines_[tap / 2]; // TAP_LEFT_* on the left line, TAP_RIGHT_* on the right one
+                if (externalClock_)
+                {
+                    line->read(tapsTimes_[tap], outs[tap], n);
+                    if (tapsTimes_[tap] != newTapsTimes_[tap])
+                    {
+                        line->read(newTapsTimes_[tap], fade, n);
+                        float xt = x;
+                        for (size_t i = 0; i < n; i++)
+                        {
+                            outs[tap][i] = outs[tap][i] * (1.f - xt) + fade[i] * xt;
+                            xt += xi_;
+                        }
+                    }
+                }
+                else
+                {
+                    line->read(newTapsTimes_[tap], outs[tap], n);
+                }
             }
-            else
+            if (externalClock_)
             {
-                SetDensity(d);
-                outs_[TAP_LEFT_A] = lines_[TAP_LEFT_A]->read(newTapsTimes_[TAP_LEFT_A]); // A
-                outs_[TAP_LEFT_B] = lines_[TAP_LEFT_B]->read(newTapsTimes_[TAP_LEFT_B]); // B
-                outs_[TAP_RIGHT_A] = lines_[TAP_RIGHT_A]->read(newTapsTimes_[TAP_RIGHT_A]); // A
-                outs_[TAP_RIGHT_B] = lines_[TAP_RIGHT_B]->read(newTapsTimes_[TAP_RIGHT_B]); // B
+                x += xi_ * n;
             }
 
-            float leftFb = HardClip(outs_[TAP_LEFT_A] * levels_[TAP_LEFT_A] + outs_[TAP_RIGHT_A] * levels_[TAP_RIGHT_A]);
-            float rightFb = HardClip(outs_[TAP_LEFT_B] * levels_[TAP_LEFT_B] + outs_[TAP_RIGHT_B] * levels_[TAP_RIGHT_B]);
-
-            if (infinite_)
+            for (size_t i = 0; i < n; i++)
             {
-                leftFb *= 1.08f - ef_[LEFT_CHANNEL]->process(leftFb);
-                rightFb *= 1.08f - ef_[RIGHT_CHANNEL]->process(rightFb);
-            }
+                float lIn = Clamp(leftIn[offset + i], -3.f, 3.f);
+                float rIn = Clamp(rightIn[offset + i], -3.f, 3.f);
+                ins[LEFT_CHANNEL][i] = lIn;
+                ins[RIGHT_CHANNEL][i] = rIn;
 
-            float lIn = Clamp(leftIn[i], -3.f, 3.f);
-            float rIn = Clamp(rightIn[i], -3.f, 3.f);
+                float leftFb = HardClip(outs[TAP_LEFT_A][i] * levels_[TAP_LEFT_A] + outs[TAP_RIGHT_A][i] * levels_[TAP_RIGHT_A]);
+                float rightFb = HardClip(outs[TAP_LEFT_B][i] * levels_[TAP_LEFT_B] + outs[TAP_RIGHT_B][i] * levels_[TAP_RIGHT_B]);
 
-            float leftFilter;
-            float rightFilter;
+                if (infinite_)
+                {
+                    leftFb *= 1.08f - ef_[LEFT_CHANNEL]->process(leftFb);
+                    rightFb *= 1.08f - ef_[RIGHT_CHANNEL]->process(rightFb);
+                }
 
-            filter_->Process(lIn, rIn, leftFilter, rightFilter);
+                float leftFilter;
+                float rightFilter;
 
-            leftFb += leftFilter;
-            rightFb += rightFilter;
+                filter_->Process(lIn, rIn, leftFilter, rightFilter);
 
-            lines_[TAP_LEFT_A]->write(leftFb);
-            lines_[TAP_LEFT_B]->write(leftFb);
-            lines_[TAP_RIGHT_A]->write(rightFb);
-            lines_[TAP_RIGHT_B]->write(rightFb);
+                fbs[LEFT_CHANNEL][i] = leftFb + leftFilter;
+                fbs[RIGHT_CHANNEL][i] = rightFb + rightFilter;
 
-            float left = Mix2(outs_[TAP_LEFT_A], outs_[TAP_LEFT_B]);
-            float right = Mix2(outs_[TAP_RIGHT_A], outs_[TAP_RIGHT_B]);
+                wet[LEFT_CHANNEL][i] = Mix2(outs[TAP_LEFT_A][i], outs[TAP_LEFT_B][i]);
+                wet[RIGHT_CHANNEL][i] = Mix2(outs[TAP_RIGHT_A][i], outs[TAP_RIGHT_B][i]);
+            }
 
-            left = comp_[LEFT_CHANNEL]->process(left) * kEchoMakeupGain;
-            right = comp_[RIGHT_CHANNEL]->process(right) * kEchoMakeupGain;
+            lines_[LEFT_CHANNEL]->write(fbs[LEFT_CHANNEL], n);
+            lines_[RIGHT_CHANNEL]->write(fbs[RIGHT_CHANNEL], n);
 
-            leftOut[i] = CheapEqualPowerCrossFade(lIn, left, patchCtrls_->echoVol, 1.8f);
-            rightOut[i] = CheapEqualPowerCrossFade(rIn, right, patchCtrls_->echoVol, 1.8f);
+            comp_[LEFT_CHANNEL]->process(wet[LEFT_CHANNEL], n);
+            comp_[RIGHT_CHANNEL]->process(wet[RIGHT_CHANNEL], n);
+
+            for (size_t i = 0; i < n; i++)
+            {
+                float left = wet[LEFT_CHANNEL][i] * kEchoMakeupGain;
+                float right = wet[RIGHT_CHANNEL][i] * kEchoMakeupGain;
+                energy += left * left + right * right;
+
+                leftOut[offset + i] = CheapEqualPowerCrossFade(ins[LEFT_CHANNEL][i], left, patchCtrls_->echoVol, 1.8f);
+                rightOut[offset + i] = CheapEqualPowerCrossFade(ins[RIGHT_CHANNEL][i], right, patchCtrls_->echoVol, 1.8f);
+            }
         }
+        wetEnergy_ = energy / size;
 
         if (externalClock_)
         {
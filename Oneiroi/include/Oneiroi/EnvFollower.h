@@ -10,9 +10,11 @@ private:
     float y_;
 
 public:
+    static constexpr float kDefaultLambda = 0.995f;
+
     EnvFollower()
     {
-        lambda_ = 0.995f;
+        lambda_ = kDefaultLambda;
         y_ = 0;
     }
     ~EnvFollower() {}
@@ -22,21 +24,32 @@ public:
         lambda_ = lambda;
     }
 
-    static EnvFollower* create()
+    static EnvFollower* create(Arena& arena)
     {
-        return new EnvFollower();
+        return new (arena, Placement::Hot) EnvFollower();
+    }
+
+    static void reserve(Arena& arena)
+    {
+        arena.reserve(sizeof(EnvFollower), Placement::Hot);
     }
     static void destroy(EnvFollower* obj)
     {
         delete obj;
     }
 
-    float process(float x)
+    // One sample on external state, for followers kept in lanes.
+    static inline float step(float x, float& y, float lambda = kDefaultLambda)
     {
         float v = fabs(HardClip(x));
 
-        y_ = y_ * lambda_ + v * (1.0f - lambda_);
+        y = y * lambda + v * (1.0f - lambda);
 
-        return Clamp(y_);
+        return Clamp(y);
+    }
+
+    float process(float x)
+    {
+        return step(x, y_, lambda_);
     }
 };
@@ -23,9 +23,14 @@ public:
     }
     ~EnvelopeFollowerMod() {}
 
-    static EnvelopeFollowerMod* create(PatchCtrls* patchCtrls, PatchState* patchState)
+    static EnvelopeFollowerMod* create(Arena& arena, PatchCtrls* patchCtrls, PatchState* patchState)
     {
-        return new EnvelopeFollowerMod(patchCtrls, patchState);
+        return new (arena, Placement::Cold) EnvelopeFollowerMod(patchCtrls, patchState);
+    }
+
+    static void reserve(Arena& arena)
+    {
+        arena.reserve(sizeof(EnvelopeFollowerMod), Placement::Cold);
     }
 
     static void destroy(EnvelopeFollowerMod* obj)
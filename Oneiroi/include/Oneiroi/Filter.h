@@ -2,9 +2,10 @@
 
 #include "Commons.h"
 #include "StateVariableFilter.h"
-#include "ChaosNoise.h"
-#include "DcBlockingFilter.h"
 #include "EnvFollower.h"
+#include "DcBlockingFilter.h"
+#include "ChaosNoise.h"
+#include "Interpolator.h"
 
 enum FilterMode
 {
@@ -22,155 +23,212 @@ enum FilterPosition
     POSITION_4,
 };
 
-class Allpass
+/**
+ * @brief Both channels of the comb filter, a feedback loop through two
+ *        fixed two-sample allpasses and two variable ones, run as lanes.
+ *        The channels always share their settings, so each stage keeps a
+ *        single write index and its line holds the two lanes side by side:
+ *        a sample reads and writes adjacent pairs.
+ */
+class StereoCombFilter
 {
 private:
-    FloatArray line_;
-    int s_, w_;
-    float d_, c_, sr_;
-
-public:
-    Allpass(float sampleRate, int size)
-    {
-        sr_ = sampleRate;
-        s_ = size;
-        line_ = FloatArray::create(size);
-        w_ = 0;
-        d_ = 1.f;
-        c_ = 0.7f;
-    }
-    ~Allpass()
+    static const int kLanes = 2;
+    static const int kFixedSize = 2;
+    static const int kLineSize = 9600;
+    static constexpr float kC = 0.7f;
+
+    float fixed_[2][kFixedSize * kLanes];
+    float* lines_[2];
+    int fixedW_, w_;
+    float d_[2];
+
+    float sampleRate_, reso_;
+    float out_[kLanes];
+    float efY_[kLanes];
+
+    // First-order allpass over the two-sample line.
+    inline void ProcessFixed(float* line, float* io)
     {
-        FloatArray::destroy(line_);
+        float* t = line + fixedW_ * kLanes;
+        for (int i = 0; i < kLanes; i++)
+        {
+            float out = 0;
+            out += kC * t[i];
+            out += io[i] - kC * out;
+            t[i] = out;
+            io[i] = out;
+        }
     }
 
-    static Allpass* create(float sampleRate, int size)
+    inline void ProcessVariable(int stage, float* io)
     {
-        return new Allpass(sampleRate, size);
-    }
+        float d = d_[stage];
+        int idx = (int)d;
+        float frac = d - idx;
 
-    static void destroy(Allpass* obj)
-    {
-        delete obj;
+        int r0 = w_ - idx;
+        if (r0 < 0)
+        {
+            r0 += kLineSize;
+        }
+        int r1 = w_ - idx - 1;
+        if (r1 < 0)
+        {
+            r1 += kLineSize;
+        }
+
+        float* line = lines_[stage];
+        const float* y0 = line + r0 * kLanes;
+        const float* y1 = line + r1 * kLanes;
+        float* t = line + w_ * kLanes;
+        for (int i = 0; i < kLanes; i++)
+        {
+            float out = Interpolator::linear(y0[i], y1[i], frac) + (-kC * io[i]);
+            t[i] = io[i] + (kC * out);
+            io[i] = out;
+        }
     }
 
-    void SetDelay(float d)
+public:
+    StereoCombFilter(Arena& arena, float sampleRate)
     {
-        d_ = d;
+        sampleRate_ = sampleRate;
+        for (int i = 0; i < 2; i++)
+        {
+            lines_[i] = (float*)arena.allocateBuffer(kLineSize * kLanes * sizeof(float));
+            memset(lines_[i], 0, kLineSize * kLanes * sizeof(float));
+            memset(fixed_[i], 0, sizeof(fixed_[i]));
+            d_[i] = 1.f;
+        }
+        fixedW_ = w_ = 0;
+        reso_ = 0;
+        for (int i = 0; i < kLanes; i++)
+        {
+            out_[i] = 0;
+            efY_[i] = 0;
+        }
     }
+    ~StereoCombFilter() {}
 
-    void SetC(float c)
+    static StereoCombFilter* create(Arena& arena, float sampleRate)
     {
-        c_ = c;
+        return new (arena, Placement::Hot) StereoCombFilter(arena, sampleRate);
     }
 
-    inline float readAt(int index)
+    static void reserve(Arena& arena)
     {
-        int r = w_ - index;
-        if (r < 0)
+        arena.reserve(sizeof(StereoCombFilter), Placement::Hot);
+        for (int i = 0; i < 2; i++)
         {
-            r += s_;
+            arena.reserve(kLineSize * kLanes * sizeof(float));
         }
-
-        return line_.getElement(r);
     }
 
-    float Process(float in)
+    static void destroy(StereoCombFilter* obj)
     {
-        size_t idx = (size_t)d_;
-        float y0 = readAt(idx);
-        float y1 = readAt(idx + 1);
-        float frac = d_ - idx;
-
-        float out = Interpolator::linear(y0, y1, frac) + (-c_ * in);
-
-        line_.setElement(w_, in + (c_ * out));
+        //delete obj;
+    }
 
-        w_ = (w_ + 1) % s_;
+    void SetFrequency(float freq)
+    {
+        float d = sampleRate_ / freq;
+        d_[0] = d;
+        d_[1] = d + d;
+    }
 
-        return out;
+    void SetResonance(float reso)
+    {
+        reso_ = reso;
     }
 
-    float ProcessFixed(float in)
+    // Processes one sample of each channel in place.
+    inline void Process(float* io)
     {
-        float out = 0;
-        float delayedSample = line_.getElement(w_);
+        for (int i = 0; i < kLanes; i++)
+        {
+            float in = io[i] + reso_ * out_[i];
+            io[i] = in * (1.f - EnvFollower::step(in, efY_[i]));
+        }
 
-        out += c_ * delayedSample;
-        out += in - c_ * out;
+        ProcessFixed(fixed_[0], io);
+        ProcessVariable(0, io);
+        ProcessFixed(fixed_[1], io);
+        ProcessVariable(1, io);
 
-        line_.setElement(w_, out);
-        w_ = (w_ + 1) % s_;
+        fixedW_ = (fixedW_ + 1) % kFixedSize;
+        w_ = (w_ + 1) % kLineSize;
 
-        return out;
+        for (int i = 0; i < kLanes; i++)
+        {
+            out_[i] = io[i];
+        }
     }
 };
 
-class CombFilter
+/**
+ * @brief Both channels of the state variable filter. The channels share
+ *        cutoff and resonance, hence one set of coefficients and a state
+ *        per lane. The output mix is picked at compile time.
+ */
+class StereoStateVariableLanes : public AbstractStateVariableFilter
 {
 private:
-    Allpass* poles_[4];
-    EnvFollower* ef_;
-    float sampleRate_, reso_, out_;
+    static const int kLanes = 2;
+
+    float ic1eq_[kLanes];
+    float ic2eq_[kLanes];
 
 public:
-    CombFilter(float sampleRate)
+    StereoStateVariableLanes(float sr) : AbstractStateVariableFilter(sr)
     {
-        sampleRate_ = sampleRate;
-        poles_[0] = Allpass::create(sampleRate, 2); // Fixed
-        poles_[1] = Allpass::create(sampleRate, 9600); // Variable
-        poles_[2] = Allpass::create(sampleRate, 2); // Fixed
-        poles_[3] = Allpass::create(sampleRate, 9600); // Variable
-        ef_ = EnvFollower::create();
-        reso_ = 0;
-        out_ = 0;
-    }
-    ~CombFilter()
-    {
-        for (size_t i = 0; i < 4; i++)
+        for (int i = 0; i < kLanes; i++)
         {
-            Allpass::destroy(poles_[i]);
+            ic1eq_[i] = ic2eq_[i] = 0;
         }
-        EnvFollower::destroy(ef_);
     }
+    ~StereoStateVariableLanes() {}
 
-    static CombFilter* create(float sampleRate)
+    static StereoStateVariableLanes* create(Arena& arena, float sr)
     {
-        return new CombFilter(sampleRate);
+        return new (arena, Placement::Hot) StereoStateVariableLanes(sr);
     }
 
-    static void destroy(CombFilter* obj)
-    {
-        delete obj;
-    }
-
-    void SetFrequency(float freq)
+    static void reserve(Arena& arena)
     {
-        float d = sampleRate_ / freq;
-        //poles_[0]->SetDelay(d);
-        poles_[1]->SetDelay(d);
-        //poles_[2]->SetDelay(d);
-        poles_[3]->SetDelay(d + d);
+        arena.reserve(sizeof(StereoStateVariableLanes), Placement::Hot);
     }
 
-    void SetResonance(float reso)
+    static void destroy(StereoStateVariableLanes* obj)
     {
-        reso_ = reso;
+        //delete obj;
     }
 
-    float Process(float in)
+    // Processes one sample of each channel in place.
+    template <FilterMode kMode>
+    inline void Process(float* io)
     {
-        float i = in + reso_ * out_;
-        i *= 1.f - ef_->process(i);
-
-        float o = poles_[0]->ProcessFixed(i);
-        o = poles_[1]->Process(o);
-        o = poles_[2]->ProcessFixed(o);
-        o = poles_[3]->Process(o);
-
-        out_ = o;
-
-        return out_;
+        for (int i = 0; i < kLanes; i++)
+        {
+            float v0 = io[i];
+            float v3 = v0 - ic2eq_[i];
+            float v1 = a1 * ic1eq_[i] + a2 * v3;
+            float v2 = ic2eq_[i] + a2 * ic1eq_[i] + a3 * v3;
+            ic1eq_[i] = 2. * v1 - ic1eq_[i];
+            ic2eq_[i] = 2. * v2 - ic2eq_[i];
+            switch (kMode)
+            {
+            case FilterMode::LP:
+                io[i] = v2;
+                break;
+            case FilterMode::BP:
+                io[i] = v1;
+                break;
+            default:
+                io[i] = m0 * v0 + m1 * v1 + m2 * v2;
+                break;
+            }
+        }
     }
 };
 
@@ -180,12 +238,14 @@ private:
     PatchCtrls* patchCtrls_;
     PatchCvs* patchCvs_;
     PatchState* patchState_;
-    StateVariableFilter* filters_[2];
-    CombFilter* combs_[2];
+    StereoStateVariableLanes* svf_;
+    StereoCombFilter* comb_;
     ChaosNoise noise_;
     FilterMode mode_, lastMode_;
-    DcBlockingFilter* dc_[2];
-    EnvFollower* ef_[2];
+
+    // DC blockers after the comb, limiters after the SVF, one per channel.
+    float dcX_[2], dcY_[2];
+    float efY_[2];
 
     float drive_;
     float freq_;
@@ -235,8 +295,7 @@ private:
         switch (mode_){
         case FilterMode::LP:
             {
-                filters_[LEFT_CHANNEL]->setLowPass(cutoff, reso_);
-                filters_[RIGHT_CHANNEL]->setLowPass(cutoff, reso_);
+                svf_->setLowPass(cutoff, reso_);
                 // Shut the filter off when the frequency is really low.
                 float g = MapExpo(resoValue_, 0.f, 1.f, kFilterLpGainMax, kFilterLpGainMin);
                 filterGain_ = cutoff <= 15.f ? Map(cutoff, 10.f, 15.f, 0.f, g) : g;
@@ -244,15 +303,13 @@ private:
             }
         case FilterMode::BP:
             {
-                filters_[LEFT_CHANNEL]->setBandPass(cutoff, reso_);
-                filters_[RIGHT_CHANNEL]->setBandPass(cutoff, reso_);
+                svf_->setBandPass(cutoff, reso_);
                 filterGain_ = MapExpo(resoValue_, 0.f, 1.f, kFilterBpGainMin, kFilterBpGainMax);
             }
             break;
         case FilterMode::HP:
             {
-                filters_[LEFT_CHANNEL]->setHighPass(cutoff, reso_);
-                filters_[RIGHT_CHANNEL]->setHighPass(cutoff, reso_);
+                svf_->setHighPass(cutoff, reso_);
                 // Shut the filter off when the frequency is really high.
                 float g = MapExpo(resoValue_, 0.f, 1.f, kFilterHpGainMax, kFilterHpGainMin);
                 filterGain_ = cutoff >= 20000.f ? Map(cutoff, 15000, 20000, g, 0.f) : g;
@@ -261,10 +318,8 @@ private:
         case FilterMode::CF:
             float f = Clamp(Map(value, 0.f, 1.f, 100.f, 15000.f), 100.f, 15000.f);
             float r = Clamp(VariableCrossFade(0.f, 0.8f, resoValue_, 0.9f), 0.f, 0.8f);
-            combs_[LEFT_CHANNEL]->SetFrequency(f);
-            combs_[LEFT_CHANNEL]->SetResonance(r);
-            combs_[RIGHT_CHANNEL]->SetFrequency(f);
-            combs_[RIGHT_CHANNEL]->SetResonance(r);
+            comb_->SetFrequency(f);
+            comb_->SetResonance(r);
             filterGain_ = MapExpo(resoValue_, 0.f, 1.f, kFilterCombGainMax, kFilterCombGainMin);
             break;
         }
@@ -279,8 +334,53 @@ private:
         noiseLevel_ = VariableCrossFade(0.f, 0.1f, value, 0.15f, 0.9f);
     }
 
+    template <FilterMode kMode>
+    void ProcessMode(AudioBuffer &input, AudioBuffer &output)
+    {
+        size_t size = output.getSize();
+
+        float* in[2] = { input.getSamples(LEFT_CHANNEL).getData(), input.getSamples(RIGHT_CHANNEL).getData() };
+        float* out[2] = { output.getSamples(LEFT_CHANNEL).getData(), output.getSamples(RIGHT_CHANNEL).getData() };
+
+        for (size_t i = 0; i < size; i++)
+        {
+            float n = noise_.Process() * noiseLevel_;
+
+            float x[2], y[2];
+            for (int c = 0; c < 2; c++)
+            {
+                x[c] = Clamp(in[c][i], -3.f, 3.f);
+                float s = SoftClip(x[c] * amp_ + n);
+                y[c] = LinearCrossFade(x[c] + n, s, drive_);
+            }
+
+            if (FilterMode::CF == kMode)
+            {
+                comb_->Process(y);
+                for (int c = 0; c < 2; c++)
+                {
+                    y[c] = DcBlockingFilter::step(HardClip(y[c] * filterGain_), dcX_[c], dcY_[c]);
+                }
+            }
+            else
+            {
+                svf_->Process<kMode>(y);
+                for (int c = 0; c < 2; c++)
+                {
+                    float o = y[c] * filterGain_;
+                    y[c] = o * (1.f - EnvFollower::step(o, efY_[c]));
+                }
+            }
+
+            for (int c = 0; c < 2; c++)
+            {
+                out[c][i] = CheapEqualPowerCrossFade(x[c], y[c] * kFilterMakeupGain, patchCtrls_->filterVol);
+            }
+        }
+    }
+
 public:
-    Filter(PatchCtrls* patchCtrls, PatchCvs* patchCvs, PatchState* patchState)
+    Filter(Arena& arena, PatchCtrls* patchCtrls, PatchCvs* patchCvs, PatchState* patchState)
     {
         patchCtrls_ = patchCtrls;
         patchCvs_ = patchCvs;
@@ -289,12 +389,12 @@ public:
         noise_.Init(patchState_->sampleRate);
         noise_.SetChaos(kFilterChaosNoise);
 
+        svf_ = StereoStateVariableLanes::create(arena, patchState_->sampleRate);
+        comb_ = StereoCombFilter::create(arena, patchState_->sampleRate);
         for (size_t i = 0; i < 2; i++)
         {
-            filters_[i] = StateVariableFilter::create(patchState_->sampleRate);
-            combs_[i] = CombFilter::create(patchState_->sampleRate);
-            dc_[i] = DcBlockingFilter::create();
-            ef_[i] = EnvFollower::create();
+            dcX_[i] = dcY_[i] = 0;
+            efY_[i] = 0;
         }
 
         mode_ = lastMode_ = FilterMode::LP;
@@ -303,18 +403,20 @@ public:
     }
     ~Filter()
     {
-        for (size_t i = 0; i < 2; i++)
-        {
-            StateVariableFilter::destroy(filters_[i]);
-            CombFilter::destroy(combs_[i]);
-            DcBlockingFilter::destroy(dc_[i]);
-            EnvFollower::destroy(ef_[i]);
-        }
+        StereoStateVariableLanes::destroy(svf_);
+        StereoCombFilter::destroy(comb_);
+    }
+
+    static Filter* create(Arena& arena, PatchCtrls* patchCtrls, PatchCvs* patchCvs, PatchState* patchState)
+    {
+        return new (arena, Placement::Hot) Filter(arena, patchCtrls, patchCvs, patchState);
     }
 
-    static Filter* create(PatchCtrls* patchCtrls, PatchCvs* patchCvs, PatchState* patchState)
+    static void reserve(Arena& arena)
     {
-        return new Filter(patchCtrls, patchCvs, patchState);
+        arena.reserve(sizeof(Filter), Placement::Hot);
+        StereoStateVariableLanes::reserve(arena);
+        StereoCombFilter::reserve(arena);
     }
 
     static void destroy(Filter* obj)
@@ -324,13 +426,6 @@ public:
 
     void process(AudioBuffer &input, AudioBuffer &output)
     {
-        size_t size = output.getSize();
-
-        FloatArray leftIn = input.getSamples(LEFT_CHANNEL);
-        FloatArray rightIn = input.getSamples(RIGHT_CHANNEL);
-        FloatArray leftOut = output.getSamples(LEFT_CHANNEL);
-        FloatArray rightOut = output.getSamples(RIGHT_CHANNEL);
-
         SetMode(patchCtrls_->filterMode);
         if (mode_ != lastMode_)
         {
@@ -355,37 +450,20 @@ public:
             return;
         }
 
-        for (size_t i = 0; i < size; i++)
+        switch (mode_)
         {
-            float n = noise_.Process() * noiseLevel_;
-
-            float lIn = Clamp(leftIn[i], -3.f, 3.f);
-            float rIn = Clamp(rightIn[i], -3.f, 3.f);
-
-            float ls = SoftClip(lIn * amp_ + n);
-            float rs = SoftClip(rIn * amp_ + n);
-
-            float lf = LinearCrossFade(lIn + n, ls, drive_);
-            float rf = LinearCrossFade(rIn + n, rs, drive_);
-
-            float lo, ro;
-            if (FilterMode::CF == mode_)
-            {
-                lo = HardClip(combs_[LEFT_CHANNEL]->Process(lf) * filterGain_);
-                ro = HardClip(combs_[RIGHT_CHANNEL]->Process(rf) * filterGain_);
-                lo = dc_[LEFT_CHANNEL]->process(lo);
-                ro = dc_[RIGHT_CHANNEL]->process(ro);
-            }
-            else
-            {
-                lo = filters_[LEFT_CHANNEL]->process(lf) * filterGain_;
-                ro = filters_[RIGHT_CHANNEL]->process(rf) * filterGain_;
-                lo *= 1.f - ef_[LEFT_CHANNEL]->process(lo);
-                ro *= 1.f - ef_[RIGHT_CHANNEL]->process(ro);
-            }
-
-            leftOut[i] = CheapEqualPowerCrossFade(lIn, lo * kFilterMakeupGain, patchCtrls_->filterVol);
-            rightOut[i] =CheapEqualPowerCrossFade(rIn, ro * kFilterMakeupGain, patchCtrls_->filterVol);
+        case FilterMode::LP:
+            ProcessMode<FilterMode::LP>(input, output);
+            break;
+        case FilterMode::BP:
+            ProcessMode<FilterMode::BP>(input, output);
+            break;
+        case FilterMode::HP:
+            ProcessMode<FilterMode::HP>(input, output);
+            break;
+        case FilterMode::CF:
+            ProcessMode<FilterMode::CF>(input, output);
+            break;
         }
     }
 };
\ No newline at end of file
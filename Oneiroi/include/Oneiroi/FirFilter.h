@@ -114,11 +114,11 @@ public:
     states.copyFrom(newState);
   }
   
-  static FirFilter* create(size_t taps, size_t blocksize){
-    FloatArray coefficients = FloatArray::create(taps);
-    FloatArray states = FloatArray::create(taps + blocksize - 1);
+  static FirFilter* create(Arena& arena, size_t taps, size_t blocksize){
+    FloatArray coefficients = FloatArray::create(arena, taps);
+    FloatArray states = FloatArray::create(arena, taps + blocksize - 1);
     states.clear();
-    return new FirFilter(coefficients, states, blocksize);
+    return new (arena) FirFilter(coefficients, states, blocksize);
   }
 
   static void destroy(FirFilter* filter){
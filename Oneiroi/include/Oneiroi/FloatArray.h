@@ -4,6 +4,7 @@
 #include <cstddef>
 #include "SimpleArray.h"
 #include "basicmaths.h"
+#include "Arena.h"
 #include <string.h>
 
 /**
@@ -392,12 +393,21 @@ public:
 
   /**
    * Creates a new FloatArray.
-   * Allocates size*sizeof(float) bytes of memory and returns a FloatArray that points to it.
+   * Allocates size*sizeof(float) bytes of sample memory from **arena** and returns a FloatArray that points to it.
+   * @param arena the allocator of the instance that owns the array.
    * @param size the size of the new FloatArray.
+   * @param placement where the samples should live, see Placement.
    * @return a FloatArray which **data** point to the newly allocated memory and **size** is initialized to the proper value.
    * @remarks a FloatArray created with this method has to be destroyed invoking the FloatArray::destroy() method.
   */
-  static FloatArray create(int size);
+  static FloatArray create(Arena& arena, int size, Placement placement = Placement::Auto);
+
+  /**
+   * Counts the memory create() would take on a sizing arena.
+   */
+  static void reserve(Arena& arena, int size, Placement placement = Placement::Auto){
+    arena.reserve(size*sizeof(float), placement);
+  }
   
   /**
    * Destroys a FloatArray created with the create() method.
@@ -859,8 +869,8 @@ void FloatArray::tanh(FloatArray destination){
     destination[i] = tanhf(data[i]);
 }*/
 
-FloatArray FloatArray::create(int size){
-  FloatArray fa(new float[size], size);
+FloatArray FloatArray::create(Arena& arena, int size, Placement placement){
+  FloatArray fa((float*)arena.allocateBuffer(size*sizeof(float), placement), size);
   fa.clear();
   return fa;
 }
@@ -95,8 +95,8 @@ public:
     delay(out, len, beginDelay + len, endDelay + len); // set delays relative to where we started writing
   }
 
-  static InterpolatingCircularFloatBuffer<im>* create(size_t len){
-    InterpolatingCircularFloatBuffer<im>* obj = new InterpolatingCircularFloatBuffer<im>(new float[len], len);
+  static InterpolatingCircularFloatBuffer<im>* create(Arena& arena, size_t len){
+    InterpolatingCircularFloatBuffer<im>* obj = new (arena) InterpolatingCircularFloatBuffer<im>((float*)arena.allocateBuffer(len*sizeof(float)), len);
     obj->clear();
     return obj;
   }
@@ -70,9 +70,9 @@ public:
 
     ~Led() {}
 
-    static Led* create(int id, LedType type = LedType::LED_TYPE_BUTTON)
+    static Led* create(Arena& arena, int id, LedType type = LedType::LED_TYPE_BUTTON)
     {
-        return new Led(id, type);
+        return new (arena) Led(id, type);
     }
 
     static void destroy(Led* obj)
@@ -14,9 +14,14 @@ public:
     }
     ~Limiter() { }
 
-    static Limiter* create(float peak = 0.5f)
+    static Limiter* create(Arena& arena, float peak = 0.5f)
     {
-        return new Limiter(peak);
+        return new (arena, Placement::Hot) Limiter(peak);
+    }
+
+    static void reserve(Arena& arena)
+    {
+        arena.reserve(sizeof(Limiter), Placement::Hot);
     }
 
     static void destroy(Limiter* obj)
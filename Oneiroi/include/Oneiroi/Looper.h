@@ -28,7 +28,7 @@ private:
     PlaybackDirection direction_;
 
     float wPhase_;
-    float phase_;
+    double phase_; // Double so streamed loops of minutes keep sub-sample resolution
     float speed_;
     float speedValue_;
     float filterValue_;
@@ -207,10 +207,15 @@ private:
 
         boc_ = false;
 
+        int32_t writeStart = wPhase_;
+        int32_t written = 0;
+
         for (size_t i = 0; i < size; i++)
         {
-            if (buffer_->IsRecording())
+            if (buffer_->IsRecording() && !buffer_->IsStreaming())
             {
+                written++;
+
                 float left =0.f, right = 0.f;
                 filter_->Process(input.getSamples(LEFT_CHANNEL)[i], input.getSamples(RIGHT_CHANNEL)[i], left, right);
 
@@ -232,11 +237,9 @@ private:
             float left = 0;
             float right = 0;
 
-            buffer_->Read(start_ + phase_, left, right, direction_);
-
             if (fade_)
             {
-                float start = newStart_;
+                double start = newStart_;
                 if (!startFade_ && !lengthFade_)
                 {
                     start -= newLength_ * direction_;
@@ -252,7 +255,7 @@ private:
 
                 float fadeLeft;
                 float fadeRight;
-                buffer_->Read(start, fadeLeft, fadeRight, direction_);
+                buffer_->Read(start_ + phase_, start, left, right, fadeLeft, fadeRight, direction_);
 
                 if (fadePhase_ < 1.f)
                 {
@@ -264,7 +267,7 @@ private:
                 {
                     if (!startFade_ && !lengthFade_)
                     {
-                        phase_ = PlaybackDirection::PLAYBACK_FORWARD == direction_ ? Max(phase_ - newLength_, 0) : newLength_;
+                        phase_ = PlaybackDirection::PLAYBACK_FORWARD == direction_ ? (phase_ > newLength_ ? phase_ - newLength_ : 0) : newLength_;
                     }
                     if (lengthFade_ && PlaybackDirection::PLAYBACK_BACKWARDS == direction_)
                     {
@@ -283,6 +286,8 @@ private:
             }
             else
             {
+                buffer_->Read(start_ + phase_, left, right, direction_);
+
                 start_ = newStart_;
                 length_ = newLength_;
             }
@@ -343,19 +348,40 @@ private:
                 bufferPhase_ = 0;
             }
         }
+
+        if (written > 0)
+        {
+            buffer_->MarkWritten(writeStart, written);
+        }
+
+        buffer_->GetStream()->SetHead(start_, length_, phase_, direction_);
+    }
+
+    void ResetLoop(int32_t length)
+    {
+        startLUT_.SetRange(0, length - 1);
+        lengthLUT_.SetRange(kLooperLoopLengthMin, length);
+
+        phase_ = 0;
+        start_ = newStart_ = 0;
+        length_ = newLength_ = length;
+        fadePhase_ = 0;
+        fade_ = false;
+        startFade_ = false;
+        lengthFade_ = false;
     }
 
 public:
-    Looper(PatchCtrls* patchCtrls, PatchCvs* patchCvs, PatchState* patchState)
+    Looper(Arena& arena, PatchCtrls* patchCtrls, PatchCvs* patchCvs, PatchState* patchState)
     {
         patchCtrls_ = patchCtrls;
         patchCvs_ = patchCvs;
         patchState_ = patchState;
 
-        buffer_ = LooperBuffer::create();
-        filter_ = DjFilter::create(patchState_->sampleRate);
-        sosOut_ = NTSampleBuffer::create(2, patchState_->blockSize);
-        limiter_ = Limiter::create();
+        buffer_ = LooperBuffer::create(arena);
+        filter_ = DjFilter::create(arena, patchState_->sampleRate);
+        sosOut_ = NTSampleBuffer::create(arena, 2, patchState_->blockSize);
+        limiter_ = Limiter::create(arena);
 
         direction_ = PlaybackDirection::PLAYBACK_FORWARD;
 
@@ -386,7 +412,7 @@ public:
 
         for (size_t i = 0; i < 2; i++)
         {
-            ef_[i] = EnvFollower::create();
+            ef_[i] = EnvFollower::create(arena);
         }
     }
     ~Looper()
@@ -402,9 +428,22 @@ public:
         }
     }
 
-    static Looper* create(PatchCtrls* patchCtrls, PatchCvs* patchCvs, PatchState* patchState)
+    static Looper* create(Arena& arena, PatchCtrls* patchCtrls, PatchCvs* patchCvs, PatchState* patchState)
     {
-        return new Looper(patchCtrls, patchCvs, patchState);
+        return new (arena, Placement::Hot) Looper(arena, patchCtrls, patchCvs, patchState);
+    }
+
+    static void reserve(Arena& arena, PatchState* patchState)
+    {
+        arena.reserve(sizeof(Looper), Placement::Hot);
+        LooperBuffer::reserve(arena);
+        DjFilter::reserve(arena);
+        NTSampleBuffer::reserve(arena, 2, patchState->blockSize);
+        Limiter::reserve(arena);
+        for (size_t i = 0; i < 2; i++)
+        {
+            EnvFollower::reserve(arena);
+        }
     }
 
     static void destroy(Looper* obj)
@@ -417,6 +456,39 @@ public:
         return buffer_->GetBuffer();
     }
 
+    LooperBuffer* GetLooperBuffer()
+    {
+        return buffer_;
+    }
+
+    LooperStream* GetStream()
+    {
+        return buffer_->GetStream();
+    }
+
+    /**
+     * @brief Plays a file of the given length from the SD card instead of the
+     *        buffer. Start and length then span the whole file, recording is
+     *        off until the stream is stopped (by clearing the looper or
+     *        loading a file that fits in the buffer).
+     */
+    void StartStream(int32_t length)
+    {
+        buffer_->GetStream()->Open(length);
+        ResetLoop(length);
+    }
+
+    // Call only while the stream's IsLoading() is false.
+    void StopStream()
+    {
+        if (!buffer_->IsStreaming())
+        {
+            return;
+        }
+        buffer_->GetStream()->Close();
+        ResetLoop(kLooperChannelBufferLength);
+    }
+
     void Process(AudioBuffer &input, AudioBuffer &output)
     {
         input.multiply(patchCtrls_->looperResampling ? kLooperResampleGain : kLooperInputGain);
@@ -452,7 +524,7 @@ public:
             return;
         }
 
-        if (patchCtrls_->looperRecording && !buffer_->IsRecording())
+        if (patchCtrls_->looperRecording && !buffer_->IsRecording() && !buffer_->IsStreaming())
         {
             buffer_->StartRecording();
         }
@@ -461,11 +533,19 @@ public:
             buffer_->StopRecording();
         }
 
-        if (patchState_->clearLooperFlag)
+        if (patchState_->clearLooperFlag && buffer_->GetStream()->IsLoading())
+        {
+            // A stream window is still being read into the buffer: wait for
+            // it, closing the stream now would let the read land after the
+            // buffer was cleared.
+            output.clear();
+        }
+        else if (patchState_->clearLooperFlag)
         {
             output.clear();
             patchState_->clearLooperFlag = false;
             cleared_ = true;
+            StopStream();
         }
         else if (cleared_)
         {
@@ -2,6 +2,7 @@
 
 #include "Commons.h"
 #include "EnvFollower.h"
+#include "LooperStream.h"
 #include <algorithm>
 
 enum PlaybackDirection
@@ -47,9 +48,14 @@ public:
     }
     ~WriteHead() {}
 
-    static WriteHead* create(FloatArray* buffer)
+    static WriteHead* create(Arena& arena, FloatArray* buffer)
     {
-        return new WriteHead(buffer);
+        return new (arena, Placement::Hot) WriteHead(buffer);
+    }
+
+    static void reserve(Arena& arena)
+    {
+        arena.reserve(sizeof(WriteHead), Placement::Hot);
     }
 
     static void destroy(WriteHead* obj)
@@ -126,10 +132,17 @@ private:
 
     WriteHead* writeHeads_[2];
 
+    LooperStream* stream_;
+
+    // Frames changed since the last TakeWritten().
+    int32_t writtenStart_;
+    int32_t writtenFrames_;
+    uint32_t streamLoads_;
+
 public:
-    LooperBuffer()
+    LooperBuffer(Arena& arena)
     {
-        buffer_ = FloatArray::create(kLooperTotalBufferLength);
+        buffer_ = FloatArray::create(arena, kLooperTotalBufferLength, Placement::Bulk);
         buffer_.noise();
         buffer_.multiply(kLooperNoiseLevel); // Tame the noise a bit
 
@@ -137,8 +150,14 @@ public:
 
         for (size_t i = 0; i < 2; i++)
         {
-            writeHeads_[i] = WriteHead::create(&buffer_);
+            writeHeads_[i] = WriteHead::create(arena, &buffer_);
         }
+
+        stream_ = LooperStream::create(arena, buffer_.getData());
+
+        writtenStart_ = 0;
+        writtenFrames_ = 0;
+        streamLoads_ = 0;
     }
     ~LooperBuffer()
     {
@@ -146,11 +165,23 @@ public:
         {
             WriteHead::destroy(writeHeads_[i]);
         }
+        LooperStream::destroy(stream_);
     }
 
-    static LooperBuffer* create()
+    static LooperBuffer* create(Arena& arena)
     {
-        return new LooperBuffer();
+        return new (arena, Placement::Cold) LooperBuffer(arena);
+    }
+
+    static void reserve(Arena& arena)
+    {
+        arena.reserve(sizeof(LooperBuffer), Placement::Cold);
+        FloatArray::reserve(arena, kLooperTotalBufferLength, Placement::Bulk);
+        for (size_t i = 0; i < 2; i++)
+        {
+            WriteHead::reserve(arena);
+        }
+        LooperStream::reserve(arena);
     }
 
     static void destroy(LooperBuffer* obj)
@@ -163,6 +194,16 @@ public:
         return &buffer_;
     }
 
+    LooperStream* GetStream()
+    {
+        return stream_;
+    }
+
+    inline bool IsStreaming()
+    {
+        return stream_->IsOpen();
+    }
+
     inline bool Clear()
     {
         if (clearBlock_ == buffer_.getData() + kLooperTotalBufferLength)
@@ -173,15 +214,67 @@ public:
         }
 
         memset(clearBlock_, 0, kLooperClearBlockTypeSize);
+        MarkWritten((clearBlock_ - buffer_.getData()) / 2, kLooperClearBlockSize / 2);
         clearBlock_ += kLooperClearBlockSize;
 
         return false;
     }
 
+    /**
+     * @brief Records that frames [start, start + frames) have changed, for
+     *        readers that keep a copy of part of the buffer. Consecutive
+     *        spans (recording, clearing) are merged, anything else counts as
+     *        a change of the whole buffer.
+     */
+    inline void MarkWritten(int32_t start, int32_t frames)
+    {
+        if (writtenFrames_ == 0)
+        {
+            writtenStart_ = start;
+            writtenFrames_ = frames;
+        }
+        else if (start == (writtenStart_ + writtenFrames_) % kLooperChannelBufferLength)
+        {
+            writtenFrames_ += frames;
+        }
+        else
+        {
+            writtenFrames_ = kLooperChannelBufferLength;
+        }
+        if (writtenFrames_ > kLooperChannelBufferLength)
+        {
+            writtenFrames_ = kLooperChannelBufferLength;
+        }
+    }
+
+    /**
+     * @brief Returns true and the span changed since the last call, if any.
+     *        While a file is streamed its windows overwrite the buffer, each
+     *        completed read counts as a change of the whole buffer.
+     */
+    bool TakeWritten(int32_t& start, int32_t& frames)
+    {
+        uint32_t loads = stream_->GetLoads();
+        if (loads != streamLoads_)
+        {
+            streamLoads_ = loads;
+            MarkWritten(0, kLooperChannelBufferLength);
+        }
+        if (writtenFrames_ == 0)
+        {
+            return false;
+        }
+        start = writtenStart_;
+        frames = writtenFrames_;
+        writtenFrames_ = 0;
+
+        return true;
+    }
+
     inline void Write(uint32_t i, float left, float right)
     {
-        writeHeads_[LEFT_CHANNEL]->Write(i, left);
-        writeHeads_[RIGHT_CHANNEL]->Write(i + kLooperChannelBufferLength, right);
+        writeHeads_[LEFT_CHANNEL]->Write(i * 2, left);
+        writeHeads_[RIGHT_CHANNEL]->Write(i * 2 + 1, right);
     }
 
     inline bool IsRecording()
@@ -201,7 +294,9 @@ public:
         writeHeads_[RIGHT_CHANNEL]->Stop();
     }
 
-    inline float ReadLeft(int32_t position)
+    // The buffer is interleaved: frame i is buffer_[2i] (left) and
+    // buffer_[2i + 1] (right), so one lookup serves both channels.
+    inline const float* Frame(int32_t position)
     {
         while (position >= kLooperChannelBufferLength)
         {
@@ -212,40 +307,57 @@ public:
             position += kLooperChannelBufferLength;
         }
 
-        return buffer_[position];
+        return buffer_.getData() + position * 2;
     }
 
-    inline float ReadRight(int32_t position)
+    inline void Read(double p, float &left, float &right, PlaybackDirection direction = PLAYBACK_FORWARD)
     {
-        position += kLooperChannelBufferLength;
+        int32_t i = int32_t(p);
 
-        while (position >= kLooperTotalBufferLength)
-        {
-            position -= kLooperChannelBufferLength;
-        }
-        while (position < kLooperChannelBufferLength)
+        float f = p - i;
+
+        if (stream_->IsOpen())
         {
-            position += kLooperChannelBufferLength;
+            // Streamed files are mono.
+            float l0 = stream_->Read(i);
+            float l1 = stream_->Read(i + direction);
+            left = right = l0 + direction * (l1 - l0) * f;
+
+            return;
         }
 
-        return buffer_[position];
+        const float* f0 = Frame(i);
+        const float* f1 = Frame(i + direction);
+        left = f0[0] + direction * (f1[0] - f0[0]) * f;
+        right = f0[1] + direction * (f1[1] - f0[1]) * f;
     }
 
-    inline void Read(float p, float &left, float &right, PlaybackDirection direction = PLAYBACK_FORWARD)
+    /**
+     * @brief Reads the play head and the crossfade head together, for the
+     *        samples where the looper fades between two positions.
+     */
+    inline void Read(double p, double q, float &left, float &right, float &fadeLeft, float &fadeRight, PlaybackDirection direction = PLAYBACK_FORWARD)
     {
-        float l0, l1;
-        float r0, r1;
+        if (stream_->IsOpen())
+        {
+            Read(p, left, right, direction);
+            Read(q, fadeLeft, fadeRight, direction);
 
-        int32_t i = int32_t(p);
+            return;
+        }
 
+        int32_t i = int32_t(p);
+        int32_t j = int32_t(q);
         float f = p - i;
-
-        l0 = ReadLeft(i);
-        l1 = ReadLeft(i + direction);
-        left = l0 + direction * (l1 - l0) * f;
-
-        r0 = ReadRight(i);
-        r1 = ReadRight(i + direction);
-        right = r0 + direction * (r1 - r0) * f;
+        float g = q - j;
+
+        const float* f0 = Frame(i);
+        const float* f1 = Frame(i + direction);
+        const float* g0 = Frame(j);
+        const float* g1 = Frame(j + direction);
+        left = f0[0] + direction * (f1[0] - f0[0]) * f;
+        right = f0[1] + direction * (f1[1] - f0[1]) * f;
+        fadeLeft = g0[0] + direction * (g1[0] - g0[0]) * g;
+        fadeRight = g0[1] + direction * (g1[1] - g0[1]) * g;
     }
 };
\ No newline at end of file
@@ -0,0 +1,314 @@
+#pragma once
+
+#include "Commons.h"
+#include <stdint.h>
+
+/**
+ * @brief Plays a mono file longer than the looper buffer by keeping two
+ *        windows of it resident and refilling them from the SD card.
+ *        The windows reuse the looper's own memory (one channel each), so
+ *        streaming costs no extra RAM.
+ *
+ *        The looper reports where its head is once per block with SetHead().
+ *        NextRequest() then says which window has to be refilled so that the
+ *        frames the head reaches next are resident in time: the ones after
+ *        the current window or, when the loop wraps first, the ones at the
+ *        loop start (mirrored when playing backwards). The platform code
+ *        performs the read and calls Loaded() when it completes. Frames that
+ *        are not resident (after a jump, or if the card falls behind) read as
+ *        silence.
+ */
+class LooperStream
+{
+public:
+    static const int kWindows = 2;
+    static const int32_t kWindowFrames = kLooperChannelBufferLength;
+
+    struct Request
+    {
+        float* dst;
+        int32_t start;
+        int32_t frames;
+    };
+
+private:
+    struct Window
+    {
+        float* data;
+        int32_t start;
+        int32_t frames;
+        volatile bool ready;
+    };
+
+    Window windows_[kWindows];
+
+    int32_t length_;
+    int32_t head_;
+    int32_t next_;
+    int32_t loopStart_, loopEnd_;
+    int direction_;
+
+    volatile int loading_;
+    int lastLoaded_;
+
+    uint32_t underruns_;
+    volatile uint32_t loads_;
+
+    inline int Find(int32_t frame)
+    {
+        for (int i = 0; i < kWindows; i++)
+        {
+            const Window& w = windows_[i];
+            if (w.ready && uint32_t(frame - w.start) < uint32_t(w.frames))
+            {
+                return i;
+            }
+        }
+
+        return -1;
+    }
+
+    inline int32_t Wrap(int32_t frame)
+    {
+        while (frame >= length_)
+        {
+            frame -= length_;
+        }
+        while (frame < 0)
+        {
+            frame += length_;
+        }
+
+        return frame;
+    }
+
+    // Whether a window holds, or is being filled with, the given frame.
+    inline bool Covers(int i, int32_t frame)
+    {
+        const Window& w = windows_[i];
+
+        return (w.ready || loading_ == i) && uint32_t(frame - w.start) < uint32_t(w.frames);
+    }
+
+public:
+    LooperStream(float* memory)
+    {
+        for (int i = 0; i < kWindows; i++)
+        {
+            windows_[i].data = memory + i * kWindowFrames;
+        }
+        length_ = 0;
+        loading_ = -1;
+        loads_ = 0;
+        Close();
+    }
+    ~LooperStream() {}
+
+    static LooperStream* create(Arena& arena, float* memory)
+    {
+        return new (arena) LooperStream(memory);
+    }
+
+    static void reserve(Arena& arena)
+    {
+        arena.reserve(sizeof(LooperStream));
+    }
+
+    static void destroy(LooperStream* obj)
+    {
+        //delete obj;
+    }
+
+    // Starts streaming a file of the given length. Call only while
+    // IsLoading() is false.
+    void Open(int32_t length)
+    {
+        Close();
+        length_ = length;
+    }
+
+    // Call only while IsLoading() is false: the read still lands in the
+    // window memory, which the caller may be reusing by then. IsLoading()
+    // stays set until that read completes, its window is empty so the late
+    // data is never played.
+    void Close()
+    {
+        for (int i = 0; i < kWindows; i++)
+        {
+            windows_[i].start = 0;
+            windows_[i].frames = 0;
+            windows_[i].ready = false;
+        }
+        length_ = 0;
+        head_ = 0;
+        next_ = -1; // Unknown until the first SetHead()
+        loopStart_ = loopEnd_ = 0;
+        direction_ = 1;
+        lastLoaded_ = kWindows - 1;
+        underruns_ = 0;
+    }
+
+    inline bool IsOpen()
+    {
+        return length_ > 0;
+    }
+
+    inline bool IsLoading()
+    {
+        return loading_ >= 0;
+    }
+
+    inline int32_t GetLength()
+    {
+        return length_;
+    }
+
+    inline uint32_t GetUnderruns()
+    {
+        return underruns_;
+    }
+
+    // Number of completed reads, each one changed the looper memory.
+    inline uint32_t GetLoads()
+    {
+        return loads_;
+    }
+
+    inline float Read(int32_t frame)
+    {
+        frame = Wrap(frame);
+        int i = Find(frame);
+        if (i < 0)
+        {
+            underruns_++;
+
+            return 0.f;
+        }
+
+        return windows_[i].data[frame - windows_[i].start];
+    }
+
+    /**
+     * @brief Called by the looper after each block.
+     *
+     * @param start     First frame of the loop
+     * @param length    Loop length in frames
+     * @param phase     Head position inside the loop, 0..length
+     * @param direction A PlaybackDirection: 1, -1 or 0 when stalled
+     */
+    void SetHead(int32_t start, int32_t length, double phase, int direction)
+    {
+        if (!IsOpen())
+        {
+            return;
+        }
+
+        int32_t p = int32_t(phase);
+        head_ = Wrap(start + p);
+        loopStart_ = Wrap(start);
+        loopEnd_ = Wrap(start + length);
+        if (direction != 0)
+        {
+            direction_ = direction;
+        }
+
+        int cw = Find(head_);
+        if (cw < 0)
+        {
+            next_ = head_;
+
+            return;
+        }
+
+        const Window& w = windows_[cw];
+        if (direction_ < 0)
+        {
+            // Frames left in the window vs. in the loop before it wraps.
+            int32_t behind = head_ - w.start + 1;
+            next_ = behind > p ? Wrap(start + length - 1) : Wrap(w.start - 1);
+        }
+        else
+        {
+            int32_t ahead = w.start + w.frames - head_;
+            next_ = ahead >= length - p ? Wrap(start) : Wrap(w.start + w.frames);
+        }
+    }
+
+    /**
+     * @brief Returns true and fills the request if a window has to be
+     *        refilled. The window is marked as loading until Loaded() is
+     *        called, only one request is in flight at a time.
+     */
+    bool NextRequest(Request& request)
+    {
+        if (!IsOpen() || IsLoading() || next_ < 0)
+        {
+            return false;
+        }
+        for (int i = 0; i < kWindows; i++)
+        {
+            if (Covers(i, next_))
+            {
+                return false;
+            }
+        }
+
+        // Never overwrite the window under the head, otherwise take the one
+        // that was filled first.
+        int cw = Find(head_);
+        int target = cw >= 0 ? (cw + 1) % kWindows : (lastLoaded_ + 1) % kWindows;
+
+        int32_t frames = length_ < kWindowFrames ? length_ : kWindowFrames;
+        // If the loop wraps inside the new window, align the window with the
+        // wrap point: a short leftover window would be played through before
+        // the other one could be refilled with the loop's other end.
+        int32_t start = next_;
+        if (direction_ < 0)
+        {
+            start = next_ - frames + 1;
+            if (loopStart_ > start && loopStart_ <= next_)
+            {
+                start = loopStart_;
+            }
+        }
+        else if (loopEnd_ > next_ && loopEnd_ < next_ + frames)
+        {
+            start = loopEnd_ - frames;
+        }
+        // Slide rather than shrink at the ends of the file, for the same reason.
+        if (start + frames > length_)
+        {
+            start = length_ - frames;
+        }
+        if (start < 0)
+        {
+            start = 0;
+        }
+
+        Window& w = windows_[target];
+        w.ready = false;
+        w.start = start;
+        w.frames = frames;
+        loading_ = target;
+
+        request.dst = w.data;
+        request.start = start;
+        request.frames = frames;
+
+        return true;
+    }
+
+    // Called from the SD card thread when the last request completes.
+    void Loaded(bool success)
+    {
+        int i = loading_;
+        if (i < 0)
+        {
+            return;
+        }
+        windows_[i].ready = success;
+        lastLoaded_ = i;
+        loads_++;
+        loading_ = -1;
+    }
+};
@@ -34,9 +34,14 @@ public:
     }
     ~LorenzAttractor() {}
 
-    static LorenzAttractor* create(float sr)
+    static LorenzAttractor* create(Arena& arena, float sr)
     {
-        return new LorenzAttractor(sr);
+        return new (arena, Placement::Cold) LorenzAttractor(sr);
+    }
+
+    static void reserve(Arena& arena)
+    {
+        arena.reserve(sizeof(LorenzAttractor), Placement::Cold);
     }
 
     static void destroy(LorenzAttractor* obj)
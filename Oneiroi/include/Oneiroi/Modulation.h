@@ -37,7 +37,7 @@ private:
     bool freqReset_;
 
 public:
-    Modulation(PatchCtrls* patchCtrls, PatchCvs* patchCvs, PatchState* patchState)
+    Modulation(Arena& arena, PatchCtrls* patchCtrls, PatchCvs* patchCvs, PatchState* patchState)
     {
         patchCtrls_ = patchCtrls;
         patchCvs_ = patchCvs;
@@ -45,14 +45,14 @@ public:
 
         source_ = ModulationSource::MOD_SOURCE_LFO;
 
-        lfo_ = MorphingOscillator::create(NOF_SHAPES, patchState_->blockSize);
-        lfo_->setOscillator(LORENZ, LorenzAttractor::create(patchState_->blockRate));
-        lfo_->setOscillator(SINE, PhaseShiftOscillator<SineOscillator>::create(0, patchState_->blockRate));
-        lfo_->setOscillator(INVERTED_RAMP, PhaseShiftOscillator<InvertedRampOscillator>::create(0, patchState_->blockRate));
-        lfo_->setOscillator(RAMP, PhaseShiftOscillator<RampOscillator>::create(0, patchState_->blockRate));
-        lfo_->setOscillator(SQUARE, PhaseShiftOscillator<SquareWaveOscillator>::create(0, patchState_->blockRate));
-        lfo_->setOscillator(SH, NoiseOscillator::create(patchState_->blockRate));
-        lfo_->setOscillator(EF, EnvelopeFollowerMod::create(patchCtrls_, patchState_));
+        lfo_ = MorphingOscillator::create(arena, NOF_SHAPES, patchState_->blockSize);
+        lfo_->setOscillator(LORENZ, LorenzAttractor::create(arena, patchState_->blockRate));
+        lfo_->setOscillator(SINE, PhaseShiftOscillator<SineOscillator>::create(arena, 0, patchState_->blockRate));
+        lfo_->setOscillator(INVERTED_RAMP, PhaseShiftOscillator<InvertedRampOscillator>::create(arena, 0, patchState_->blockRate));
+        lfo_->setOscillator(RAMP, PhaseShiftOscillator<RampOscillator>::create(arena, 0, patchState_->blockRate));
+        lfo_->setOscillator(SQUARE, PhaseShiftOscillator<SquareWaveOscillator>::create(arena, 0, patchState_->blockRate));
+        lfo_->setOscillator(SH, NoiseOscillator::create(arena, patchState_->blockRate));
+        lfo_->setOscillator(EF, EnvelopeFollowerMod::create(arena, patchCtrls_, patchState_));
         lfo_->setFrequency(kInternalClockFreq);
         lfo_->morph(0.f);
 
@@ -70,9 +70,22 @@ public:
         MorphingOscillator::destroy(lfo_);
     }
 
-    static Modulation* create(PatchCtrls* patchCtrls, PatchCvs* patchCvs, PatchState* patchState)
+    static Modulation* create(Arena& arena, PatchCtrls* patchCtrls, PatchCvs* patchCvs, PatchState* patchState)
     {
-        return new Modulation(patchCtrls, patchCvs, patchState);
+        return new (arena, Placement::Cold) Modulation(arena, patchCtrls, patchCvs, patchState);
+    }
+
+    static void reserve(Arena& arena, PatchState* patchState)
+    {
+        arena.reserve(sizeof(Modulation), Placement::Cold);
+        MorphingOscillator::reserve(arena, NOF_SHAPES, patchState->blockSize);
+        LorenzAttractor::reserve(arena);
+        PhaseShiftOscillator<SineOscillator>::reserve(arena);
+        PhaseShiftOscillator<InvertedRampOscillator>::reserve(arena);
+        PhaseShiftOscillator<RampOscillator>::reserve(arena);
+        PhaseShiftOscillator<SquareWaveOscillator>::reserve(arena);
+        NoiseOscillator::reserve(arena);
+        EnvelopeFollowerMod::reserve(arena);
     }
 
     static void destroy(Modulation* obj)
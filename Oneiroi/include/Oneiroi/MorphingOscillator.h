@@ -94,10 +94,18 @@ public:
     lo = hi;
     hi = oscillator;
   }
-  static MorphingOscillator* create(size_t oscillator_count, size_t blocksize){
-    return new MorphingOscillator(new Oscillator*[oscillator_count], oscillator_count,
-				  FloatArray::create(blocksize));
+  static MorphingOscillator* create(Arena& arena, size_t oscillator_count, size_t blocksize){
+    // One allocation per statement, so the order is the one reserve() counts.
+    void* obj = operator new(sizeof(MorphingOscillator), arena, Placement::Cold);
+    Oscillator** osc = new (arena) Oscillator*[oscillator_count];
+    FloatArray buffer = FloatArray::create(arena, blocksize);
+    return new (obj) MorphingOscillator(osc, oscillator_count, buffer);
   }  
+  static void reserve(Arena& arena, size_t oscillator_count, size_t blocksize){
+    arena.reserve(sizeof(MorphingOscillator), Placement::Cold);
+    arena.reserve(oscillator_count*sizeof(Oscillator*));
+    FloatArray::reserve(arena, blocksize);
+  }
   static void destroy(MorphingOscillator* obj){
     FloatArray::destroy(obj->buffer);
     delete[] obj->osc;
@@ -28,8 +28,8 @@ class WhiteNoiseGenerator : public SignalGenerator {
 #endif
   }
   using SignalGenerator::generate;
-  static WhiteNoiseGenerator* create(){
-    return new WhiteNoiseGenerator();
+  static WhiteNoiseGenerator* create(Arena& arena){
+    return new (arena) WhiteNoiseGenerator();
   }
   static void destroy(WhiteNoiseGenerator* osc){
     delete osc;
@@ -87,8 +87,8 @@ public:
     return (WhiteNoiseGenerator::generate() + m_pink)*0.125f; 
   }
   using SignalGenerator::generate;
-  static PinkNoiseGenerator* create(){
-    return new PinkNoiseGenerator();
+  static PinkNoiseGenerator* create(Arena& arena){
+    return new (arena) PinkNoiseGenerator();
   }
   static void destroy(PinkNoiseGenerator* osc){
     delete osc;
@@ -122,8 +122,8 @@ public:
     return m_brown*0.0625f;
   }  
   using SignalGenerator::generate;
-  static BrownNoiseGenerator* create(){
-    return new BrownNoiseGenerator();
+  static BrownNoiseGenerator* create(Arena& arena){
+    return new (arena) BrownNoiseGenerator();
   }
   static void destroy(BrownNoiseGenerator* osc){
     delete osc;
@@ -140,8 +140,8 @@ public:
     FloatArray::destroy(gn->noise);
     delete gn;
   }
-  static GaussianNoiseGenerator* create(int size){
-    GaussianNoiseGenerator* gn = new GaussianNoiseGenerator(FloatArray::create(size));
+  static GaussianNoiseGenerator* create(Arena& arena, int size){
+    GaussianNoiseGenerator* gn = new (arena) GaussianNoiseGenerator(FloatArray::create(arena, size));
     // generate white gaussian noise:
     // from http://www.musicdsp.org/showone.php?id=168
     /* Setup constants */
@@ -17,6 +17,7 @@
 #include "Modulation.h"
 #include "Limiter.h"
 #include "Clock.h"
+#include "ActivityTracker.h"
 
 class Oneiroi
 {
@@ -34,7 +35,6 @@ private:
     Echo* echo_;
     Ambience* ambience_;
     Looper* looper_;
-    Limiter* limiter_;
     Clock* clock_;
 
     Modulation* modulation_;
@@ -44,6 +44,10 @@ private:
     AudioBuffer* osc1Out_;
     AudioBuffer* osc2Out_;
 
+    ActivityTracker* resonatorActivity_;
+    ActivityTracker* echoActivity_;
+    ActivityTracker* ambienceActivity_;
+
     StereoDcBlockingFilter* inputDcFilter_;
     StereoDcBlockingFilter* outputDcFilter_;
 
@@ -51,43 +55,74 @@ private:
 
     FilterPosition filterPosition_, lastFilterPosition_;
 
+    // Mean square of a block, on the same scale as the effects' GetWetEnergy().
+    static float Energy(AudioBuffer &buffer)
+    {
+        const float* left = buffer.getSamples(LEFT_CHANNEL).getData();
+        const float* right = buffer.getSamples(RIGHT_CHANNEL).getData();
+        size_t size = buffer.getSize();
+        float energy = 0;
+        for (size_t i = 0; i < size; i++)
+        {
+            energy += left[i] * left[i] + right[i] * right[i];
+        }
+
+        return energy / size;
+    }
+
+    // Runs an effect while its mix control is open and it has input or a tail
+    // to play. While it is skipped the block passes through dry.
+    template <class Effect>
+    void ProcessEffect(Effect* effect, ActivityTracker* activity, float vol, AudioBuffer &buffer)
+    {
+        float inputEnergy = Energy(buffer);
+        if (!activity->Wake(vol, inputEnergy))
+        {
+            return;
+        }
+        effect->process(buffer, buffer);
+        activity->Update(inputEnergy, effect->GetWetEnergy());
+    }
+
 public:
-    Oneiroi(PatchCtrls* patchCtrls, PatchCvs* patchCvs, PatchState* patchState)
+    Oneiroi(Arena& arena, PatchCtrls* patchCtrls, PatchCvs* patchCvs, PatchState* patchState)
     {
         patchCtrls_ = patchCtrls;
         patchCvs_ = patchCvs;
         patchState_ = patchState;
 
-        looper_ = Looper::create(patchCtrls_, patchCvs_, patchState_);
-        wtBuffer_ = WaveTableBuffer::create(looper_->GetBuffer());
+        looper_ = Looper::create(arena, patchCtrls_, patchCvs_, patchState_);
+        wtBuffer_ = WaveTableBuffer::create(arena, looper_->GetLooperBuffer());
 
-        sine_ = StereoSineOscillator::create(patchCtrls_, patchCvs_, patchState_);
-        saw_ = StereoSuperSaw::create(patchCtrls_, patchCvs_, patchState_);
-        wt_ = StereoWaveTableOscillator::create(patchCtrls_, patchCvs_, patchState_, wtBuffer_);
+        sine_ = StereoSineOscillator::create(arena, patchCtrls_, patchCvs_, patchState_);
+        saw_ = StereoSuperSaw::create(arena, patchCtrls_, patchCvs_, patchState_);
+        wt_ = StereoWaveTableOscillator::create(arena, patchCtrls_, patchCvs_, patchState_, wtBuffer_);
 
-        filter_ = Filter::create(patchCtrls_, patchCvs_, patchState_);
-        resonator_ = Resonator::create(patchCtrls_, patchCvs_, patchState_);
-        echo_ = Echo::create(patchCtrls_, patchCvs_, patchState_);
-        ambience_ = Ambience::create(patchCtrls_, patchCvs_, patchState_);
+        filter_ = Filter::create(arena, patchCtrls_, patchCvs_, patchState_);
+        resonator_ = Resonator::create(arena, patchCtrls_, patchCvs_, patchState_);
+        echo_ = Echo::create(arena, patchCtrls_, patchCvs_, patchState_);
+        ambience_ = Ambience::create(arena, patchCtrls_, patchCvs_, patchState_);
 
-        modulation_ = Modulation::create(patchCtrls_, patchCvs_, patchState_);
-        clock_ = Clock::create(patchCtrls_, patchState_);
+        modulation_ = Modulation::create(arena, patchCtrls_, patchCvs_, patchState_);
+        clock_ = Clock::create(arena, patchCtrls_, patchState_);
 
-        limiter_ = Limiter::create();
+        input_ = NTSampleBuffer::create(arena, 2, patchState_->blockSize);
+        resample_ = NTSampleBuffer::create(arena, 2, patchState_->blockSize);
+        osc1Out_ = NTSampleBuffer::create(arena, 2, patchState_->blockSize);
+        osc2Out_ = NTSampleBuffer::create(arena, 2, patchState_->blockSize);
 
-        input_ = NTSampleBuffer::create(2, patchState_->blockSize);
-        resample_ = NTSampleBuffer::create(2, patchState_->blockSize);
-        osc1Out_ = NTSampleBuffer::create(2, patchState_->blockSize);
-        osc2Out_ = NTSampleBuffer::create(2, patchState_->blockSize);
+        resonatorActivity_ = ActivityTracker::create(arena, kResoBufferSize, patchState_->blockSize);
+        echoActivity_ = ActivityTracker::create(arena, kEchoMaxLengthSamples, patchState_->blockSize);
+        ambienceActivity_ = ActivityTracker::create(arena, kAmbienceBufferSize, patchState_->blockSize);
 
         for (size_t i = 0; i < 2; i++)
         {
-            inEnvFollower_[i] = EnvFollower::create();
+            inEnvFollower_[i] = EnvFollower::create(arena);
             inEnvFollower_[i]->setLambda(0.9f);
         }
 
-        inputDcFilter_ = StereoDcBlockingFilter::create();
-        outputDcFilter_ = StereoDcBlockingFilter::create();
+        inputDcFilter_ = StereoDcBlockingFilter::create(arena);
+        outputDcFilter_ = StereoDcBlockingFilter::create(arena);
     }
     ~Oneiroi()
     {
@@ -95,6 +130,9 @@ public:
         AudioBuffer::destroy(resample_);
         AudioBuffer::destroy(osc1Out_);
         AudioBuffer::destroy(osc2Out_);
+        ActivityTracker::destroy(resonatorActivity_);
+        ActivityTracker::destroy(echoActivity_);
+        ActivityTracker::destroy(ambienceActivity_);
         WaveTableBuffer::destroy(wtBuffer_);
         Looper::destroy(looper_);
         StereoSineOscillator::destroy(sine_);
@@ -105,7 +143,6 @@ public:
         Echo::destroy(echo_);
         Ambience::destroy(ambience_);
         Modulation::destroy(modulation_);
-        Limiter::destroy(limiter_);
 
         for (size_t i = 0; i < 2; i++)
         {
@@ -113,33 +150,180 @@ public:
         }
     }
 
-    static Oneiroi* create(PatchCtrls* patchCtrls, PatchCvs* patchCvs, PatchState* patchState)
+    static Oneiroi* create(Arena& arena, PatchCtrls* patchCtrls, PatchCvs* patchCvs, PatchState* patchState)
     {
-        return new Oneiroi(patchCtrls, patchCvs, patchState);
+        return new (arena) Oneiroi(arena, patchCtrls, patchCvs, patchState);
     }
 
-    // Returns the raw float buffer underlying the looper (L then R, each kLooperChannelBufferLength samples).
+    // The allocations of create(), counted on a sizing arena. Keep it in step
+    // with the constructor above.
+    static void reserve(Arena& arena, PatchState* patchState)
+    {
+        arena.reserve(sizeof(Oneiroi));
+
+        Looper::reserve(arena, patchState);
+        WaveTableBuffer::reserve(arena);
+
+        StereoSineOscillator::reserve(arena);
+        StereoSuperSaw::reserve(arena);
+        StereoWaveTableOscillator::reserve(arena);
+
+        Filter::reserve(arena);
+        Resonator::reserve(arena);
+        Echo::reserve(arena);
+        Ambience::reserve(arena, patchState);
+
+        Modulation::reserve(arena, patchState);
+        Clock::reserve(arena);
+
+        for (size_t i = 0; i < 4; i++)
+        {
+            NTSampleBuffer::reserve(arena, 2, patchState->blockSize);
+        }
+
+        for (size_t i = 0; i < 3; i++)
+        {
+            ActivityTracker::reserve(arena);
+        }
+
+        for (size_t i = 0; i < 2; i++)
+        {
+            EnvFollower::reserve(arena);
+        }
+
+        StereoDcBlockingFilter::reserve(arena);
+        StereoDcBlockingFilter::reserve(arena);
+    }
+
+    // Returns the raw float buffer underlying the looper (kLooperChannelBufferLength interleaved L/R frames).
     // Used by the NT glue layer to inject pre-loaded audio into the looper.
     FloatArray* GetLooperFloatArray() { return looper_->GetBuffer(); }
+    // Call after filling the looper buffer directly.
+    void LooperBufferLoaded() { looper_->GetLooperBuffer()->MarkWritten(0, kLooperChannelBufferLength); }
+
+    // Streaming of files longer than the looper buffer. The NT glue layer
+    // serves the stream's read requests and starts/stops it from step().
+    LooperStream* GetLooperStream() { return looper_->GetStream(); }
+    void StartLooperStream(int32_t length) { looper_->StartStream(length); }
+    void StopLooperStream() { looper_->StopStream(); }
 
     static void destroy(Oneiroi* obj)
     {
         //delete obj;
     }
 
-    inline void Process(AudioBuffer &buffer)
+    /**
+     * Fused input stage: reads the host input (inR may equal inL, both may be
+     * null for silence), applies the input level and the DC blocker and fills
+     * both buffer and input_ in a single pass.
+     */
+    inline void ProcessInput(const float* inL, const float* inR, AudioBuffer &buffer)
+    {
+        float* left = buffer.getSamples(LEFT_CHANNEL).getData();
+        float* right = buffer.getSamples(RIGHT_CHANNEL).getData();
+        float* dryLeft = input_->getSamples(LEFT_CHANNEL).getData();
+        float* dryRight = input_->getSamples(RIGHT_CHANNEL).getData();
+        size_t size = buffer.getSize();
+        float vol = patchCtrls_->inputVol;
+
+        for (size_t i = 0; i < size; i++)
+        {
+            float l = inL != nullptr ? inL[i] * vol : 0.f;
+            float r = inR != nullptr ? inR[i] * vol : 0.f;
+            inputDcFilter_->process(l, r);
+            left[i] = dryLeft[i] = l;
+            right[i] = dryRight[i] = r;
+        }
+    }
+
+    /**
+     * Fused sources stage: buffer (looper output) + dry input + oscillators,
+     * times kSourcesMakeupGain, in a single pass.
+     */
+    inline void MixSources(AudioBuffer &buffer, bool osc1, bool osc2)
+    {
+        float* left = buffer.getSamples(LEFT_CHANNEL).getData();
+        float* right = buffer.getSamples(RIGHT_CHANNEL).getData();
+        const float* dryLeft = input_->getSamples(LEFT_CHANNEL).getData();
+        const float* dryRight = input_->getSamples(RIGHT_CHANNEL).getData();
+        const float* osc1Left = osc1Out_->getSamples(LEFT_CHANNEL).getData();
+        const float* osc1Right = osc1Out_->getSamples(RIGHT_CHANNEL).getData();
+        const float* osc2Left = osc2Out_->getSamples(LEFT_CHANNEL).getData();
+        const float* osc2Right = osc2Out_->getSamples(RIGHT_CHANNEL).getData();
+        size_t size = buffer.getSize();
+
+        for (size_t i = 0; i < size; i++)
+        {
+            float l = left[i] + dryLeft[i];
+            float r = right[i] + dryRight[i];
+            if (osc1)
+            {
+                l += osc1Left[i];
+                r += osc1Right[i];
+            }
+            if (osc2)
+            {
+                l += osc2Left[i];
+                r += osc2Right[i];
+            }
+            left[i] = l * kSourcesMakeupGain;
+            right[i] = r * kSourcesMakeupGain;
+        }
+    }
+
+    /**
+     * Fused output stage: DC blocker, makeup gain, soft limiter and output
+     * level (or silence during startup) in a single pass. Writes the result
+     * to resample_ and to the host outputs, replacing or adding to them.
+     */
+    inline void ProcessOutput(AudioBuffer &buffer, float* outL, float* outR, bool replaceL, bool replaceR)
+    {
+        const float* left = buffer.getSamples(LEFT_CHANNEL).getData();
+        const float* right = buffer.getSamples(RIGHT_CHANNEL).getData();
+        float* resampleLeft = resample_->getSamples(LEFT_CHANNEL).getData();
+        float* resampleRight = resample_->getSamples(RIGHT_CHANNEL).getData();
+        size_t size = buffer.getSize();
+        bool running = StartupPhase::STARTUP_DONE == patchState_->startupPhase;
+        float level = patchState_->outLevel;
+
+        for (size_t i = 0; i < size; i++)
+        {
+            float l = left[i];
+            float r = right[i];
+            outputDcFilter_->process(l, r);
+            l = SoftLimit(l * kOutputMakeupGain);
+            r = SoftLimit(r * kOutputMakeupGain);
+            if (running)
+            {
+                l *= level;
+                r *= level;
+            }
+            else
+            {
+                // TODO: Fade in
+                l = 0.f;
+                r = 0.f;
+            }
+            resampleLeft[i] = l;
+            resampleRight[i] = r;
+            outL[i] = replaceL ? l : outL[i] + l;
+            outR[i] = replaceR ? r : outR[i] + r;
+        }
+    }
+
+    /**
+     * Renders one block from the host input to the host outputs. buffer is
+     * the working buffer, sized to the block.
+     */
+    inline void Process(const float* inL, const float* inR, AudioBuffer &buffer, float* outL, float* outR, bool replaceL, bool replaceR)
     {
         patchState_->debugvalue2 = patchCtrls_->inputVol;
-        buffer.multiply(patchCtrls_->inputVol);
-        inputDcFilter_->process(buffer, buffer);
+        ProcessInput(inL, inR, buffer);
 
         if (patchCtrls_->modLevel > 0.f) modulation_->Process();
         
         clock_->Process();
 
-        input_->copyFrom(buffer);
-      
-
         if (patchCtrls_->looperResampling)
         {
             if (patchCtrls_->looperVol > 0.f) looper_->Process(*resample_, buffer);
@@ -148,20 +332,19 @@ public:
         {
             if (patchCtrls_->looperVol > 0.f) looper_->Process(buffer, buffer);
         }
-        buffer.add(*input_);
 
-        if (patchCtrls_->osc1Vol > 0.f){
+        bool osc1 = patchCtrls_->osc1Vol > 0.f;
+        if (osc1){
             sine_->Process(*osc1Out_);
-            buffer.add(*osc1Out_);
         }
 
-        osc2Out_->clear();
-        if (patchCtrls_->osc2Vol > 0.f){
+        bool osc2 = patchCtrls_->osc2Vol > 0.f;
+        if (osc2){
+            osc2Out_->clear();
             patchCtrls_->oscUseWavetable > 0.5f ? wt_->Process(*osc2Out_) : saw_->Process(*osc2Out_);
-            buffer.add(*osc2Out_);
         }
 
-        buffer.multiply(kSourcesMakeupGain);
+        MixSources(buffer, osc1, osc2);
 
         if (patchCtrls_->filterPosition < 0.25f)
         {
@@ -195,38 +378,23 @@ public:
         {
             if (patchCtrls_->filterVol > 0.f) filter_->process(buffer, buffer);
         }
-        if (patchCtrls_->resonatorVol > 0.f) resonator_->process(buffer, buffer);
+        ProcessEffect(resonator_, resonatorActivity_, patchCtrls_->resonatorVol, buffer);
         if (FilterPosition::POSITION_2 == filterPosition_)
         {
             if (patchCtrls_->filterVol > 0.f) filter_->process(buffer, buffer);
         }
-        if (patchCtrls_->echoVol > 0.f) echo_->process(buffer, buffer);
+        ProcessEffect(echo_, echoActivity_, patchCtrls_->echoVol, buffer);
         if (FilterPosition::POSITION_3 == filterPosition_)
         {
           if (patchCtrls_->filterVol > 0.f)  filter_->process(buffer, buffer);
         }
-        if (patchCtrls_->ambienceVol > 0.f) ambience_->process(buffer, buffer);
+        ProcessEffect(ambience_, ambienceActivity_, patchCtrls_->ambienceVol, buffer);
         if (FilterPosition::POSITION_4 == filterPosition_)
         {
          if (patchCtrls_->filterVol > 0.f) filter_->process(buffer, buffer);
         }
 
-        outputDcFilter_->process(buffer, buffer);
-
-        buffer.multiply(kOutputMakeupGain);
-        limiter_->ProcessSoft(buffer, buffer);
-
-        if (StartupPhase::STARTUP_DONE == patchState_->startupPhase)
-        {
-            buffer.multiply(patchState_->outLevel);
-        }
-        else
-        {
-            // TODO: Fade in
-            buffer.clear();
-        }
-
-        resample_->copyFrom(buffer);
+        ProcessOutput(buffer, outL, outR, replaceL, replaceR);
     }
 };
 
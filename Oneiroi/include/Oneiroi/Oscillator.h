@@ -112,11 +112,14 @@ public:
     return sample;
   }  
   using BaseOscillator::generate;
-  static T* create(float sr){
-    T* obj = new T();
+  static T* create(Arena& arena, float sr){
+    T* obj = new (arena) T();
     obj->setSampleRate(sr);
     return obj;
   }
+  static void reserve(Arena& arena){
+    arena.reserve(sizeof(T));
+  }
   static void destroy(T* osc){
     delete osc;
   }
@@ -163,9 +166,12 @@ public:
    * @param phaseshift oscillator phase shift in radians
    */
   template <typename... Args>
-  static PhaseShiftOscillator<Osc>* create(float phaseshift, Args&&... args){
-    return new PhaseShiftOscillator<Osc>(phaseshift, std::forward<Args>(args)...);
+  static PhaseShiftOscillator<Osc>* create(Arena& arena, float phaseshift, Args&&... args){
+    return new (arena, Placement::Cold) PhaseShiftOscillator<Osc>(phaseshift, std::forward<Args>(args)...);
   }    
+  static void reserve(Arena& arena){
+    arena.reserve(sizeof(PhaseShiftOscillator<Osc>), Placement::Cold);
+  }
   static void destroy(PhaseShiftOscillator<Osc>* obj){
     Osc::destroy(obj);
   }
@@ -1,167 +1,236 @@
 #pragma once
 
 #include "Commons.h"
-#include "DelayLine.h"
+#include "Interpolator.h"
 #include "BiquadFilter.h"
 #include "EnvFollower.h"
 #include "DcBlockingFilter.h"
 #include "Compressor.h"
 
-class Pole
+/**
+ * @brief The resonator's three poles, advanced together as four lanes.
+ *        Pole 0 is stereo, poles 1 and 2 only ever run their left and right
+ *        channel respectively, so a lane is one pole channel:
+ *
+ *        lane 0: pole 1 left, lane 1: pole 2 right, lanes 2/3: pole 0 L/R.
+ *
+ *        Each lane is a feedback delay with a low-pass in the loop, a DC
+ *        blocker and, with infinite feedback, an envelope follower acting
+ *        as a limiter. The lane states live in arrays of kLanes, so one
+ *        sample is a fixed-count loop over all of them, and the four delay
+ *        lines are interleaved in a single buffer written with one store
+ *        per sample.
+ */
+class ResonatorBank
 {
 public:
-    Pole(float sampleRate)
-    {
-        sampleRate_ = sampleRate;
-        msr_ = sampleRate_ / 1000.f;
+    static const int kPoles = 3;
+    static const int kLanes = 4;
 
-        for (size_t i = 0; i < 2; i++)
+private:
+    // Lane of each pole channel, -1 if unused.
+    const int kPoleLanes[kPoles][2] = { { 2, 3 }, { 0, -1 }, { -1, 1 } };
+
+    float* lines_; // kResoBufferSize frames of kLanes samples
+    int32_t writeIndex_;
+
+    // Lane state
+    float delayTimes_[kLanes], outs_[kLanes];
+    float b0_[kLanes], b1_[kLanes], b2_[kLanes], a1_[kLanes], a2_[kLanes];
+    float d1_[kLanes], d2_[kLanes];
+    float dcX_[kLanes], dcY_[kLanes];
+    float efY_[kLanes];
+    float feedback_[kLanes];
+    bool infinite_[kLanes];
+
+    // Pole parameters
+    float offset_[kPoles], detune_[kPoles], filter_[kPoles], reso_[kPoles];
+    float lf_[kPoles], rf_[kPoles];
+
+    float pioversr_, msr_;
+
+    void SetFreq(int pole)
+    {
+        float fc[2] = { M2F(lf_[pole]) + filter_[pole], M2F(rf_[pole]) + filter_[pole] };
+        for (int c = 0; c < 2; c++)
         {
-            delays_[i] = DelayLine::create(kResoBufferSize);
-            lpfs_[i] = BiquadFilter::create(sampleRate_);
-            dc_[i] = DcBlockingFilter::create();
-            ef_[i] = EnvFollower::create();
+            int lane = kPoleLanes[pole][c];
+            if (lane < 0)
+            {
+                continue;
+            }
+            float coefficients[BIQUAD_COEFFICIENTS_PER_STAGE];
+            FilterStage::setLowPass(coefficients, fc[c] * pioversr_, reso_[pole]);
+            b0_[lane] = coefficients[0];
+            b1_[lane] = coefficients[1];
+            b2_[lane] = coefficients[2];
+            a1_[lane] = coefficients[3];
+            a2_[lane] = coefficients[4];
         }
-
-        reso_ = FilterStage::BUTTERWORTH_Q;
-        offset_ = 0;
-        feedback_ = 0;
-        filter_ = 0;
-        detune_ = 0;
-        infinite_ = false;
     }
-    ~Pole()
+
+    void SetNote(int pole)
     {
-        for (size_t i = 0; i < 2; i++)
+        lf_[pole] = offset_[pole] + detune_[pole];
+        rf_[pole] = offset_[pole] - detune_[pole];
+
+        float times[2] = { Clamp(msr_ * Db2A(lf_[pole]), 0, kResoBufferSize), Clamp(msr_ * Db2A(rf_[pole]), 0, kResoBufferSize) };
+        for (int c = 0; c < 2; c++)
         {
-            DelayLine::destroy(delays_[i]);
-            BiquadFilter::destroy(lpfs_[i]);
-            DcBlockingFilter::destroy(dc_[i]);
-            EnvFollower::destroy(ef_[i]);
+            int lane = kPoleLanes[pole][c];
+            if (lane >= 0)
+            {
+                delayTimes_[lane] = times[c];
+            }
         }
+
+        SetFreq(pole);
     }
 
-    static Pole* create(float sampleRate)
+    // Same as DelayLine::readAt() on the lane's line.
+    inline float ReadAt(int lane, int32_t index)
     {
-        return new Pole(sampleRate);
+        int32_t i = writeIndex_ - index - 1;
+        while (i < 0)
+        {
+            i += kResoBufferSize;
+        }
+
+        return Clamp(lines_[i * kLanes + lane], -3.f, 3.f);
     }
 
-    static void destroy(Pole* pole)
+public:
+    ResonatorBank(Arena& arena, float sampleRate)
     {
-        delete pole;
+        lines_ = (float*)arena.allocateBuffer(kResoBufferSize * kLanes * sizeof(float), Placement::Bulk);
+        memset(lines_, 0, kResoBufferSize * kLanes * sizeof(float));
+        writeIndex_ = 0;
+
+        pioversr_ = M_PI / sampleRate;
+        msr_ = sampleRate / 1000.f;
+
+        for (int i = 0; i < kLanes; i++)
+        {
+            delayTimes_[i] = outs_[i] = 0;
+            d1_[i] = d2_[i] = 0;
+            dcX_[i] = dcY_[i] = 0;
+            efY_[i] = 0;
+            feedback_[i] = 0;
+            infinite_[i] = false;
+        }
+        for (int i = 0; i < kPoles; i++)
+        {
+            reso_[i] = FilterStage::BUTTERWORTH_Q;
+            offset_[i] = 0;
+            filter_[i] = 0;
+            detune_[i] = 0;
+        }
     }
+    ~ResonatorBank() {}
 
-    float GetSemiOffset()
+    static ResonatorBank* create(Arena& arena, float sampleRate)
     {
-        return offset_;
+        return new (arena, Placement::Hot) ResonatorBank(arena, sampleRate);
     }
 
-    /**
-     * @param offset Semitones, -24 to 24
-     */
-    void SetSemiOffset(float offset)
+    static void reserve(Arena& arena)
     {
-        offset_ = offset * -0.5f + 17.667f;
-        SetNote();
+        arena.reserve(sizeof(ResonatorBank), Placement::Hot);
+        arena.reserve(kResoBufferSize * kLanes * sizeof(float), Placement::Bulk);
     }
 
-    void SetFilter(float filter)
+    static void destroy(ResonatorBank* bank)
     {
-        filter_ = filter;
-        SetFreq();
+        //delete bank;
     }
 
-    void SetFeedback(float feedback)
+    float GetSemiOffset(int pole)
     {
-        infinite_ = feedback > kResoInfiniteFeedbackThreshold;
-        feedback_ = VariableCrossFade(0.f, 1.f, feedback, kResoInfiniteFeedbackThreshold - 0.01f);
+        return offset_[pole];
     }
 
-    void SetDissonance(float detune)
+    /**
+     * @param offset Semitones, -24 to 24
+     */
+    void SetSemiOffset(int pole, float offset)
     {
-        detune_ = detune;
-        SetNote();
+        offset_[pole] = offset * -0.5f + 17.667f;
+        SetNote(pole);
     }
 
-    void SetReso(float reso)
+    void SetFilter(int pole, float filter)
     {
-        reso_ = reso;
-        SetFreq();
+        filter_[pole] = filter;
+        SetFreq(pole);
     }
 
-    // Process just one of the two channels.
-    float Process(float in, int channel)
+    void SetFeedback(int pole, float feedback)
     {
-        float out = lpfs_[channel]->process(outs_[channel]) * feedback_;
-
-        float mix = HardClip(dc_[channel]->process(in + out));
-
-        // Handle infinite feedback.
-        if (infinite_)
+        bool infinite = feedback > kResoInfiniteFeedbackThreshold;
+        float f = VariableCrossFade(0.f, 1.f, feedback, kResoInfiniteFeedbackThreshold - 0.01f);
+        for (int c = 0; c < 2; c++)
         {
-            mix *= feedback_ * kResoInfiniteFeedbackLevel - ef_[channel]->process(mix);
+            int lane = kPoleLanes[pole][c];
+            if (lane >= 0)
+            {
+                infinite_[lane] = infinite;
+                feedback_[lane] = f;
+            }
         }
-
-        delays_[channel]->write(mix);
-        outs_[channel] = delays_[channel]->read(delayTimes_[channel]);
-
-        return out;
     }
 
-    void Process(float leftIn, float rightIn, float &leftOut, float &rightOut)
+    void SetDissonance(int pole, float detune)
     {
-        leftOut = lpfs_[LEFT_CHANNEL]->process(outs_[LEFT_CHANNEL]) * feedback_;
-        rightOut = lpfs_[RIGHT_CHANNEL]->process(outs_[RIGHT_CHANNEL]) * feedback_;
-
-        float leftMix = HardClip(dc_[LEFT_CHANNEL]->process(leftIn + leftOut));
-        float rightMix = HardClip(dc_[RIGHT_CHANNEL]->process(rightIn + rightOut));
-
-        // Handle infinite feedback.
-        if (infinite_)
-        {
-            leftMix *= feedback_ * kResoInfiniteFeedbackLevel - ef_[LEFT_CHANNEL]->process(leftMix);
-            rightMix *= feedback_ * kResoInfiniteFeedbackLevel - ef_[RIGHT_CHANNEL]->process(rightMix);
-        }
-
-        delays_[LEFT_CHANNEL]->write(leftMix);
-        delays_[RIGHT_CHANNEL]->write(rightMix);
-
-        outs_[LEFT_CHANNEL] = delays_[LEFT_CHANNEL]->read(delayTimes_[LEFT_CHANNEL]);
-        outs_[RIGHT_CHANNEL] = delays_[RIGHT_CHANNEL]->read(delayTimes_[RIGHT_CHANNEL]);
+        detune_[pole] = detune;
+        SetNote(pole);
     }
 
-private:
-    DelayLine *delays_[2];
-    BiquadFilter *lpfs_[2];
-    EnvFollower *ef_[2];
-    DcBlockingFilter* dc_[2];
-    float delayTimes_[2], outs_[2];
-
-    float sampleRate_, msr_;
-    float lf_, rf_;
-    float reso_;
-    float offset_;
-    float feedback_;
-    float filter_;
-    float detune_;
-
-    bool infinite_;
-
-    void SetFreq()
+    void SetReso(int pole, float reso)
     {
-        lpfs_[LEFT_CHANNEL]->setLowPass(M2F(lf_) + filter_, reso_);
-        lpfs_[RIGHT_CHANNEL]->setLowPass(M2F(rf_) + filter_, reso_);
+        reso_[pole] = reso;
+        SetFreq(pole);
     }
 
-    void SetNote()
+    /**
+     * @brief Advances every lane by one sample.
+     *
+     * @param in  One input per lane
+     * @param out One output per lane
+     */
+    inline void Process(const float* in, float* out)
     {
-        lf_ = offset_ + detune_;
-        rf_ = offset_ - detune_;
+        float* frame = lines_ + writeIndex_ * kLanes;
+        for (int i = 0; i < kLanes; i++)
+        {
+            // Low-pass on the delay output.
+            float y = FilterStage::step(outs_[i], b0_[i], b1_[i], b2_[i], a1_[i], a2_[i], d1_[i], d2_[i]);
+            y *= feedback_[i];
+            out[i] = y;
+
+            float mix = HardClip(DcBlockingFilter::step(in[i] + y, dcX_[i], dcY_[i]));
 
-        delayTimes_[LEFT_CHANNEL] = Clamp(msr_ * Db2A(lf_), 0, kResoBufferSize);
-        delayTimes_[RIGHT_CHANNEL] = Clamp(msr_ * Db2A(rf_), 0, kResoBufferSize);
+            // Handle infinite feedback.
+            if (infinite_[i])
+            {
+                mix *= feedback_[i] * kResoInfiniteFeedbackLevel - EnvFollower::step(mix, efY_[i]);
+            }
+
+            frame[i] = mix;
+        }
 
-        SetFreq();
+        writeIndex_++;
+        if (writeIndex_ >= kResoBufferSize)
+        {
+            writeIndex_ -= kResoBufferSize;
+        }
+
+        for (int i = 0; i < kLanes; i++)
+        {
+            size_t idx = (size_t)delayTimes_[i];
+            float y0 = ReadAt(i, idx);
+            float y1 = ReadAt(i, idx + 1);
+            outs_[i] = Interpolator::linear(y0, y1, delayTimes_[i] - idx);
+        }
     }
 };
 
@@ -176,7 +245,7 @@ private:
     PatchCtrls* patchCtrls_;
     PatchCvs* patchCvs_;
     PatchState* patchState_;
-    Pole* poles_[3];
+    ResonatorBank* bank_;
 
     BiquadFilter *notches_[2];
     BiquadFilter *hs_[2];
@@ -187,6 +256,7 @@ private:
     float range_;
     float tune_;
     float oldTuning_;
+    float wetEnergy_;
     int ranges_[3];
 
     int task_;
@@ -199,17 +269,17 @@ private:
     {
         if (idx == 0)
         {
-            poles_[0]->SetSemiOffset(offset);
-            poles_[1]->SetSemiOffset(offset + poles_[1]->GetSemiOffset());
-            poles_[2]->SetSemiOffset(offset + poles_[2]->GetSemiOffset());
+            bank_->SetSemiOffset(0, offset);
+            bank_->SetSemiOffset(1, offset + bank_->GetSemiOffset(1));
+            bank_->SetSemiOffset(2, offset + bank_->GetSemiOffset(2));
         }
         else if (idx == 1)
         {
-            poles_[1]->SetSemiOffset(offset + poles_[1]->GetSemiOffset());
+            bank_->SetSemiOffset(1, offset + bank_->GetSemiOffset(1));
         }
         else if (idx == 2)
         {
-            poles_[2]->SetSemiOffset(offset + poles_[2]->GetSemiOffset());
+            bank_->SetSemiOffset(2, offset + bank_->GetSemiOffset(2));
         }
     }
 
@@ -264,11 +334,11 @@ private:
         float reso = Map(value, 0.f, 1.f, 0.5f, 0.6f);
         float filter = Map(value, 0.f, 1.f, 5000.f, 10000.f);
         amp_ = Map(value, 0.f, 1.f, kResoGainMax, kResoGainMin) * 0.577f;
-        for (int i = 0; i < 3; i++)
+        for (int i = 0; i < ResonatorBank::kPoles; i++)
         {
-            poles_[i]->SetFeedback(feedback);
-            poles_[i]->SetReso(reso);
-            poles_[i]->SetFilter(filter);
+            bank_->SetFeedback(i, feedback);
+            bank_->SetReso(i, reso);
+            bank_->SetFilter(i, filter);
         }
     }
 
@@ -285,35 +355,33 @@ private:
         ranges_[1] = Map(value, 0.f, 1.f, 12, 7);
         ranges_[2] = Map(value, 0.f, 1.f, 6, 13);
 
-        poles_[0]->SetDissonance(value);
-        poles_[1]->SetDissonance(value * 2.f);
-        poles_[2]->SetDissonance(value * 3.f);
+        bank_->SetDissonance(0, value);
+        bank_->SetDissonance(1, value * 2.f);
+        bank_->SetDissonance(2, value * 3.f);
     }
 
 public:
-    Resonator(PatchCtrls* patchCtrls, PatchCvs* patchCvs, PatchState* patchState)
+    Resonator(Arena& arena, PatchCtrls* patchCtrls, PatchCvs* patchCvs, PatchState* patchState)
     {
         patchCtrls_ = patchCtrls;
         patchCvs_ = patchCvs;
         patchState_ = patchState;
 
-        for (int i = 0; i < 3; i++)
-        {
-            poles_[i] = Pole::create(patchState_->sampleRate);
-        }
+        bank_ = ResonatorBank::create(arena, patchState_->sampleRate);
 
         for (size_t i = 0; i < 2; i++)
         {
-            notches_[i] = BiquadFilter::create(patchState_->sampleRate);
+            notches_[i] = BiquadFilter::create(arena, patchState_->sampleRate);
             notches_[i]->setNotch(8000.f, FilterStage::SALLEN_KEY_Q);
-            hs_[i] = BiquadFilter::create(patchState_->sampleRate);
+            hs_[i] = BiquadFilter::create(arena, patchState_->sampleRate);
             hs_[i]->setHighShelf(8000.f, -24.f);
-            ef_[i] = EnvFollower::create();
+            ef_[i] = EnvFollower::create(arena);
         }
 
         amp_ = 1.f;
         range_ = 1.f;
         task_ = 0;
+        wetEnergy_ = 0;
 
         SetDissonance(0);
         SetTune(0);
@@ -321,10 +389,7 @@ public:
     }
     ~Resonator()
     {
-        for (int i = 0; i < 3; i++)
-        {
-            Pole::destroy(poles_[i]);
-        }
+        ResonatorBank::destroy(bank_);
         for (size_t i = 0; i < 2; i++)
         {
             BiquadFilter::destroy(notches_[i]);
@@ -333,9 +398,21 @@ public:
         }
     }
 
-    static Resonator* create(PatchCtrls* patchCtrls, PatchCvs* patchCvs, PatchState* patchState)
+    static Resonator* create(Arena& arena, PatchCtrls* patchCtrls, PatchCvs* patchCvs, PatchState* patchState)
     {
-        return new Resonator(patchCtrls, patchCvs, patchState);
+        return new (arena, Placement::Hot) Resonator(arena, patchCtrls, patchCvs, patchState);
+    }
+
+    static void reserve(Arena& arena)
+    {
+        arena.reserve(sizeof(Resonator), Placement::Hot);
+        ResonatorBank::reserve(arena);
+        for (size_t i = 0; i < 2; i++)
+        {
+            BiquadFilter::reserve(arena);
+            BiquadFilter::reserve(arena);
+            EnvFollower::reserve(arena);
+        }
     }
 
     static void destroy(Resonator* obj)
@@ -343,6 +420,12 @@ public:
         delete obj;
     }
 
+    // Mean square of the wet signal over the last processed block.
+    float GetWetEnergy()
+    {
+        return wetEnergy_;
+    }
+
 void process(AudioBuffer &input, AudioBuffer &output)
 {
     size_t size = output.getSize();
@@ -366,6 +449,7 @@ void process(AudioBuffer &input, AudioBuffer &output)
     // Note: The ParameterInterpolator 'tuningParam' is no longer needed/used.
     // --- OPTIMIZATION END ---
 
+    float energy = 0;
     for (size_t i = 0; i < size; i++)
     {
         // SetTune(tuningParam.Next()); <--- REMOVED: Saving CPU by not interpolating/calculating here
@@ -373,17 +457,16 @@ void process(AudioBuffer &input, AudioBuffer &output)
         float lIn = Clamp(leftIn[i], -3.f, 3.f);
         float rIn = Clamp(rightIn[i], -3.f, 3.f);
 
-        float left = poles_[1]->Process(lIn, LEFT_CHANNEL);
-        float right = poles_[2]->Process(rIn, RIGHT_CHANNEL);
+        const float ins[ResonatorBank::kLanes] = { lIn, rIn, lIn, rIn };
+        float outs[ResonatorBank::kLanes];
+        bank_->Process(ins, outs);
 
-        float oLeft = left * 0.75f + right * 0.25f;
-        float oRight = left * 0.25f + right * 0.75f;
+        // Poles 1 and 2 are spread across the image, pole 0 is stereo.
+        float oLeft = outs[0] * 0.75f + outs[1] * 0.25f;
+        float oRight = outs[0] * 0.25f + outs[1] * 0.75f;
 
-        left = 0;
-        right = 0;
-        poles_[0]->Process(lIn, rIn, left, right);
-        oLeft += left;
-        oRight += right;
+        oLeft += outs[2];
+        oRight += outs[3];
 
         oLeft *= 1.f - ef_[LEFT_CHANNEL]->process(oLeft);
         oRight *= 1.f - ef_[RIGHT_CHANNEL]->process(oRight);
@@ -399,6 +482,8 @@ void process(AudioBuffer &input, AudioBuffer &output)
 
         leftOut[i] = CheapEqualPowerCrossFade(lIn, oLeft * kResoMakeupGain, patchCtrls_->resonatorVol, 1.4f);
         rightOut[i] = CheapEqualPowerCrossFade(rIn, oRight * kResoMakeupGain, patchCtrls_->resonatorVol, 1.4f);
+        energy += oLeft * oLeft + oRight * oRight;
     }
+    wetEnergy_ = energy / size * (kResoMakeupGain * kResoMakeupGain);
   }
 };
\ No newline at end of file
@@ -9,11 +9,11 @@ protected:
   size_t blocksize;
   FloatArray* buffers;
 public:
-  NTSampleBuffer(size_t channels, size_t blocksize)
+  NTSampleBuffer(Arena& arena, size_t channels, size_t blocksize)
     :channels(channels), blocksize(blocksize) {
-    buffers = new FloatArray[channels];
+    buffers = new (arena) FloatArray[channels];
     for(size_t i=0; i<channels; ++i)
-      buffers[i] = FloatArray::create(blocksize);
+      buffers[i] = FloatArray::create(arena, blocksize);
   }
   ~NTSampleBuffer(){
     for(size_t i=0; i<channels; ++i)
@@ -45,7 +45,13 @@ public:
   inline void setSize(size_t blocksize_){
     blocksize = blocksize_;
   }
-  static AudioBuffer* create(int channels, int samples) {return new NTSampleBuffer(channels, samples);}
+  static AudioBuffer* create(Arena& arena, int channels, int samples) {return new (arena) NTSampleBuffer(arena, channels, samples);}
+  static void reserve(Arena& arena, int channels, int samples){
+    arena.reserve(sizeof(NTSampleBuffer));
+    arena.reserve(channels*sizeof(FloatArray));
+    for(int i=0; i<channels; ++i)
+      FloatArray::reserve(arena, samples);
+  }
   static void destroy(NTSampleBuffer* obj){
     //delete obj;
   }
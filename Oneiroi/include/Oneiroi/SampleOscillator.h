@@ -141,8 +141,8 @@ public:
   size_t getSampleLength() {
     return buffer.getSize();
   }
-  static SampleOscillator* create(float sr, FloatArray buf) {
-    return new SampleOscillator(sr, buf);
+  static SampleOscillator* create(Arena& arena, float sr, FloatArray buf) {
+    return new (arena) SampleOscillator(sr, buf);
   }
   static void destroy(SampleOscillator* obj) {
     delete obj;
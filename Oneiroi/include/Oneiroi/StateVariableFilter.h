@@ -232,8 +232,11 @@ public:
     ic2eq = 0.0f;
   }
 
-  static StateVariableFilter* create(float sr){
-    return new StateVariableFilter(sr);
+  static StateVariableFilter* create(Arena& arena, float sr){
+    return new (arena, Placement::Hot) StateVariableFilter(sr);
+  }
+  static void reserve(Arena& arena){
+    arena.reserve(sizeof(StateVariableFilter), Placement::Hot);
   }
 
   static void destroy(StateVariableFilter* svf){
@@ -294,8 +297,8 @@ public:
     memset(mState, 0, mChannels*STATE_VARIABLES_PER_CHANNEL*sizeof(float));
   }
 
-  static MultiStateVariableFilter* create(float sr, size_t channels){
-    return new MultiStateVariableFilter(sr, channels, new float[STATE_VARIABLES_PER_CHANNEL]);
+  static MultiStateVariableFilter* create(Arena& arena, float sr, size_t channels){
+    return new (arena, Placement::Hot) MultiStateVariableFilter(sr, channels, new (arena, Placement::Hot) float[STATE_VARIABLES_PER_CHANNEL]);
   }
 
   static void destroy(MultiStateVariableFilter* svf){
@@ -309,8 +312,8 @@ class StereoStateVariableFilter : public MultiStateVariableFilter {
 public:
   StereoStateVariableFilter(float sr, float* state) :
     MultiStateVariableFilter(sr, 2, state) {}
-  static StereoStateVariableFilter* create(float sr){
-    return new StereoStateVariableFilter(sr, new float[STATE_VARIABLES_PER_CHANNEL]);
+  static StereoStateVariableFilter* create(Arena& arena, float sr){
+    return new (arena, Placement::Hot) StereoStateVariableFilter(sr, new (arena, Placement::Hot) float[STATE_VARIABLES_PER_CHANNEL]);
   }
 
   static void destroy(StereoStateVariableFilter* svf){
@@ -42,7 +42,7 @@ private:
     }
 
 public:
-    StereoSineOscillator(PatchCtrls* patchCtrls, PatchCvs* patchCvs, PatchState* PatchState)
+    StereoSineOscillator(Arena& arena, PatchCtrls* patchCtrls, PatchCvs* patchCvs, PatchState* PatchState)
     {
         patchCtrls_ = patchCtrls;
         patchCvs_ = patchCvs;
@@ -50,7 +50,7 @@ public:
 
         for (size_t i = 0; i < 2; i++)
         {
-            oscs_[i] = SineOscillator::create(patchState_->sampleRate);
+            oscs_[i] = SineOscillator::create(arena, patchState_->sampleRate);
         }
 
         fadeOut_ = false;
@@ -68,9 +68,18 @@ public:
         }
     }
 
-    static StereoSineOscillator* create(PatchCtrls* patchCtrls, PatchCvs* patchCvs, PatchState* PatchState)
+    static StereoSineOscillator* create(Arena& arena, PatchCtrls* patchCtrls, PatchCvs* patchCvs, PatchState* PatchState)
     {
-        return new StereoSineOscillator(patchCtrls, patchCvs, PatchState);
+        return new (arena, Placement::Hot) StereoSineOscillator(arena, patchCtrls, patchCvs, PatchState);
+    }
+
+    static void reserve(Arena& arena)
+    {
+        arena.reserve(sizeof(StereoSineOscillator), Placement::Hot);
+        for (size_t i = 0; i < 2; i++)
+        {
+            SineOscillator::reserve(arena);
+        }
     }
 
     static void destroy(StereoSineOscillator* obj)
@@ -4,41 +4,56 @@
 #include "RampOscillator.h"
 
 /**
- * @brief 7 sawtooth oscillators with detuning and mixing.
+ * @brief 7 sawtooth oscillators with detuning and mixing, for both channels.
  *        Adapted from
  *        https://web.archive.org/web/20110627045129/https://www.nada.kth.se/utbildning/grukth/exjobb/rapportlistor/2010/rapporter10/szabo_adam_10131.pdf
  *
+ *        Voices are struct-of-arrays lanes (phase, increment, pending
+ *        polyBLEP correction) rendered for both channels in one pass. The
+ *        per-voice increments are ramped across the block instead of calling
+ *        setFrequency() on every sample, and the antialiasing is the
+ *        AntialiasedRampOscillator polyBLEP, carried over to the next sample
+ *        on wrap.
  */
 class SuperSaw
 {
+public:
+    static constexpr int kVoices = 7;
+    static constexpr int kChannels = 2;
+
 private:
-  AntialiasedRampOscillator* oscs_[7];
-  float detunes_[7];
-  float volumes_[7];
-  float oldFreq_;
+  float phase_[kChannels][kVoices];
+  float blep_[kChannels][kVoices];
+  float detunes_[kVoices];
+  float volumes_[kVoices];
+  float oldFreq_[kChannels];
   float detune_;
+  float mul_;
   PatchState* patchState_;
 
 public:
     SuperSaw(float sampleRate,  PatchState* patchState)
     {
-        for (size_t i = 0; i < 7; i++)
+        for (int c = 0; c < kChannels; c++)
+        {
+            for (int i = 0; i < kVoices; i++)
+            {
+                phase_[c][i] = 0;
+                // As if just wrapped, like the per-sample polyBLEP: starts at 0
+                blep_[c][i] = -1;
+            }
+            oldFreq_[c] = 261.63f;
+        }
+        for (int i = 0; i < kVoices; i++)
         {
-            oscs_[i] = AntialiasedRampOscillator::create(sampleRate);
             detunes_[i] = 0;
             volumes_[i] = 0;
         }
         detune_ = 0;
+        mul_ = 1.f / sampleRate;
         patchState_ = patchState;
-        oldFreq_ = 261.63f;
-    }
-    ~SuperSaw()
-    {
-        for (size_t i = 0; i < 7; i++)
-        {
-            AntialiasedRampOscillator::destroy(oscs_[i]);
-        }
     }
+    ~SuperSaw() {}
 
     void SetDetune(float value, bool minor = false)
     {
@@ -78,9 +93,14 @@ public:
         volumes_[6] = y;
     }
 
-    static SuperSaw* create(float sampleRate, PatchState* ps)
+    static SuperSaw* create(Arena& arena, float sampleRate, PatchState* ps)
     {
-        return new SuperSaw(sampleRate, ps);
+        return new (arena, Placement::Hot) SuperSaw(sampleRate, ps);
+    }
+
+    static void reserve(Arena& arena)
+    {
+        arena.reserve(sizeof(SuperSaw), Placement::Hot);
     }
 
     static void destroy(SuperSaw* obj)
@@ -88,31 +108,68 @@ public:
         //delete obj;
     }
 
-    void Process(float freq, FloatArray output)
+    /**
+     * Renders the left channel at freq[0] and the right one at freq[1]
+     * (or only the left one if channels is 1). The output is overwritten and
+     * scaled by gain on top of the detune-dependent mix level.
+     */
+    void Process(const float* freq, FloatArray* output, int channels, float gain)
     {
-        size_t size = output.getSize();
-        // Interpolate the base frequency over the block duration
-        ParameterInterpolator freqParam(&oldFreq_, freq * 0.5f, size);
-
-        for (size_t i = 0; i < size; i++)
+        size_t size = output[0].getSize();
+        float step = 1.f / size;
+        float level = 0.3f * (1.4f - detune_) * gain;
+        float volumes[kVoices];
+        float incr0[kChannels][kVoices];
+        float dIncr[kChannels][kVoices];
+        for (int j = 0; j < kVoices; j++)
         {
-            // Calculate the current interpolated frequency value
-            float currentFreq = freqParam.Next();
+            volumes[j] = volumes_[j] * level;
+        }
 
-            // OPTIMIZATION: Apply the frequency to all 7 oscillators directly here.
-            // This eliminates 7 function calls to the now-removed SetFreq() wrapper 
-            // and the function call overhead for each sample.
-            for (size_t j = 0; j < 7; j++)
+        // Interpolate the base frequency over the block duration: each lane's
+        // increment is a linear ramp, evaluated from the block start so that
+        // rounding does not accumulate.
+        for (int c = 0; c < channels; c++)
+        {
+            float df = (freq[c] * 0.5f - oldFreq_[c]) * step;
+            for (int j = 0; j < kVoices; j++)
             {
-                // Set frequency based on the base freq and the detune multiplier
-                oscs_[j]->setFrequency(currentFreq * detunes_[j]);
-                
-                // Generate the sample and mix
-                output[i] += oscs_[j]->generate() * volumes_[j];
+                incr0[c][j] = (oldFreq_[c] + df) * detunes_[j] * mul_;
+                dIncr[c][j] = df * detunes_[j] * mul_;
             }
+            oldFreq_[c] = freq[c] * 0.5f;
         }
 
-        output.multiply(0.3f * (1.4f - detune_));
+        float ramp = 0;
+        for (size_t i = 0; i < size; i++)
+        {
+            for (int c = 0; c < channels; c++)
+            {
+                float out = 0;
+                for (int j = 0; j < kVoices; j++)
+                {
+                    float phase = phase_[c][j];
+                    float incr = incr0[c][j] + ramp * dIncr[c][j];
+                    float sample = 2 * phase - 1 - blep_[c][j];
+                    float blep = 0;
+                    phase += incr;
+                    if (phase >= 1)
+                    {
+                        // Wrap, correct this sample and the next one
+                        phase -= 1;
+                        float t = (phase - incr) / incr;
+                        sample -= t * t + t + t + 1;
+                        t = phase / incr;
+                        blep = t + t - t * t - 1;
+                    }
+                    phase_[c][j] = phase;
+                    blep_[c][j] = blep;
+                    out += sample * volumes[j];
+                }
+                output[c][i] = out;
+            }
+            ramp += 1;
+        }
     }
 };
 
@@ -122,38 +179,30 @@ private:
     PatchCtrls* patchCtrls_;
     PatchCvs* patchCvs_;
     PatchState* patchState_;
-    SuperSaw* saws_[2];
-    
-    void SetDetune(float value, bool minor = false)
-    {
-        for (int i = 0; i < 2; i++)
-        {
-            saws_[i]->SetDetune(value);
-        }
-    }
+    SuperSaw* saw_;
 
 public:
-    StereoSuperSaw(PatchCtrls* patchCtrls, PatchCvs* patchCvs, PatchState* patchState)
+    StereoSuperSaw(Arena& arena, PatchCtrls* patchCtrls, PatchCvs* patchCvs, PatchState* patchState)
     {
         patchCtrls_ = patchCtrls;
         patchCvs_ = patchCvs;
         patchState_ = patchState;        
-        for (int i = 0; i < 2; i++)
-        {
-            saws_[i] = SuperSaw::create(patchState_->sampleRate, patchState_);
-        }
+        saw_ = SuperSaw::create(arena, patchState_->sampleRate, patchState_);
     }
     ~StereoSuperSaw()
     {
-        for (int i = 0; i < 2; i++)
-        {
-            SuperSaw::destroy(saws_[i]);
-        }
+        SuperSaw::destroy(saw_);
     }
 
-    static StereoSuperSaw* create(PatchCtrls* patchCtrls, PatchCvs* patchCvs, PatchState* patchState)
+    static StereoSuperSaw* create(Arena& arena, PatchCtrls* patchCtrls, PatchCvs* patchCvs, PatchState* patchState)
     {
-        return new StereoSuperSaw(patchCtrls, patchCvs, patchState);
+        return new (arena, Placement::Hot) StereoSuperSaw(arena, patchCtrls, patchCvs, patchState);
+    }
+
+    static void reserve(Arena& arena)
+    {
+        arena.reserve(sizeof(StereoSuperSaw), Placement::Hot);
+        SuperSaw::reserve(arena);
     }
 
     static void destroy(StereoSuperSaw* obj)
@@ -171,15 +220,19 @@ public:
 
         float f = Modulate(patchCtrls_->oscPitch + patchCtrls_->oscPitch * u, patchCtrls_->oscPitchModAmount, patchState_->modValue, 0, 0, kOscFreqMin, kOscFreqMax, patchState_->modAttenuverters, patchState_->cvAttenuverters);
         float d = Modulate(patchCtrls_->oscDetune, patchCtrls_->oscDetuneModAmount, patchState_->modValue, patchCtrls_->oscDetuneCvAmount, patchCvs_->oscDetune, -1.f, 1.f, patchState_->modAttenuverters, patchState_->cvAttenuverters);
-        SetDetune(d);
+        saw_->SetDetune(d);
 
-        saws_[LEFT_CHANNEL]->Process(f, output.getSamples(LEFT_CHANNEL));
+        float freq[SuperSaw::kChannels] = { f, f };
+        FloatArray out[SuperSaw::kChannels] = { output.getSamples(LEFT_CHANNEL), output.getSamples(RIGHT_CHANNEL) };
+        float gain = patchCtrls_->osc2Vol * kOScSuperSawGain;
         if (patchState_->oscUnisonCenterFlag)
-          output.getSamples(RIGHT_CHANNEL).copyFrom(output.getSamples(LEFT_CHANNEL));
+        {
+          saw_->Process(freq, out, 1, gain);
+          out[RIGHT_CHANNEL].copyFrom(out[LEFT_CHANNEL]);
+        }
         else {
-          f = Modulate(patchCtrls_->oscPitch + patchCtrls_->oscPitch * -u, patchCtrls_->oscPitchModAmount, patchState_->modValue, 0, 0, kOscFreqMin, kOscFreqMax, patchState_->modAttenuverters, patchState_->cvAttenuverters);
-          saws_[RIGHT_CHANNEL]->Process(f, output.getSamples(RIGHT_CHANNEL));
+          freq[RIGHT_CHANNEL] = Modulate(patchCtrls_->oscPitch + patchCtrls_->oscPitch * -u, patchCtrls_->oscPitchModAmount, patchState_->modValue, 0, 0, kOscFreqMin, kOscFreqMax, patchState_->modAttenuverters, patchState_->cvAttenuverters);
+          saw_->Process(freq, out, 2, gain);
         }
-        output.multiply(patchCtrls_->osc2Vol * kOScSuperSawGain);
     }
 };
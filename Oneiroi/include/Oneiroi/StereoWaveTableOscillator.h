@@ -29,7 +29,7 @@ private:
     float xi_;
 
 public:
-    StereoWaveTableOscillator(PatchCtrls* patchCtrls, PatchCvs* patchCvs, PatchState* patchState, WaveTableBuffer* wtBuffer)
+    StereoWaveTableOscillator(Arena& arena, PatchCtrls* patchCtrls, PatchCvs* patchCvs, PatchState* patchState, WaveTableBuffer* wtBuffer)
     {
         patchCtrls_ = patchCtrls;
         patchCvs_ = patchCvs;
@@ -46,9 +46,9 @@ public:
 
         for (size_t i = 0; i < 2; i++)
         {
-            filters_[i] = BiquadFilter::create(patchState_->sampleRate);
+            filters_[i] = BiquadFilter::create(arena, patchState_->sampleRate);
             filters_[i]->setLowShelf(2000, 1);
-            ef_[i] = EnvFollower::create();
+            ef_[i] = EnvFollower::create(arena);
         }
     }
     ~StereoWaveTableOscillator()
@@ -60,9 +60,19 @@ public:
         }
     }
 
-    static StereoWaveTableOscillator* create(PatchCtrls* patchCtrls, PatchCvs* patchCvs, PatchState* patchState, WaveTableBuffer* wtBuffer)
+    static StereoWaveTableOscillator* create(Arena& arena, PatchCtrls* patchCtrls, PatchCvs* patchCvs, PatchState* patchState, WaveTableBuffer* wtBuffer)
     {
-        return new StereoWaveTableOscillator(patchCtrls, patchCvs, patchState, wtBuffer);
+        return new (arena, Placement::Hot) StereoWaveTableOscillator(arena, patchCtrls, patchCvs, patchState, wtBuffer);
+    }
+
+    static void reserve(Arena& arena)
+    {
+        arena.reserve(sizeof(StereoWaveTableOscillator), Placement::Hot);
+        for (size_t i = 0; i < 2; i++)
+        {
+            BiquadFilter::reserve(arena);
+            EnvFollower::reserve(arena);
+        }
     }
 
     static void destroy(StereoWaveTableOscillator* osc)
@@ -91,6 +101,12 @@ public:
         float o = Modulate(patchCtrls_->oscDetune, patchCtrls_->oscDetuneModAmount, patchState_->modValue, patchCtrls_->oscDetuneCvAmount, patchCvs_->oscDetune, 0, 1.f, patchState_->modAttenuverters, patchState_->cvAttenuverters);
         ParameterInterpolator offsetParam(&oldOffset_, o, size);
 
+        // The pair of tables changes at block rate, the crossfade between
+        // them follows the offset per sample.
+        int q = offsetQuantizer_.Process(o);
+        wtBuffer_->Sync();
+        wtBuffer_->Select(q);
+
         for (size_t i = 0; i < size; i++)
         {
             phase_ += freqParam.Next() * incR_;
@@ -100,14 +116,11 @@ public:
             }
 
             float p = offsetParam.Next();
-            int q = offsetQuantizer_.Process(p);
-            float p1 = q * kWaveTableStepLength + phase_;
-            float p2 = p1 + kWaveTableStepLength;
             float x = Clamp((p - kWaveTableNofTablesR * q) / kWaveTableNofTablesR);
 
             float left;
             float right;
-            wtBuffer_->ReadLinear(p1, p2, x, left, right);
+            wtBuffer_->ReadLinear(phase_, x, left, right);
 
             left *= Map(ef_[LEFT_CHANNEL]->process(left), 0.f, 0.3f, kOScWaveTablePreGain, 1.f);
             right *= Map(ef_[RIGHT_CHANNEL]->process(right), 0.f, 0.3f, kOScWaveTablePreGain, 1.f);
@@ -91,11 +91,14 @@ public:
   static float samplePeriodToBpm(float samples, float sr){
     return frequencyToBpm(sr/samples);
   }
-  static TapTempo* create(float sr, size_t max_limit){
-    return new TapTempo(sr, max_limit);
+  static TapTempo* create(Arena& arena, float sr, size_t max_limit){
+    return new (arena, Placement::Cold) TapTempo(sr, max_limit);
   }
-  static TapTempo* create(float sr, size_t min, size_t max){
-    return new TapTempo(sr, min, max);
+  static TapTempo* create(Arena& arena, float sr, size_t min, size_t max){
+    return new (arena, Placement::Cold) TapTempo(sr, min, max);
+  }
+  static void reserve(Arena& arena){
+    arena.reserve(sizeof(TapTempo), Placement::Cold);
   }
   static void destroy(TapTempo* obj){
     //delete obj;
@@ -145,11 +148,11 @@ public:
       speed = s;
     }
   }
-  static AdjustableTapTempo* create(float sr, size_t limit){
-    return new AdjustableTapTempo(sr, 16, limit);
+  static AdjustableTapTempo* create(Arena& arena, float sr, size_t limit){
+    return new (arena, Placement::Cold) AdjustableTapTempo(sr, 16, limit);
   }
-  static AdjustableTapTempo* create(float sr, size_t min, size_t max){
-    return new AdjustableTapTempo(sr, min, max);
+  static AdjustableTapTempo* create(Arena& arena, float sr, size_t min, size_t max){
+    return new (arena, Placement::Cold) AdjustableTapTempo(sr, min, max);
   }
   static void destroy(AdjustableTapTempo* obj){
     //delete obj;
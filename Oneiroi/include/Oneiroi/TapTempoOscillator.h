@@ -31,8 +31,8 @@ public:
   T* getOscillator(){
     return oscillator;
   }
-  static TapTempoOscillator* create(float sample_rate, size_t min_limit, size_t max_limit, float block_rate){
-    return new TapTempoOscillator(sample_rate, min_limit, max_limit, T::create(block_rate));
+  static TapTempoOscillator* create(Arena& arena, float sample_rate, size_t min_limit, size_t max_limit, float block_rate){
+    return new (arena) TapTempoOscillator(sample_rate, min_limit, max_limit, T::create(arena, block_rate));
   }
   static void destroy(TapTempoOscillator* obj){
     T::destroy(obj->oscillator);
@@ -2,24 +2,94 @@
 
 #include "Commons.h"
 #include "Interpolator.h"
+#include "LooperBuffer.h"
 
+/**
+ * @brief The wavetable oscillator's view of the looper buffer. Table q is
+ *        the kWaveTableLength frames starting at q * kWaveTableStepLength.
+ *
+ *        The oscillator crossfades two neighbouring tables, which sit a step
+ *        apart in the 2 MB buffer. Select() copies the pair into a snapshot
+ *        holding frame k of both tables side by side (left and right of the
+ *        first table, then of the second), plus a guard frame for the
+ *        interpolation, so a sample reads one aligned 32-byte line with no
+ *        wrapping. Both calls run once per block, before the samples: Select()
+ *        refills the snapshot when the pair changes, Sync() copies in only the
+ *        frames the looper wrote into either table since the last block.
+ */
 class WaveTableBuffer
 {
 private:
-    FloatArray* buffer_;
-    int writeHead_;
+    static const int kFrames = kWaveTableLength + 1;
+    static const int kStride = 4;
+    static const size_t kLineSize = 32;
+
+    LooperBuffer* buffer_;
+    float* cache_;
+    int table_; // First table of the snapshot, -1 when stale
+
+    static inline int32_t Wrap(int32_t position)
+    {
+        position %= kLooperChannelBufferLength;
+
+        return position < 0 ? position + kLooperChannelBufferLength : position;
+    }
+
+    // Copies frames from to to (excluded) of both tables.
+    void Copy(int32_t from, int32_t to)
+    {
+        int32_t a = table_ * kWaveTableStepLength;
+        int32_t b = a + kWaveTableStepLength;
+        for (int32_t i = from; i < to; i++)
+        {
+            const float* fa = buffer_->Frame(a + i);
+            const float* fb = buffer_->Frame(b + i);
+            float* c = cache_ + i * kStride;
+            c[0] = fa[0];
+            c[1] = fa[1];
+            c[2] = fb[0];
+            c[3] = fb[1];
+        }
+    }
+
+    // Copies the part of the changed span that falls in the table starting
+    // at start. The span may begin inside the table or before it.
+    void Update(int32_t changed, int32_t frames, int32_t start)
+    {
+        int32_t inside = Wrap(changed - start);
+        if (inside < kFrames)
+        {
+            Copy(inside, inside + frames < kFrames ? inside + frames : kFrames);
+        }
+        int32_t before = Wrap(start - changed);
+        if (before > 0 && before < frames)
+        {
+            Copy(0, frames - before < kFrames ? frames - before : kFrames);
+        }
+    }
 
 public:
-    WaveTableBuffer(FloatArray* buffer)
+    WaveTableBuffer(Arena& arena, LooperBuffer* buffer)
     {
         buffer_ = buffer;
-        writeHead_ = 0;
+        table_ = -1;
+
+        // Far too large for the DTC: what matters is that both tables come
+        // in with a single cache line, so align to one.
+        uintptr_t p = (uintptr_t)arena.allocateBuffer(kFrames * kStride * sizeof(float) + kLineSize, Placement::Bulk);
+        cache_ = (float*)((p + kLineSize - 1) & ~(uintptr_t)(kLineSize - 1));
     }
     ~WaveTableBuffer() {}
 
-    static WaveTableBuffer* create(FloatArray* buffer)
+    static WaveTableBuffer* create(Arena& arena, LooperBuffer* buffer)
     {
-        return new WaveTableBuffer(buffer);
+        return new (arena, Placement::Cold) WaveTableBuffer(arena, buffer);
+    }
+
+    static void reserve(Arena& arena)
+    {
+        arena.reserve(sizeof(WaveTableBuffer), Placement::Cold);
+        arena.reserve(kFrames * kStride * sizeof(float) + kLineSize, Placement::Bulk);
     }
 
     static void destroy(WaveTableBuffer* obj)
@@ -27,46 +97,43 @@ public:
         delete obj;
     }
 
-    inline float ReadLeft(uint32_t position)
+    // Once per block, brings the snapshot up to date with what the looper
+    // wrote. Copy() refreshes both tables over a range, so a range found in
+    // one table also recopies unchanged frames of the other.
+    void Sync()
     {
-        while (position >= kLooperChannelBufferLength)
-        {
-            position -= kLooperChannelBufferLength;
-        }
-        while (position < 0)
+        int32_t start, frames;
+        if (buffer_->TakeWritten(start, frames) && table_ >= 0)
         {
-            position += kLooperChannelBufferLength;
+            Update(start, frames, table_ * kWaveTableStepLength);
+            Update(start, frames, (table_ + 1) * kWaveTableStepLength);
         }
-
-        return buffer_->getElement(position);
     }
 
-    inline float ReadRight(uint32_t position)
+    // Once per block, selects tables table and table + 1 for ReadLinear().
+    void Select(int table)
     {
-        position += kLooperChannelBufferLength;
-
-        while (position >= kLooperTotalBufferLength)
+        if (table != table_)
         {
-            position -= kLooperChannelBufferLength;
+            table_ = table;
+            Copy(0, kFrames);
         }
-        while (position < kLooperChannelBufferLength)
-        {
-            position += kLooperChannelBufferLength;
-        }
-
-        return buffer_->getElement(position);
     }
 
-    inline void ReadLinear(float p1, float p2, float x, float &left, float &right)
+    /**
+     * @param phase Position in the tables, 0 to kWaveTableLength
+     * @param x     Crossfade between the first and the second table
+     */
+    inline void ReadLinear(float phase, float x, float &left, float &right)
     {
-        uint32_t i1 = uint32_t(p1);
-        uint32_t i2 = uint32_t(p2);
-        float f1 = p1 - i1;
-        float f2 = p2 - i2;
+        uint32_t i = uint32_t(phase);
+        float f = phase - i;
 
         float x0 = 1.f - x;
 
-        left = Interpolator::linear(ReadLeft(i1), ReadLeft(i1 + 1), f1) * x0 + Interpolator::linear(ReadLeft(i2), ReadLeft(i2 + 1), f2) * x;
-        right = Interpolator::linear(ReadRight(i1), ReadRight(i1 + 1), f1) * x0 + Interpolator::linear(ReadRight(i2), ReadRight(i2 + 1), f2) * x;
+        const float* c = cache_ + i * kStride;
+
+        left = Interpolator::linear(c[0], c[4], f) * x0 + Interpolator::linear(c[2], c[6], f) * x;
+        right = Interpolator::linear(c[1], c[5], f) * x0 + Interpolator::linear(c[3], c[7], f) * x;
     }
 };
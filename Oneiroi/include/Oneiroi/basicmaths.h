@@ -8,6 +8,8 @@
 #define _USE_MATH_DEFINES
 
 
+// The host and newlib math.h already define these when included first.
+#ifndef M_E
 #define M_E        2.71828182845904523536
 #define M_LOG2E    1.44269504088896340736
 #define M_LOG10E   0.434294481903251827651
@@ -21,6 +23,7 @@
 #define M_2_SQRTPI 1.12837916709551257390
 #define M_SQRT2    1.41421356237309504880
 #define M_SQRT1_2  0.707106781186547524401
+#endif
 
 #ifdef ARM_CORTEX
 //#include "arm_math.h" 
@@ -0,0 +1,571 @@
+// =============================================================================
+// Oneiroi Integration Tests — uses shared NTUmbrella test harness
+// =============================================================================
+// Build:  make test
+// Run:    make test-run
+//
+// Oneiroi.cpp is compiled into this file rather than linked next to it, so
+// the tests can reach the instance's arena and the sizing pass.
+// =============================================================================
+
+#include "../Oneiroi.cpp"
+
+#include "test_framework.h"
+#include "plugin_harness.h"
+#include "wav_writer.h"
+#include "sha256.h"
+#include "perf_registry.h"
+
+#include <cmath>
+#include <cstring>
+#include <string>
+#include <vector>
+
+// -------------------------------------------------------------------------
+// Constants
+// -------------------------------------------------------------------------
+static constexpr int BLOCK_SIZE  = 128;
+static constexpr int SAMPLE_RATE = 48000;
+static constexpr int IN_L_BUS    = 1;   // 1-based bus indices
+static constexpr int IN_R_BUS    = 2;
+static constexpr int OUT_L_BUS   = 13;
+static constexpr int OUT_R_BUS   = 14;
+
+// -------------------------------------------------------------------------
+// Helpers
+// -------------------------------------------------------------------------
+static int blocksFor(float seconds) {
+    return static_cast<int>(seconds * SAMPLE_RATE / BLOCK_SIZE);
+}
+
+static bool createPlugin(PluginInstance& plugin, const int32_t* specifications = nullptr) {
+    if (!plugin.load(0)) return false;
+    if (!plugin.construct(specifications)) return false;
+    plugin.setParameter(kParamLeftInput, IN_L_BUS);
+    plugin.setParameter(kParamRightInput, IN_R_BUS);
+    plugin.setParameter(kParamClockInput, 0);
+    plugin.setParameter(kParamPitchInput, 0);
+    plugin.setParameter(kParamLeftOutput, OUT_L_BUS);
+    plugin.setParameter(kParamRightOutput, OUT_R_BUS);
+    plugin.setParameter(kParamLeftOutputMode, 1);
+    plugin.setParameter(kParamRightOutputMode, 1);
+    return true;
+}
+
+static void mute(PluginInstance& plugin) {
+    plugin.setParameter(kParamSinOscVol, 0);
+    plugin.setParameter(kParamSSOscVol, 0);
+    plugin.setParameter(kParamlooperVol, 0);
+    plugin.setParameter(kParamfilterVol, 0);
+    plugin.setParameter(kParamresonatorVol, 0);
+    plugin.setParameter(kParamechoVol, 0);
+    plugin.setParameter(kParamambienceVol, 0);
+}
+
+/// Short decaying sine bursts, one every 0.5 s, offset by `phase` seconds.
+/// The parenthesised names bypass the fast-math macros in basicmaths.h, so
+/// the stimulus stays the libm one.
+static void burstInput(float* buf, int numFrames, int frameOffset, float freqHz, float phase) {
+    for (int i = 0; i < numFrames; ++i) {
+        float t = (frameOffset + i) / (float)SAMPLE_RATE + phase;
+        float local = (std::fmod)(t, 0.5f);
+        float env = local < 0.15f ? (std::exp)(-local * 30.0f) : 0.0f;
+        buf[i] = 2.5f * env * (std::sin)(2.0f * (float)M_PI * freqHz * t);
+    }
+}
+
+/// Render `seconds` of stereo output, feeding bursts into the inputs when
+/// `withInput` is set.  Returns the peak over both channels.
+static float renderToWav(PluginInstance& plugin, WavWriter& wav, float seconds, bool withInput) {
+    std::vector<float> inL(BLOCK_SIZE), inR(BLOCK_SIZE);
+    float peakAll = 0.0f;
+    int n = blocksFor(seconds);
+    for (int b = 0; b < n; ++b) {
+        plugin.prepareStep(BLOCK_SIZE);
+        if (withInput) {
+            burstInput(inL.data(), BLOCK_SIZE, b * BLOCK_SIZE, 220.0f, 0.0f);
+            burstInput(inR.data(), BLOCK_SIZE, b * BLOCK_SIZE, 330.0f, 0.1f);
+            plugin.fillBus(IN_L_BUS - 1, inL.data(), BLOCK_SIZE);
+            plugin.fillBus(IN_R_BUS - 1, inR.data(), BLOCK_SIZE);
+        }
+        plugin.executeStep(BLOCK_SIZE);
+        const float* outL = plugin.getBus(OUT_L_BUS - 1, BLOCK_SIZE);
+        const float* outR = plugin.getBus(OUT_R_BUS - 1, BLOCK_SIZE);
+        wav.writeStereo(outL, outR, BLOCK_SIZE);
+        peakAll = std::max(peakAll, PluginInstance::peak(outL, BLOCK_SIZE));
+        peakAll = std::max(peakAll, PluginInstance::peak(outR, BLOCK_SIZE));
+    }
+    return peakAll;
+}
+
+static bool allFinite(PluginInstance& plugin, int blocks) {
+    for (int b = 0; b < blocks; ++b) {
+        plugin.step(BLOCK_SIZE);
+        const float* outL = plugin.getBus(OUT_L_BUS - 1, BLOCK_SIZE);
+        const float* outR = plugin.getBus(OUT_R_BUS - 1, BLOCK_SIZE);
+        for (int i = 0; i < BLOCK_SIZE; ++i)
+            if (!std::isfinite(outL[i]) || !std::isfinite(outR[i])) return false;
+    }
+    return true;
+}
+
+// -------------------------------------------------------------------------
+// Tests
+// -------------------------------------------------------------------------
+
+TestResult test_plugin_loads() {
+    TEST_BEGIN("Plugin loads and constructs");
+    PluginInstance plugin;
+    ASSERT_TRUE(plugin.load(0), "factory loads");
+    ASSERT_TRUE(plugin.construct(), "construct succeeds");
+    ASSERT_TRUE(plugin.name() != nullptr, "plugin has a name");
+    TEST_PASS();
+}
+
+TestResult test_produces_audio() {
+    TEST_BEGIN("Default patch produces audio");
+    PluginInstance plugin;
+    ASSERT_TRUE(createPlugin(plugin), "plugin created");
+
+    float peakTotal = 0.0f;
+    for (int b = 0; b < blocksFor(0.2f); ++b) {
+        plugin.step(BLOCK_SIZE);
+        peakTotal = std::max(peakTotal, PluginInstance::peak(plugin.getBus(OUT_L_BUS - 1, BLOCK_SIZE), BLOCK_SIZE));
+    }
+    ASSERT_GT(peakTotal, 0.001f, "audio output is non-zero");
+    TEST_PASS();
+}
+
+TestResult test_silence_when_muted() {
+    TEST_BEGIN("Silence with every source and effect at zero");
+    PluginInstance plugin;
+    ASSERT_TRUE(createPlugin(plugin), "plugin created");
+    mute(plugin);
+
+    // Let the parameter smoothing settle first.
+    for (int b = 0; b < blocksFor(0.5f); ++b)
+        plugin.step(BLOCK_SIZE);
+    float peakTotal = 0.0f;
+    for (int b = 0; b < blocksFor(0.2f); ++b) {
+        plugin.step(BLOCK_SIZE);
+        peakTotal = std::max(peakTotal, PluginInstance::peak(plugin.getBus(OUT_L_BUS - 1, BLOCK_SIZE), BLOCK_SIZE));
+        peakTotal = std::max(peakTotal, PluginInstance::peak(plugin.getBus(OUT_R_BUS - 1, BLOCK_SIZE), BLOCK_SIZE));
+    }
+    ASSERT_LT(peakTotal, 1e-3f, "output is silent");
+    TEST_PASS();
+}
+
+TestResult test_ambience_rates_no_nan() {
+    TEST_BEGIN("Every Ambience rate specification renders finite audio");
+    for (int32_t rate = 0; rate <= 2; ++rate) {
+        PluginInstance plugin;
+        int32_t specs[kNumSpecs] = { rate };
+        ASSERT_TRUE(createPlugin(plugin, specs), "plugin created");
+        plugin.setParameter(kParamambienceVol, 1000);
+        ASSERT_TRUE(allFinite(plugin, blocksFor(0.5f)), "no NaN/Inf");
+    }
+    TEST_PASS();
+}
+
+// An effect never runs with its mix closed, and with the mix open it sleeps
+// once both its input and its tail have stayed silent for the hold time.
+TestResult test_activity_tracker() {
+    TEST_BEGIN("Effects sleep when closed or silent");
+    const float loud = kActivitySleepEnergy * 10.f;
+    ActivityTracker activity(4 * BLOCK_SIZE, BLOCK_SIZE);
+    ASSERT_TRUE(!activity.Wake(0.f, loud), "closed mix does not run");
+    ASSERT_TRUE(activity.Wake(1.f, loud), "open mix with input runs");
+    activity.Update(loud, loud);
+    ASSERT_TRUE(!activity.Wake(0.f, loud), "closing the mix stops it at once");
+    ASSERT_TRUE(!activity.Wake(1.f, 0.f), "silent input does not wake it");
+
+    ASSERT_TRUE(activity.Wake(1.f, loud), "input wakes it");
+    activity.Update(loud, loud);
+    int blocks = 0;
+    while (activity.Wake(1.f, 0.f) && blocks < 100) {
+        activity.Update(0.f, blocks < 3 ? loud : 0.f);
+        blocks++;
+    }
+    ASSERT_TRUE(blocks > 3, "runs while the tail is audible");
+    ASSERT_TRUE(blocks < 100, "sleeps once input and tail are silent");
+    TEST_PASS();
+}
+
+// Plays a synthetic file (frame k holds k) through a LooperStream whose reads
+// complete at once, the way step() services it: request, then the block's
+// reads, then SetHead(). Returns the number of frames that read wrong.
+static int streamMismatches(LooperStream& stream, const std::vector<float>& file,
+                            int32_t start, int32_t length, float speed, int blocks) {
+    const int32_t fileFrames = (int32_t)file.size();
+    int direction = speed < 0.f ? -1 : 1;
+    double phase = speed < 0.f ? length - 1 : 0;
+    int mismatches = 0;
+    stream.SetHead(start, length, phase, direction);
+    for (int b = 0; b < blocks; ++b) {
+        LooperStream::Request request;
+        if (stream.NextRequest(request)) {
+            std::memcpy(request.dst, &file[request.start], request.frames * sizeof(float));
+            stream.Loaded(true);
+        }
+        for (int i = 0; i < BLOCK_SIZE; ++i) {
+            int32_t frame = (start + (int32_t)phase) % fileFrames;
+            if (stream.Read(frame) != file[frame])
+                mismatches++;
+            phase += speed;
+            if (phase >= length) phase -= length;
+            if (phase < 0) phase += length;
+        }
+        stream.SetHead(start, length, phase, direction);
+    }
+    return mismatches;
+}
+
+TestResult test_looper_stream_windows() {
+    TEST_BEGIN("Looper stream keeps the head's frames resident");
+    std::vector<float> memory(LooperStream::kWindows * LooperStream::kWindowFrames);
+    std::vector<float> file(LooperStream::kWindowFrames * 5 / 2);
+    for (size_t k = 0; k < file.size(); ++k)
+        file[k] = (float)k;
+    const int32_t fileFrames = (int32_t)file.size();
+    const int blocks = fileFrames * 2 / BLOCK_SIZE; // wraps at least once
+
+    static const float speeds[] = { 1.f, 1.5f, -1.f, -2.f };
+    for (float speed : speeds) {
+        LooperStream stream(memory.data());
+        stream.Open(fileFrames);
+        // Whole file, then a loop shorter than a window across a window edge.
+        ASSERT_EQ(streamMismatches(stream, file, 0, fileFrames, speed, blocks), 0, "whole file plays from resident windows");
+        ASSERT_EQ(streamMismatches(stream, file, LooperStream::kWindowFrames - 1000, LooperStream::kWindowFrames / 2, speed, blocks), 0, "short loop plays from resident windows");
+        ASSERT_EQ(stream.GetUnderruns(), 0u, "no underruns");
+    }
+
+    // A read that completes after the stream was closed is dropped.
+    LooperStream stream(memory.data());
+    stream.Open(fileFrames);
+    stream.SetHead(0, fileFrames, 0, 1);
+    LooperStream::Request request;
+    ASSERT_TRUE(stream.NextRequest(request), "first window requested");
+    stream.Close();
+    stream.Loaded(true);
+    ASSERT_TRUE(!stream.IsLoading(), "late read completes");
+    stream.Open(fileFrames);
+    ASSERT_EQ(stream.Read(0), 0.f, "late read is not resident");
+    ASSERT_EQ(stream.GetUnderruns(), 1u, "late read counts as an underrun");
+    TEST_PASS();
+}
+
+// Sync() copies only the frames the looper wrote; the snapshot must end up
+// the same as one refilled from scratch.
+static bool sameSnapshot(WaveTableBuffer* a, WaveTableBuffer* b) {
+    for (int i = 0; i < kWaveTableLength; ++i) {
+        for (float x : { 0.f, 1.f }) {
+            float al, ar, bl, br;
+            a->ReadLinear((float)i, x, al, ar);
+            b->ReadLinear((float)i, x, bl, br);
+            if (al != bl || ar != br) return false;
+        }
+    }
+    return true;
+}
+
+TestResult test_wavetable_sync() {
+    TEST_BEGIN("Wavetable snapshot follows looper writes");
+    // The looper buffer starts out as noise; keep the goldens' RNG sequence.
+    const uint32_t seed = r32seed;
+    Arena sizing;
+    LooperBuffer::reserve(sizing);
+    WaveTableBuffer::reserve(sizing);
+    WaveTableBuffer::reserve(sizing);
+    std::vector<uint8_t> memory(sizing.dramUsed() + sizing.dtcUsed());
+    Arena arena(memory.data(), sizing.dramUsed(), memory.data() + sizing.dramUsed(), sizing.dtcUsed(), 0);
+    LooperBuffer* looper = LooperBuffer::create(arena);
+    WaveTableBuffer* synced = WaveTableBuffer::create(arena, looper);
+    WaveTableBuffer* fresh = WaveTableBuffer::create(arena, looper);
+    float* data = looper->GetBuffer()->getData();
+    r32seed = seed;
+
+    // Spans inside a table, starting before one, and across the end of the
+    // buffer (the last table's neighbour is the first one).
+    struct Span { int table; int32_t start, frames; };
+    const int32_t step = kWaveTableStepLength;
+    const Span spans[] = {
+        { 5, 5 * step + 100, 128 },
+        { 5, 6 * step - 64, 256 },
+        { 5, 5 * step - 300, 1000 },
+        { 5, 6 * step + kWaveTableLength - 10, 64 },
+        { kWaveTableNofTables - 1, kLooperChannelBufferLength - 50, 300 },
+        { 9, 0, kLooperChannelBufferLength },
+    };
+    float value = 1.f;
+    for (const Span& span : spans) {
+        synced->Select(span.table);
+        synced->Sync();
+        for (int32_t i = 0; i < span.frames; ++i) {
+            int32_t frame = (span.start + i) % kLooperChannelBufferLength;
+            data[frame * 2] = value;
+            data[frame * 2 + 1] = -value;
+            value += 1.f;
+        }
+        looper->MarkWritten(span.start, span.frames);
+        synced->Sync();
+        fresh->Select(-1);
+        fresh->Select(span.table);
+        ASSERT_TRUE(sameSnapshot(synced, fresh), "synced snapshot matches a full refill");
+    }
+    TEST_PASS();
+}
+
+// The instance must land exactly on the memory calculateRequirements() asked
+// for, at every rate, block size and specification.
+TestResult test_arena_matches_requirements() {
+    TEST_BEGIN("Arena usage matches calculateRequirements");
+    static const uint32_t rates[] = { 44100, 48000, 96000 };
+    static const uint32_t blocks[] = { 16, 128, 256 };
+    for (uint32_t sr : rates) {
+        for (uint32_t frames : blocks) {
+            NtTestHarness::setSampleRate(sr);
+            NtTestHarness::setMaxFrames(frames);
+            for (int32_t rate = 0; rate <= 2; ++rate) {
+                int32_t specs[kNumSpecs] = { rate };
+                _NT_algorithmRequirements req;
+                calculateRequirements(req, specs);
+
+                PluginInstance plugin;
+                ASSERT_TRUE(plugin.load(0) && plugin.construct(specs), "plugin constructed");
+                const Arena& arena = ((_OneiroiAlgorithm*)plugin.getAlgorithm())->dtc->arena;
+                ASSERT_EQ(arena.dramUsed(), (size_t)req.dram, "DRAM used equals DRAM requested");
+                ASSERT_EQ(kDtcArenaOffset + arena.dtcUsed(), (size_t)req.dtc, "DTC used equals DTC requested");
+                ASSERT_TRUE(req.dtc <= kDtcArenaOffset + Arena::kDtcBudget, "DTC within budget");
+            }
+        }
+    }
+    NtTestHarness::setSampleRate(SAMPLE_RATE);
+    NtTestHarness::setMaxFrames(BLOCK_SIZE);
+    TEST_PASS();
+}
+
+// =========================================================================
+// Golden Hash WAV generators — each writes a deterministic WAV to bin/
+// =========================================================================
+
+TestResult test_golden_default() {
+    TEST_BEGIN("Golden: default patch (oscillators through every effect)");
+    PluginInstance plugin;
+    ASSERT_TRUE(createPlugin(plugin), "plugin created");
+
+    WavWriter wav("bin/golden_default.wav", SAMPLE_RATE, 2);
+    ASSERT_TRUE(wav.isOpen(), "WAV file opened");
+    float peak = renderToWav(plugin, wav, 3.0f, false);
+    wav.close();
+    ASSERT_GT(peak, 0.001f, "has audio");
+    TEST_PASS();
+}
+
+TestResult test_golden_input_effects() {
+    TEST_BEGIN("Golden: input bursts through resonator, echo and ambience");
+    PluginInstance plugin;
+    ASSERT_TRUE(createPlugin(plugin), "plugin created");
+    mute(plugin);
+    plugin.setParameter(kParamfilterVol, 750);
+    plugin.setParameter(kParamfilterCutoff, 4000);
+    plugin.setParameter(kParamfilterResonance, 400);
+    plugin.setParameter(kParamresonatorVol, 800);
+    plugin.setParameter(kParamresonatorFeedback, 700);
+    plugin.setParameter(kParamresonatorDissonance, 300);
+    plugin.setParameter(kParamechoVol, 700);
+    plugin.setParameter(kParamechoRepeats, 700);
+    plugin.setParameter(kParamechoDensity, 300);
+    plugin.setParameter(kParamambienceVol, 600);
+    plugin.setParameter(kParamambienceDecay, 700);
+
+    WavWriter wav("bin/golden_input_effects.wav", SAMPLE_RATE, 2);
+    ASSERT_TRUE(wav.isOpen(), "WAV file opened");
+    float peak = renderToWav(plugin, wav, 4.0f, true);
+    wav.close();
+    ASSERT_GT(peak, 0.001f, "has audio");
+    TEST_PASS();
+}
+
+// The echo on its own: a short density so many chunks cross taps, then the
+// repeats pushed into the infinite range to run the feedback followers.
+TestResult test_golden_echo() {
+    TEST_BEGIN("Golden: input bursts through the echo, then infinite repeats");
+    PluginInstance plugin;
+    ASSERT_TRUE(createPlugin(plugin), "plugin created");
+    mute(plugin);
+    plugin.setParameter(kParamechoVol, 800);
+    plugin.setParameter(kParamechoRepeats, 600);
+    plugin.setParameter(kParamechoDensity, 150);
+    plugin.setParameter(kParamechoFilter, 300);
+
+    WavWriter wav("bin/golden_echo.wav", SAMPLE_RATE, 2);
+    ASSERT_TRUE(wav.isOpen(), "WAV file opened");
+    float peak = renderToWav(plugin, wav, 2.0f, true);
+    plugin.setParameter(kParamechoRepeats, 1000);
+    peak = std::max(peak, renderToWav(plugin, wav, 2.0f, true));
+    wav.close();
+    ASSERT_GT(peak, 0.001f, "has audio");
+    TEST_PASS();
+}
+
+TestResult test_golden_looper() {
+    TEST_BEGIN("Golden: record the input into the looper, then play it back");
+    PluginInstance plugin;
+    ASSERT_TRUE(createPlugin(plugin), "plugin created");
+    mute(plugin);
+    plugin.setParameter(kParamlooperVol, 900);
+    plugin.setParameter(kParamlooperLength, 250);
+
+    WavWriter wav("bin/golden_looper.wav", SAMPLE_RATE, 2);
+    ASSERT_TRUE(wav.isOpen(), "WAV file opened");
+    plugin.setParameter(kParamlooperRecording, 1);
+    float peak = renderToWav(plugin, wav, 1.5f, true);
+    plugin.setParameter(kParamlooperRecording, 0);
+    peak = std::max(peak, renderToWav(plugin, wav, 1.0f, false));
+    plugin.setParameter(kParamlooperSpeed, -500);
+    peak = std::max(peak, renderToWav(plugin, wav, 1.0f, false));
+    wav.close();
+    ASSERT_GT(peak, 0.001f, "has audio");
+    TEST_PASS();
+}
+
+TestResult test_golden_ambience_half_rate() {
+    TEST_BEGIN("Golden: default patch, Ambience network at half rate");
+    PluginInstance plugin;
+    int32_t specs[kNumSpecs] = { 1 };
+    ASSERT_TRUE(createPlugin(plugin, specs), "plugin created");
+    plugin.setParameter(kParamambienceVol, 700);
+
+    WavWriter wav("bin/golden_ambience_half.wav", SAMPLE_RATE, 2);
+    ASSERT_TRUE(wav.isOpen(), "WAV file opened");
+    float peak = renderToWav(plugin, wav, 3.0f, true);
+    wav.close();
+    ASSERT_GT(peak, 0.001f, "has audio");
+    TEST_PASS();
+}
+
+// =========================================================================
+// Golden hash verification — SHA-256 regression test
+// =========================================================================
+
+TestResult test_golden_wav_hashes() {
+    TEST_BEGIN("Golden WAV hashes (SHA-256 regression)");
+
+    const char* goldenPath = "tests/golden_hashes.txt";
+
+    // --- Read the golden file ---
+    FILE* f = fopen(goldenPath, "r");
+    ASSERT_TRUE(f != nullptr, "tests/golden_hashes.txt exists");
+
+    struct Line {
+        std::string raw;
+        std::string hash;
+        std::string file;
+        std::string actual;
+        bool isEntry = false;
+    };
+
+    std::vector<Line> lines;
+    char buf[512];
+    while (fgets(buf, sizeof(buf), f)) {
+        Line ln;
+        ln.raw = buf;
+        while (!ln.raw.empty() && (ln.raw.back() == '\n' || ln.raw.back() == '\r'))
+            ln.raw.pop_back();
+
+        if (ln.raw.empty() || ln.raw[0] == '#') {
+            lines.push_back(ln);
+            continue;
+        }
+
+        size_t sep = ln.raw.find("  ");
+        if (sep == std::string::npos) { lines.push_back(ln); continue; }
+
+        ln.hash = ln.raw.substr(0, sep);
+        ln.file = ln.raw.substr(sep + 2);
+        ln.isEntry = true;
+        lines.push_back(ln);
+    }
+    fclose(f);
+
+    // --- Check each entry ---
+    int mismatches = 0;
+    int regenerated = 0;
+    for (auto& ln : lines) {
+        if (!ln.isEntry) continue;
+
+        ln.actual = sha256_file(ln.file.c_str());
+        ASSERT_TRUE(!ln.actual.empty(), (std::string("can read ") + ln.file).c_str());
+
+        if (ln.hash == "*") {
+            printf("    REGEN  %-40s %s\n", ln.file.c_str(), ln.actual.c_str());
+            ++regenerated;
+        } else if (ln.actual != ln.hash) {
+            printf("    MISMATCH %-38s\n      expected: %s\n      actual:   %s\n",
+                   ln.file.c_str(), ln.hash.c_str(), ln.actual.c_str());
+            ++mismatches;
+        }
+    }
+
+    // --- Rewrite the file if any entries were re-goldened ---
+    if (regenerated > 0) {
+        FILE* fw = fopen(goldenPath, "w");
+        ASSERT_TRUE(fw != nullptr, "can rewrite golden_hashes.txt");
+        for (auto& ln : lines) {
+            if (ln.isEntry)
+                fprintf(fw, "%s  %s\n", ln.actual.c_str(), ln.file.c_str());
+            else
+                fprintf(fw, "%s\n", ln.raw.c_str());
+        }
+        fclose(fw);
+        printf("    >> golden_hashes.txt updated (%d hash%s regenerated)\n",
+               regenerated, regenerated > 1 ? "es" : "");
+    }
+
+    ASSERT_TRUE(mismatches == 0, "all WAV hashes match golden references");
+    TEST_PASS();
+}
+
+// =========================================================================
+// Performance baseline: the golden renders re-run and timed per WAV scenario
+// =========================================================================
+TestResult test_perf_baseline() {
+    TEST_BEGIN("Performance baseline (cycles/frame vs tests/perf_baseline.txt)");
+    const bool withinBudget = PerfRegistry::check("tests/perf_baseline.txt", {
+        test_golden_default,
+        test_golden_input_effects,
+        test_golden_looper,
+        test_golden_ambience_half_rate,
+        test_golden_echo,
+    });
+    ASSERT_TRUE(withinBudget, "no render scenario slower than baseline tolerance");
+    TEST_PASS();
+}
+
+// -------------------------------------------------------------------------
+// Main
+// -------------------------------------------------------------------------
+int main() {
+    NtTestHarness::setSampleRate(SAMPLE_RATE);
+    NtTestHarness::setMaxFrames(BLOCK_SIZE);
+
+    return TestRunner::run({
+        test_plugin_loads,
+        test_produces_audio,
+        test_silence_when_muted,
+        test_ambience_rates_no_nan,
+        test_activity_tracker,
+        test_looper_stream_windows,
+        test_wavetable_sync,
+        test_arena_matches_requirements,
+        // Golden WAV generators
+        test_golden_default,
+        test_golden_input_effects,
+        test_golden_looper,
+        test_golden_ambience_half_rate,
+        test_golden_echo,
+        // Golden hash verification (must run after generators)
+        test_golden_wav_hashes,
+        test_perf_baseline,
+    });
+}
@@ -0,0 +1,151 @@
+// Host-side report of where Oneiroi's allocations land (DTC or DRAM).
+//
+// Sizes the engine the same way calculateRequirements() does, builds it on
+// heap memory of that size the way construct() does, and prints one line per
+// allocating factory, grouped by placement hint and region. Use it
+// to check that the per-sample working set (Placement::Hot) fits in DTC and
+// to revisit the hints in the create() factories when the graph changes.
+//
+//   make report                    # 48 kHz, 128 frames
+//   ./bin/ArenaReport 96000 64
+//   ./bin/ArenaReport 96000 64 1     # Ambience rate specification = half
+
+#include "../Oneiroi.cpp"
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <cxxabi.h>
+#include <dlfcn.h>
+
+namespace NtTestHarness
+{
+    void setSampleRate(uint32_t sr);
+    void setMaxFrames(uint32_t frames);
+}
+
+struct Line
+{
+    char site[160];
+    Placement placement;
+    bool dtc;
+    size_t count;
+    size_t bytes;
+};
+
+static const char* placementName(Placement placement)
+{
+    switch (placement)
+    {
+    case Placement::Hot:
+        return "hot";
+    case Placement::Cold:
+        return "cold";
+    case Placement::Bulk:
+        return "bulk";
+    default:
+        return "auto";
+    }
+}
+
+// Demangled name of the function containing addr, without the argument list.
+static void siteName(const void* addr, char* out, size_t size)
+{
+    Dl_info info;
+    if (addr == nullptr || !dladdr(addr, &info) || info.dli_sname == nullptr)
+    {
+        snprintf(out, size, "%p", addr);
+        return;
+    }
+    int status;
+    char* name = abi::__cxa_demangle(info.dli_sname, nullptr, nullptr, &status);
+    snprintf(out, size, "%s", status == 0 ? name : info.dli_sname);
+    free(name);
+    char* args = strchr(out, '(');
+    if (args != nullptr)
+    {
+        *args = '\0';
+    }
+}
+
+static ArenaReport report;
+static Line lines[ArenaReport::kMaxRecords];
+
+int main(int argc, char** argv)
+{
+    uint32_t sampleRate = argc > 1 ? atoi(argv[1]) : 48000;
+    uint32_t blockSize = argc > 2 ? atoi(argv[2]) : 128;
+    int32_t specs[kNumSpecs] = { argc > 3 ? atoi(argv[3]) : 0 }; // Ambience rate
+    NtTestHarness::setSampleRate(sampleRate);
+    NtTestHarness::setMaxFrames(blockSize);
+
+    Arena hot(Arena::kDtcBudget);
+    reserveEngine(hot, specs);
+    Arena sizing(hot.hotUsed());
+    reserveEngine(sizing, specs);
+
+    uint8_t* dram = (uint8_t*)calloc(sizing.dramUsed(), 1);
+    uint8_t* dtc = (uint8_t*)calloc(sizing.dtcUsed(), 1);
+    Arena arena(dram, sizing.dramUsed(), dtc, sizing.dtcUsed(), sizing.hotReserve());
+    arena.setReport(&report);
+    PatchCtrls patchCtrls = {};
+    PatchCvs patchCvs = {};
+    PatchState patchState = {};
+    AudioBuffer* buffer;
+    setupPatchState(patchState, specs);
+    createEngine(arena, &patchCtrls, &patchCvs, &patchState, &buffer);
+
+    size_t nLines = 0;
+    for (size_t i = 0; i < report.count; i++)
+    {
+        const ArenaRecord& record = report.records[i];
+        char site[160];
+        siteName(record.site, site, sizeof(site));
+        size_t j = 0;
+        while (j < nLines && !(strcmp(lines[j].site, site) == 0 &&
+            lines[j].placement == record.placement && lines[j].dtc == record.dtc))
+        {
+            j++;
+        }
+        if (j == nLines)
+        {
+            memset(&lines[j], 0, sizeof(Line));
+            snprintf(lines[j].site, sizeof(lines[j].site), "%s", site);
+            lines[j].placement = record.placement;
+            lines[j].dtc = record.dtc;
+            nLines++;
+        }
+        lines[j].count++;
+        lines[j].bytes += record.size;
+    }
+
+    printf("Oneiroi arena at %u Hz, %u frames\n\n", sampleRate, blockSize);
+    printf("%-5s %-5s %6s %10s  %s\n", "where", "hint", "count", "bytes", "site");
+    for (int dtc = 1; dtc >= 0; dtc--)
+    {
+        for (size_t j = 0; j < nLines; j++)
+        {
+            if (lines[j].dtc == (dtc == 1))
+            {
+                printf("%-5s %-5s %6zu %10zu  %s\n", dtc ? "DTC" : "DRAM",
+                    placementName(lines[j].placement), lines[j].count, lines[j].bytes, lines[j].site);
+            }
+        }
+    }
+
+    printf("\nDTC:  %zu / %zu bytes (hot %zu, shared %zu)\n", sizing.dtcUsed(), Arena::kDtcBudget,
+        sizing.hotUsed(), sizing.dtcUsed() - sizing.hotReserve());
+    printf("DRAM: %zu bytes\n", sizing.dramUsed());
+    if (hot.hotUsed() > sizing.hotReserve())
+    {
+        printf("Hot set needs %zu bytes, DTC reserve capped at %zu\n", hot.hotUsed(), sizing.hotReserve());
+    }
+    if (arena.dramUsed() != sizing.dramUsed() || arena.dtcUsed() != sizing.dtcUsed())
+    {
+        printf("Build used DRAM %zu, DTC %zu: the reserve() functions are out of step with create()\n",
+            arena.dramUsed(), arena.dtcUsed());
+        return 1;
+    }
+
+    return 0;
+}
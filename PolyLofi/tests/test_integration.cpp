@@ -12,6 +12,7 @@
 #include "plugin_harness.h"
 #include "wav_writer.h"
 #include "sha256.h"
+#include "perf_registry.h"
 #include "../PolyLofiParams.h"
 #include "../PolyLofiVoice.h"
 #include "../../LofiParts/WavetableGenerator.h"
@@ -5119,6 +5120,114 @@ TestResult test_golden_wav_hashes() {
     TEST_PASS();
 }
 
+// =========================================================================
+// Performance baseline: the golden renders re-run and timed per WAV scenario
+// =========================================================================
+TestResult test_perf_baseline() {
+    TEST_BEGIN("Performance baseline (cycles/frame vs tests/perf_baseline.txt)");
+    const bool withinBudget = PerfRegistry::check("tests/perf_baseline.txt", {
+        test_wav_capture,
+        test_chord_wav,
+        test_waveforms_wav,
+        test_amp_envelopes_wav,
+        test_tzfm_wav,
+        test_tzfm_all_routes_wav,
+        test_hard_sync_wav,
+        test_hard_sync_sweep_wav,
+        test_lfo_cutoff_wav,
+        test_lfo_morph_wav,
+        test_modmatrix_velocity_cutoff_wav,
+        test_modmatrix_modenv_fm_wav,
+        test_filter_modes_wav,
+        test_delay_wav,
+        test_3osc_detune_wav,
+        test_morph_sweep_wav,
+        test_drive_wav,
+        test_filter_env_wav,
+        test_multi_lfo_wav,
+        test_fm_plus_sync_wav,
+        test_lfo_morph_survives_speed_change,
+        test_pitch_bend_wav,
+        test_sustain_pedal_wav,
+        test_sustain_retrigger_wav,
+        test_mod_wheel_wav,
+        test_pulse_width_wav,
+        test_lfo_exp_speed_wav,
+        test_aftertouch_wav,
+        test_glide_wav,
+        test_bitcrush_wav,
+        test_delay_bypass_wav,
+        test_chorus_lfo_delaytime_wav,
+        test_flanger_lfo_feedback_wav,
+        test_delay_env_ducking_wav,
+        test_delay_vel_feedback_wav,
+        test_pervoice_delay_pentatonic_wav,
+        test_karplus_strong_wav,
+        test_pervoice_echo_cascade_wav,
+        test_comb_filter_timbre_wav,
+        test_slapback_doubling_wav,
+        test_polyblep_saw_sync_wav,
+        test_polyblep_square_pwm_wav,
+        test_polyblep_vs_naive_wav,
+        test_polyblep_decimated_rate_wav,
+        test_polyblep_sync_sweep_wav,
+        test_midi_sync_lfo_wav,
+        test_delay_sync_wav,
+        test_delay_sync_autostart_wav,
+        test_wavetable_morph_wav,
+        test_voice_steal_crossfade_wav,
+        test_stereo_chord_progression_wav,
+        test_lfo_key_sync_wav,
+        test_delay_diffusion_wav,
+        test_noise_morph_wav,
+        test_mod_destinations_wav,
+        test_pitch_tracked_comb_wav,
+        test_note_random_mod_wav,
+        test_wt_sine_saw_wav,
+        test_wt_sine_square_wav,
+        test_wt_sine_tri_wav,
+        test_wt_saw_square_wav,
+        test_wt_tri_saw_wav,
+        test_wt_additive_wav,
+        test_wt_additive_soft_wav,
+        test_wt_pwm_wav,
+        test_wt_fm_2x_wav,
+        test_wt_fm_3x_wav,
+        test_wt_fm_golden_wav,
+        test_wt_wavefold_wav,
+        test_wt_wavefold_gentle_wav,
+        test_wt_formant_wav,
+        test_wt_formant_vocal_wav,
+        test_wt_supersaw_wav,
+        test_wt_supersaw_wide_wav,
+        test_lofior_preset_wav,
+        test_ladder_filter_modes_wav,
+        test_ladder_reso_sweep_wav,
+        test_svf_vs_ladder_wav,
+        test_ms20_filter_modes_wav,
+        test_diode_filter_modes_wav,
+        test_keyboard_tracking_wav,
+        test_reso_compensation_wav,
+        test_keytrack_mod_source_wav,
+        test_factory_supersaw_wav,
+        test_factory_acid_bass_wav,
+        test_factory_virus_lead_wav,
+        test_factory_pwm_pad_wav,
+        test_factory_hoover_wav,
+        test_factory_fizzy_keys_wav,
+        test_factory_rez_sweep_wav,
+        test_factory_sync_lead_wav,
+        test_factory_lofior_wav,
+        test_factory_crushed_wav,
+        test_factory_scream_lead_wav,
+        test_factory_303_acid_wav,
+        test_factory_moog_bass_wav,
+        test_factory_tape_piano_wav,
+    });
+    ASSERT_TRUE(withinBudget, "no render scenario slower than baseline tolerance");
+    TEST_PASS();
+}
+
 // =========================================================================
 // BUG DIAGNOSTIC: Steal crossfade tail energy
 // =========================================================================
@@ -5950,6 +6059,7 @@ int main() {
 
         // --- Regression ---
         test_golden_wav_hashes,
+        test_perf_baseline,
 
         // --- SCL Microtuning ---
         test_microtune_12tet_baseline,
@@ -22,6 +22,8 @@
 #include <cmath>
 #include <vector>
 
+#include "perf_registry.h"
+
 // ---------------------------------------------------------------------------
 // NT_globals — the one piece of global state every plugin reads
 // ---------------------------------------------------------------------------
@@ -419,7 +421,7 @@ extern "C" {
 // Misc
 // ---------------------------------------------------------------------------
 extern "C" {
-    uint32_t NT_getCpuCycleCount(void) { return 0; }
+    uint32_t NT_getCpuCycleCount(void) { return (uint32_t)PerfRegistry::cycles(); }
     float    NT_getTemperatureC(void) { return 25.0f; }
     void     NT_copyFromFlash(void* dst, const void* src, unsigned int len) { memcpy(dst, src, len); }
     void     NT_log(const char* text) { fprintf(stderr, "[NT_log] %s\n", text); }
@@ -0,0 +1,321 @@
+// =============================================================================
+// perf_registry.h — Cycle-counted benchmark registry for scripted renders
+// =============================================================================
+// Times every plugin step() with the host cycle counter and attributes the
+// cycles to the WAV file currently being written, so each golden-hash render
+// doubles as a benchmark scenario keyed by the same path as its hash entry.
+//
+// PerfRegistry::check() re-runs a list of render tests several times, keeps
+// the fastest time of each step across the runs and compares cycles/frame against
+// tests/perf_baseline.txt:
+//
+//   # calibration is the harness reference kernel, used to rescale the
+//   # baseline when the suite runs on a faster or slower machine
+//   81234.0  @calibration
+//   412.7  bin/Nerberus_loop_dry.wav
+//   *  bin/Nerberus_loop_full_stack.wav      <- not compared until recorded
+//
+// The check is opt-in: wall-clock timing is not deterministic, so a plain
+// test run skips it.  A scenario fails when it is slower than baseline ×
+// (1 + tolerance).  Comparing never writes the file; `*` entries, scenarios
+// missing from it and entries no render produced are only reported.
+// Environment:
+//   NT_PERF=1                compare against the baseline
+//   NT_PERF=update           re-measure every scenario and the calibration and
+//                            rewrite the baseline instead of comparing
+//   NT_PERF_TOLERANCE=<pct>  allowed slowdown in percent
+//   NT_PERF_REPEATS=<n>      re-runs per scenario; the fastest of each step is
+//                            kept, and slow scenarios get 2n confirmation re-runs
+//
+// Usage (after the golden-hash test, which renders the same WAVs):
+//   TestResult test_perf_baseline() {
+//       TEST_BEGIN("Performance baseline (cycles/frame)");
+//       ASSERT_TRUE(PerfRegistry::check("tests/perf_baseline.txt",
+//                                       { test_render_a, test_render_b }),
+//                   "no scenario slower than tolerance");
+//       TEST_PASS();
+//   }
+// =============================================================================
+
+#pragma once
+
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <map>
+#include <string>
+#include <vector>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#else
+#include <chrono>
+#endif
+
+namespace PerfRegistry {
+
+/// Host cycle counter: TSC on x86, the virtual counter on AArch64, a
+/// nanosecond clock elsewhere.  Only ratios between runs on one machine matter.
+inline uint64_t cycles() {
+#if defined(__x86_64__) || defined(__i386__)
+    return __rdtsc();
+#elif defined(__aarch64__)
+    uint64_t v;
+    __asm__ volatile("mrs %0, cntvct_el0" : "=r"(v));
+    return v;
+#else
+    return (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+#endif
+}
+
+// Per-step cycle counts for one scenario.  Renders are deterministic, so step
+// i of every re-run does the same work; keeping the minimum per step filters
+// out preemption and interrupts far better than the minimum whole-run total.
+struct Totals {
+    std::vector<uint64_t> steps;
+    uint64_t frames = 0;
+
+    double perFrame() const {
+        uint64_t c = 0;
+        for (uint64_t s : steps) c += s;
+        return frames ? (double)c / (double)frames : 0.0;
+    }
+
+    void keepFastest(const Totals& run) {
+        if (steps.size() != run.steps.size()) { *this = run; return; }
+        for (size_t i = 0; i < steps.size(); ++i)
+            if (run.steps[i] < steps[i]) steps[i] = run.steps[i];
+    }
+};
+
+inline std::vector<std::string>& scenarioStack() {
+    static std::vector<std::string> s;
+    return s;
+}
+
+inline std::map<std::string, Totals>& currentRun() {
+    static std::map<std::string, Totals> m;
+    return m;
+}
+
+/// Called by WavWriter when a file opens / closes.
+inline void beginScenario(const char* name) { scenarioStack().push_back(name ? name : ""); }
+inline void endScenario(const char* name) {
+    auto& s = scenarioStack();
+    for (size_t i = s.size(); i-- > 0;) {
+        if (s[i] == name) { s.erase(s.begin() + (long)i); return; }
+    }
+}
+
+/// Called by PluginInstance::executeStep() around the plugin's step().
+inline void recordStep(uint64_t stepCycles, int numFrames) {
+    auto& s = scenarioStack();
+    if (s.empty()) return;  // warm-up / setup blocks are not attributed
+    Totals& t = currentRun()[s.back()];
+    t.steps.push_back(stepCycles);
+    t.frames += (uint64_t)numFrames;
+}
+
+/// Fixed float workload; its cost tracks the host's speed so baselines
+/// recorded on another machine can be rescaled.
+inline double calibrate() {
+    uint64_t best = ~0ull;
+    for (int run = 0; run < 7; ++run) {
+        volatile float sink = 0.0f;
+        float z1 = 0.0f, z2 = 0.0f, x = 0.1f;
+        const uint64_t t0 = cycles();
+        for (int i = 0; i < 65536; ++i) {
+            x = x * 0.999f + 0.0001f;
+            const float y = 0.2f * x + z1;
+            z1 = 0.4f * x - 0.3f * y + z2;
+            z2 = 0.2f * x + 0.1f * y;
+            sink = y;
+        }
+        const uint64_t dt = cycles() - t0;
+        (void)sink;
+        if (dt < best) best = dt;
+    }
+    return (double)best;
+}
+
+inline int envInt(const char* name, int fallback) {
+    const char* v = std::getenv(name);
+    return (v && *v) ? std::atoi(v) : fallback;
+}
+
+/// With NT_PERF=1, re-run `renders` and compare each WAV scenario against
+/// `baselinePath`; with NT_PERF=update, measure them and write it back.
+/// Does nothing otherwise.
+inline bool check(const char* baselinePath,
+                  const std::vector<std::function<void()>>& renders,
+                  int tolerancePct = 30) {
+    const char* mode = std::getenv("NT_PERF");
+    const bool update = mode && std::strcmp(mode, "update") == 0;
+    if (!update && envInt("NT_PERF", 0) == 0) {
+        printf("    SKIP   perf baseline (set NT_PERF=1 to compare)\n");
+        return true;
+    }
+    tolerancePct = envInt("NT_PERF_TOLERANCE", tolerancePct);
+    const int repeats = envInt("NT_PERF_REPEATS", 3);
+
+    // Each scenario is bracketed by calibration runs and rescaled to the
+    // first calibration, so host clock/load drift between runs cancels out.
+    const double calNow = calibrate();
+    std::map<std::string, Totals> best;
+    std::map<std::string, size_t> owner;   // scenario -> index of the render that wrote it
+    auto measure = [&](size_t idx) {
+        currentRun().clear();
+        const double calBefore = calibrate();
+        renders[idx]();
+        const double drift = calNow / (0.5 * (calBefore + calibrate()));
+        for (auto& kv : currentRun()) {
+            for (uint64_t& c : kv.second.steps) c = (uint64_t)((double)c * drift);
+            owner[kv.first] = idx;
+            auto it = best.find(kv.first);
+            if (it == best.end()) best[kv.first] = kv.second;
+            else                  it->second.keepFastest(kv.second);
+        }
+    };
+    for (int r = 0; r < (repeats < 1 ? 1 : repeats); ++r)
+        for (size_t i = 0; i < renders.size(); ++i) measure(i);
+
+    struct Line {
+        std::string raw, value, name;
+        bool isEntry, measured;
+        Line(const std::string& r = "", const std::string& v = "", const std::string& n = "",
+             bool entry = false, bool meas = false)
+            : raw(r), value(v), name(n), isEntry(entry), measured(meas) {}
+    };
+    std::vector<Line> lines;
+    if (FILE* f = fopen(baselinePath, "r")) {
+        char buf[512];
+        while (fgets(buf, sizeof(buf), f)) {
+            Line ln;
+            ln.raw = buf;
+            while (!ln.raw.empty() && (ln.raw.back() == '\n' || ln.raw.back() == '\r')) ln.raw.pop_back();
+            const size_t sep = ln.raw.find("  ");
+            if (!ln.raw.empty() && ln.raw[0] != '#' && sep != std::string::npos) {
+                ln.value = ln.raw.substr(0, sep);
+                ln.name  = ln.raw.substr(sep + 2);
+                ln.isEntry = true;
+            }
+            lines.push_back(ln);
+        }
+        fclose(f);
+    } else {
+        lines.push_back(Line("# Performance baseline: <cycles/frame>  <scenario>", "", "", false));
+        lines.push_back(Line("# Re-measure with NT_PERF=update.", "", "", false));
+        lines.push_back(Line("", "", "", false));
+    }
+
+    double calBase = 0.0;
+    Line* calLine = nullptr;
+    for (auto& ln : lines) {
+        if (ln.isEntry && ln.name == "@calibration") {
+            calLine = &ln;
+            if (ln.value != "*") calBase = std::atof(ln.value.c_str());
+        }
+    }
+    if (!calLine) {
+        lines.push_back(Line("", "*", "@calibration", true));
+        calLine = &lines.back();
+    }
+    const double scale = (calBase > 0.0) ? calNow / calBase : 1.0;
+
+    // Host load can stay high for longer than one pass over the renders, so a
+    // scenario is only reported slower after its render has been re-run and
+    // still misses the tolerance.
+    auto tooSlow = [&](const Line& ln, double actual) {
+        const double expected = std::atof(ln.value.c_str()) * scale;
+        return expected > 0.0 && actual > expected * (1.0 + tolerancePct / 100.0);
+    };
+    if (!update && calBase > 0.0) {
+        std::map<size_t, bool> suspects;
+        for (auto& ln : lines) {
+            if (!ln.isEntry || ln.name == "@calibration" || ln.value == "*") continue;
+            auto it = best.find(ln.name);
+            if (it != best.end() && tooSlow(ln, it->second.perFrame())) suspects[owner[ln.name]] = true;
+        }
+        for (int r = 0; r < 2 * repeats; ++r)
+            for (auto& kv : suspects) measure(kv.first);
+    }
+
+    if (!update && calBase <= 0.0)
+        printf("    NOTE     no @calibration in %s, comparing unscaled\n", baselinePath);
+
+    int slower = 0, updated = 0;
+    std::map<std::string, bool> listed;
+    for (auto& ln : lines) {
+        if (!ln.isEntry || ln.name == "@calibration") continue;
+        listed[ln.name] = true;
+        auto it = best.find(ln.name);
+        if (it == best.end()) {
+            printf("    NOT RUN  %-40s (no render produced this scenario)\n", ln.name.c_str());
+            continue;
+        }
+        const double actual = it->second.perFrame();
+        char val[32];
+        snprintf(val, sizeof(val), "%.1f", actual);
+        if (update) {
+            printf("    MEASURE  %-40s %10.1f cyc/frame\n", ln.name.c_str(), actual);
+            ln.value = val;
+            ln.measured = true;
+            ++updated;
+            continue;
+        }
+        if (ln.value == "*") {
+            printf("    UNSET    %-40s %10.1f cyc/frame (record with NT_PERF=update)\n",
+                   ln.name.c_str(), actual);
+            continue;
+        }
+        const double expected = std::atof(ln.value.c_str()) * scale;
+        const double ratio = (expected > 0.0) ? actual / expected : 1.0;
+        if (tooSlow(ln, actual)) {
+            printf("    SLOWER   %-40s %10.1f vs %.1f cyc/frame (+%.0f%%)\n",
+                   ln.name.c_str(), actual, expected, (ratio - 1.0) * 100.0);
+            ++slower;
+        } else if (ratio < 1.0 - tolerancePct / 100.0) {
+            printf("    FASTER   %-40s %10.1f vs %.1f cyc/frame (-%.0f%%, consider re-baselining)\n",
+                   ln.name.c_str(), actual, expected, (1.0 - ratio) * 100.0);
+        }
+    }
+    for (auto& kv : best) {
+        if (listed.count(kv.first)) continue;
+        char val[32];
+        snprintf(val, sizeof(val), "%.1f", kv.second.perFrame());
+        if (!update) {
+            printf("    NEW      %-40s %10.1f cyc/frame (record with NT_PERF=update)\n",
+                   kv.first.c_str(), kv.second.perFrame());
+            continue;
+        }
+        printf("    NEW      %-40s %10.1f cyc/frame\n", kv.first.c_str(), kv.second.perFrame());
+        lines.push_back(Line("", val, kv.first, true, true));
+        ++updated;
+    }
+
+    if (update) {
+        // Every entry was just measured, so the calibration is this machine's.
+        char cal[32];
+        snprintf(cal, sizeof(cal), "%.1f", calNow);
+        for (auto& ln : lines)
+            if (ln.isEntry && ln.name == "@calibration") ln.value = cal;
+        if (FILE* fw = fopen(baselinePath, "w")) {
+            for (auto& ln : lines) {
+                if (ln.isEntry) fprintf(fw, "%s  %s\n", ln.value.c_str(), ln.name.c_str());
+                else            fprintf(fw, "%s\n", ln.raw.c_str());
+            }
+            fclose(fw);
+            printf("    >> %s updated (%d scenario%s measured)\n",
+                   baselinePath, updated, updated == 1 ? "" : "s");
+        }
+    }
+
+    printf("    perf: %zu scenarios, tolerance %d%%, machine scale %.2f\n",
+           best.size(), tolerancePct, scale);
+    return slower == 0;
+}
+
+}  // namespace PerfRegistry
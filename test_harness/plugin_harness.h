@@ -20,6 +20,8 @@
 #include <vector>
 #include <cmath>
 
+#include "perf_registry.h"
+
 // Forward declare pluginEntry (provided by the plugin .cpp being tested)
 extern "C" uintptr_t pluginEntry(_NT_selector selector, uint32_t data);
 
@@ -206,7 +208,9 @@ public:
     /// Call prepareStep() first, optionally fillBus(), then this.
     float* executeStep(int numFrames) {
         if (_factory && _factory->step && _algorithm) {
+            const uint64_t t0 = PerfRegistry::cycles();
             _factory->step(_algorithm, _busBuffer.data(), numFrames / 4);
+            PerfRegistry::recordStep(PerfRegistry::cycles() - t0, numFrames);
         }
         return _busBuffer.data();
     }
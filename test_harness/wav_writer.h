@@ -20,6 +20,9 @@
 #include <cstdint>
 #include <cstring>
 #include <algorithm>
+#include <string>
+
+#include "perf_registry.h"
 
 // disting NT full-scale voltage: ±5V → ±1.0 in WAV
 static constexpr float kNtVoltsToWav = 1.0f / 5.0f;
@@ -34,6 +37,9 @@ public:
             // Write placeholder header — will be patched in close()
             uint8_t header[44] = {};
             fwrite(header, 1, 44, _file);
+            // Plugin steps while this file is open are timed as one scenario
+            _scenario = filename;
+            PerfRegistry::beginScenario(filename);
         }
     }
 
@@ -111,6 +117,7 @@ public:
 
         fclose(_file);
         _file = nullptr;
+        PerfRegistry::endScenario(_scenario.c_str());
     }
 
 private:
@@ -118,6 +125,7 @@ private:
     uint32_t _sampleRate;
     uint16_t _numChannels;
     uint32_t _dataBytes;
+    std::string _scenario;
 
     void writeU16(uint16_t v) { fwrite(&v, sizeof(v), 1, _file); }
     void writeU32(uint32_t v) { fwrite(&v, sizeof(v), 1, _file); }